@@ -0,0 +1,73 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/bench/CMakeLists.txt"
+  "/root/repo/tests/CMakeLists.txt"
+  "/root/repo/tools/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "bench/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/MyLayer.dir/DependInfo.cmake"
+  "bench/CMakeFiles/proc_addr_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/layer_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/log_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/run_benchmarks.dir/DependInfo.cmake"
+  "tests/CMakeFiles/layer_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/handle_map_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/command_hooks_off_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/state_filter_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/device_memory_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/pipeline_cache_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/settings_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/pass_through_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/shader_dedup_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/api_trace_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/frame_pacer_test.dir/DependInfo.cmake"
+  "tools/CMakeFiles/telemetry_reader.dir/DependInfo.cmake"
+  "tools/CMakeFiles/trace_decoder.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,39 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/api_trace.cpp" "CMakeFiles/MyLayer.dir/src/api_trace.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/api_trace.cpp.o.d"
+  "/root/repo/src/api_trace_hooks.cpp" "CMakeFiles/MyLayer.dir/src/api_trace_hooks.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/api_trace_hooks.cpp.o.d"
+  "/root/repo/src/command_buffer_hooks.cpp" "CMakeFiles/MyLayer.dir/src/command_buffer_hooks.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/command_buffer_hooks.cpp.o.d"
+  "/root/repo/src/command_stats.cpp" "CMakeFiles/MyLayer.dir/src/command_stats.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/command_stats.cpp.o.d"
+  "/root/repo/src/device_memory.cpp" "CMakeFiles/MyLayer.dir/src/device_memory.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/device_memory.cpp.o.d"
+  "/root/repo/src/frame_pacer.cpp" "CMakeFiles/MyLayer.dir/src/frame_pacer.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/frame_pacer.cpp.o.d"
+  "/root/repo/src/frame_profiler.cpp" "CMakeFiles/MyLayer.dir/src/frame_profiler.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/frame_profiler.cpp.o.d"
+  "/root/repo/src/hash.cpp" "CMakeFiles/MyLayer.dir/src/hash.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/hash.cpp.o.d"
+  "/root/repo/src/log.cpp" "CMakeFiles/MyLayer.dir/src/log.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/log.cpp.o.d"
+  "/root/repo/src/memory_hooks.cpp" "CMakeFiles/MyLayer.dir/src/memory_hooks.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/memory_hooks.cpp.o.d"
+  "/root/repo/src/my_layer.cpp" "CMakeFiles/MyLayer.dir/src/my_layer.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/my_layer.cpp.o.d"
+  "/root/repo/src/pipeline_cache.cpp" "CMakeFiles/MyLayer.dir/src/pipeline_cache.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/pipeline_cache.cpp.o.d"
+  "/root/repo/src/pipeline_hooks.cpp" "CMakeFiles/MyLayer.dir/src/pipeline_hooks.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/pipeline_hooks.cpp.o.d"
+  "/root/repo/src/platform_linux.cpp" "CMakeFiles/MyLayer.dir/src/platform_linux.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/platform_linux.cpp.o.d"
+  "/root/repo/src/queue_hooks.cpp" "CMakeFiles/MyLayer.dir/src/queue_hooks.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/queue_hooks.cpp.o.d"
+  "/root/repo/src/settings.cpp" "CMakeFiles/MyLayer.dir/src/settings.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/settings.cpp.o.d"
+  "/root/repo/src/shader_hooks.cpp" "CMakeFiles/MyLayer.dir/src/shader_hooks.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/shader_hooks.cpp.o.d"
+  "/root/repo/src/shader_module_cache.cpp" "CMakeFiles/MyLayer.dir/src/shader_module_cache.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/shader_module_cache.cpp.o.d"
+  "/root/repo/src/state_filter.cpp" "CMakeFiles/MyLayer.dir/src/state_filter.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/state_filter.cpp.o.d"
+  "/root/repo/src/telemetry.cpp" "CMakeFiles/MyLayer.dir/src/telemetry.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/telemetry.cpp.o.d"
+  "/root/repo/src/utils.cpp" "CMakeFiles/MyLayer.dir/src/utils.cpp.o" "gcc" "CMakeFiles/MyLayer.dir/src/utils.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,51 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/MyLayer.dir/src/api_trace.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/api_trace.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/api_trace_hooks.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/api_trace_hooks.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/command_buffer_hooks.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/command_buffer_hooks.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/command_stats.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/command_stats.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/device_memory.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/device_memory.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/frame_pacer.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/frame_pacer.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/frame_profiler.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/frame_profiler.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/hash.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/hash.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/log.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/log.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/memory_hooks.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/memory_hooks.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/my_layer.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/my_layer.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/pipeline_cache.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/pipeline_cache.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/pipeline_hooks.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/pipeline_hooks.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/platform_linux.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/platform_linux.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/queue_hooks.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/queue_hooks.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/settings.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/settings.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/shader_hooks.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/shader_hooks.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/shader_module_cache.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/shader_module_cache.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/state_filter.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/state_filter.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/telemetry.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/telemetry.cpp.o.d"
+  "CMakeFiles/MyLayer.dir/src/utils.cpp.o"
+  "CMakeFiles/MyLayer.dir/src/utils.cpp.o.d"
+  "libMyLayer.pdb"
+  "libMyLayer.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/MyLayer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
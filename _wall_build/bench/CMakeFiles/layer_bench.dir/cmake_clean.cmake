@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/layer_bench.dir/layer_bench.cpp.o"
+  "CMakeFiles/layer_bench.dir/layer_bench.cpp.o.d"
+  "CMakeFiles/layer_bench.dir/mock_icd.cpp.o"
+  "CMakeFiles/layer_bench.dir/mock_icd.cpp.o.d"
+  "layer_bench"
+  "layer_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/layer_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/log_bench.dir/log_bench.cpp.o"
+  "CMakeFiles/log_bench.dir/log_bench.cpp.o.d"
+  "log_bench"
+  "log_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/log_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
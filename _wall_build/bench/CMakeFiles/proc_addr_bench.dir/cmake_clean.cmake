@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/proc_addr_bench.dir/proc_addr_bench.cpp.o"
+  "CMakeFiles/proc_addr_bench.dir/proc_addr_bench.cpp.o.d"
+  "proc_addr_bench"
+  "proc_addr_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/proc_addr_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/api_trace_test.dir/__/bench/mock_icd.cpp.o"
+  "CMakeFiles/api_trace_test.dir/__/bench/mock_icd.cpp.o.d"
+  "CMakeFiles/api_trace_test.dir/api_trace_test.cpp.o"
+  "CMakeFiles/api_trace_test.dir/api_trace_test.cpp.o.d"
+  "api_trace_test"
+  "api_trace_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/api_trace_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/bench/mock_icd.cpp" "tests/CMakeFiles/command_hooks_off_test.dir/__/bench/mock_icd.cpp.o" "gcc" "tests/CMakeFiles/command_hooks_off_test.dir/__/bench/mock_icd.cpp.o.d"
+  "/root/repo/tests/command_hooks_off_test.cpp" "tests/CMakeFiles/command_hooks_off_test.dir/command_hooks_off_test.cpp.o" "gcc" "tests/CMakeFiles/command_hooks_off_test.dir/command_hooks_off_test.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_wall_build/CMakeFiles/MyLayer.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/command_hooks_off_test.dir/__/bench/mock_icd.cpp.o"
+  "CMakeFiles/command_hooks_off_test.dir/__/bench/mock_icd.cpp.o.d"
+  "CMakeFiles/command_hooks_off_test.dir/command_hooks_off_test.cpp.o"
+  "CMakeFiles/command_hooks_off_test.dir/command_hooks_off_test.cpp.o.d"
+  "command_hooks_off_test"
+  "command_hooks_off_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/command_hooks_off_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
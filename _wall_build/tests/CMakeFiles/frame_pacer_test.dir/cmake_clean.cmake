@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/frame_pacer_test.dir/__/bench/mock_icd.cpp.o"
+  "CMakeFiles/frame_pacer_test.dir/__/bench/mock_icd.cpp.o.d"
+  "CMakeFiles/frame_pacer_test.dir/frame_pacer_test.cpp.o"
+  "CMakeFiles/frame_pacer_test.dir/frame_pacer_test.cpp.o.d"
+  "frame_pacer_test"
+  "frame_pacer_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/frame_pacer_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
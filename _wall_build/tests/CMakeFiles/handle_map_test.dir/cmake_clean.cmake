@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/handle_map_test.dir/__/bench/mock_icd.cpp.o"
+  "CMakeFiles/handle_map_test.dir/__/bench/mock_icd.cpp.o.d"
+  "CMakeFiles/handle_map_test.dir/handle_map_test.cpp.o"
+  "CMakeFiles/handle_map_test.dir/handle_map_test.cpp.o.d"
+  "handle_map_test"
+  "handle_map_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/handle_map_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/layer_test.dir/__/bench/mock_icd.cpp.o"
+  "CMakeFiles/layer_test.dir/__/bench/mock_icd.cpp.o.d"
+  "CMakeFiles/layer_test.dir/layer_test.cpp.o"
+  "CMakeFiles/layer_test.dir/layer_test.cpp.o.d"
+  "layer_test"
+  "layer_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/layer_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
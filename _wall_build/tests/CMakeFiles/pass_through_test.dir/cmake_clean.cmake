@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pass_through_test.dir/__/bench/mock_icd.cpp.o"
+  "CMakeFiles/pass_through_test.dir/__/bench/mock_icd.cpp.o.d"
+  "CMakeFiles/pass_through_test.dir/pass_through_test.cpp.o"
+  "CMakeFiles/pass_through_test.dir/pass_through_test.cpp.o.d"
+  "pass_through_test"
+  "pass_through_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pass_through_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
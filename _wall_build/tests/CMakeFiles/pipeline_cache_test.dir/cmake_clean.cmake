@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pipeline_cache_test.dir/__/bench/mock_icd.cpp.o"
+  "CMakeFiles/pipeline_cache_test.dir/__/bench/mock_icd.cpp.o.d"
+  "CMakeFiles/pipeline_cache_test.dir/pipeline_cache_test.cpp.o"
+  "CMakeFiles/pipeline_cache_test.dir/pipeline_cache_test.cpp.o.d"
+  "pipeline_cache_test"
+  "pipeline_cache_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pipeline_cache_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/settings_test.dir/__/bench/mock_icd.cpp.o"
+  "CMakeFiles/settings_test.dir/__/bench/mock_icd.cpp.o.d"
+  "CMakeFiles/settings_test.dir/settings_test.cpp.o"
+  "CMakeFiles/settings_test.dir/settings_test.cpp.o.d"
+  "settings_test"
+  "settings_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/settings_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/shader_dedup_test.dir/__/bench/mock_icd.cpp.o"
+  "CMakeFiles/shader_dedup_test.dir/__/bench/mock_icd.cpp.o.d"
+  "CMakeFiles/shader_dedup_test.dir/shader_dedup_test.cpp.o"
+  "CMakeFiles/shader_dedup_test.dir/shader_dedup_test.cpp.o.d"
+  "shader_dedup_test"
+  "shader_dedup_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/shader_dedup_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/state_filter_test.dir/__/bench/mock_icd.cpp.o"
+  "CMakeFiles/state_filter_test.dir/__/bench/mock_icd.cpp.o.d"
+  "CMakeFiles/state_filter_test.dir/state_filter_test.cpp.o"
+  "CMakeFiles/state_filter_test.dir/state_filter_test.cpp.o.d"
+  "state_filter_test"
+  "state_filter_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/state_filter_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
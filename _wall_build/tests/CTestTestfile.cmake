@@ -0,0 +1,28 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/_wall_build/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[layer_test]=] "/root/repo/_wall_build/tests/layer_test")
+set_tests_properties([=[layer_test]=] PROPERTIES  ENVIRONMENT "XDG_CACHE_HOME=/root/repo/_wall_build/tests/cache" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;19;mylayer_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[handle_map_test]=] "/root/repo/_wall_build/tests/handle_map_test")
+set_tests_properties([=[handle_map_test]=] PROPERTIES  ENVIRONMENT "XDG_CACHE_HOME=/root/repo/_wall_build/tests/cache" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;20;mylayer_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[command_hooks_off_test]=] "/root/repo/_wall_build/tests/command_hooks_off_test")
+set_tests_properties([=[command_hooks_off_test]=] PROPERTIES  ENVIRONMENT "XDG_CACHE_HOME=/root/repo/_wall_build/tests/cache" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;21;mylayer_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[state_filter_test]=] "/root/repo/_wall_build/tests/state_filter_test")
+set_tests_properties([=[state_filter_test]=] PROPERTIES  ENVIRONMENT "XDG_CACHE_HOME=/root/repo/_wall_build/tests/cache" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;22;mylayer_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[device_memory_test]=] "/root/repo/_wall_build/tests/device_memory_test")
+set_tests_properties([=[device_memory_test]=] PROPERTIES  ENVIRONMENT "XDG_CACHE_HOME=/root/repo/_wall_build/tests/cache" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;23;mylayer_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[pipeline_cache_test]=] "/root/repo/_wall_build/tests/pipeline_cache_test")
+set_tests_properties([=[pipeline_cache_test]=] PROPERTIES  ENVIRONMENT "XDG_CACHE_HOME=/root/repo/_wall_build/tests/cache" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;24;mylayer_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[settings_test]=] "/root/repo/_wall_build/tests/settings_test")
+set_tests_properties([=[settings_test]=] PROPERTIES  ENVIRONMENT "XDG_CACHE_HOME=/root/repo/_wall_build/tests/cache" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;25;mylayer_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[pass_through_test]=] "/root/repo/_wall_build/tests/pass_through_test")
+set_tests_properties([=[pass_through_test]=] PROPERTIES  ENVIRONMENT "XDG_CACHE_HOME=/root/repo/_wall_build/tests/cache" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;26;mylayer_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[shader_dedup_test]=] "/root/repo/_wall_build/tests/shader_dedup_test")
+set_tests_properties([=[shader_dedup_test]=] PROPERTIES  ENVIRONMENT "XDG_CACHE_HOME=/root/repo/_wall_build/tests/cache" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;27;mylayer_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[api_trace_test]=] "/root/repo/_wall_build/tests/api_trace_test")
+set_tests_properties([=[api_trace_test]=] PROPERTIES  ENVIRONMENT "XDG_CACHE_HOME=/root/repo/_wall_build/tests/cache" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;28;mylayer_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[frame_pacer_test]=] "/root/repo/_wall_build/tests/frame_pacer_test")
+set_tests_properties([=[frame_pacer_test]=] PROPERTIES  ENVIRONMENT "XDG_CACHE_HOME=/root/repo/_wall_build/tests/cache" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;29;mylayer_add_test;/root/repo/tests/CMakeLists.txt;0;")
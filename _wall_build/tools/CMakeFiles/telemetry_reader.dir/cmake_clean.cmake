@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/telemetry_reader.dir/telemetry_reader.cpp.o"
+  "CMakeFiles/telemetry_reader.dir/telemetry_reader.cpp.o.d"
+  "telemetry_reader"
+  "telemetry_reader.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/telemetry_reader.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
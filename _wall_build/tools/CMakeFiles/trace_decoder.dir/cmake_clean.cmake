@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/trace_decoder.dir/trace_decoder.cpp.o"
+  "CMakeFiles/trace_decoder.dir/trace_decoder.cpp.o.d"
+  "trace_decoder"
+  "trace_decoder.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/trace_decoder.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// 간단한 마이크로벤치마크 도구.
+// 워밍업 후 일정 시간 동안 fn 을 반복 호출하고 작업당 평균 ns 를 계산합니다.
+// fn 은 호출 1회당 처리한 작업 수 (ex. 조회한 이름 개수) 를 돌려줍니다.
+
+template <typename T>
+inline void bench_do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <typename Fn>
+inline double bench_measure(Fn&& fn, double min_seconds = 0.2) {
+    using Clock = std::chrono::steady_clock;
+
+    for (int i = 0; i < 16; ++i) fn();
+
+    uint64_t ops = 0;
+    Clock::time_point start = Clock::now();
+    Clock::duration elapsed{};
+    do {
+        for (int i = 0; i < 64; ++i) ops += fn();
+        elapsed = Clock::now() - start;
+    } while (std::chrono::duration<double>(elapsed).count() < min_seconds);
+
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (double)ops;
+}
+
+template <typename Fn>
+inline double bench_run(const char* name, Fn&& fn, double min_seconds = 0.2) {
+    double ns_per_op = bench_measure(fn, min_seconds);
+    printf("%-48s %10.2f ns/op\n", name, ns_per_op);
+    return ns_per_op;
+}
@@ -0,0 +1,337 @@
+// 레이어의 호출당 오버헤드 벤치마크.
+// mock ICD 위에 레이어를 올려서 ProcAddr 해석, 생성/파괴, 그리고 훅하는 hot path 명령 (EXT/KHR 별칭 제외) 을
+// 레이어를 거친 경우와 mock ICD 를 직접 부른 경우로 나눠 ns/call 을 출력합니다.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "hash.h"
+#include "log.h"
+#include "mock_icd.h"
+#include "proc_table.h"
+
+static MockLoader g_loader;
+static VkInstance g_instance = VK_NULL_HANDLE;
+static VkPhysicalDevice g_physical_device = VK_NULL_HANDLE;
+static VkDevice g_device = VK_NULL_HANDLE;
+static VkQueue g_queue = VK_NULL_HANDLE;
+static VkCommandPool g_command_pool = VK_NULL_HANDLE;
+static VkCommandBuffer g_command_buffer = VK_NULL_HANDLE;
+
+template <typename PFN>
+static PFN get_layer_proc(const char* name) {
+    return (PFN)g_loader.layer_get_device_proc_addr(g_device, name);
+}
+
+template <typename PFN>
+static PFN get_icd_proc(const char* name) {
+    return (PFN)mock_icd_get_device_proc_addr(g_device, name);
+}
+
+// 같은 명령을 레이어 경유 / ICD 직접 호출로 각각 측정해서 차이를 출력합니다.
+template <typename PFN, typename Call>
+static void bench_command(const char* name, Call&& call) {
+    PFN layer_pfn = get_layer_proc<PFN>(name);
+    PFN icd_pfn = get_icd_proc<PFN>(name);
+    if (!layer_pfn || !icd_pfn) {
+        fprintf(stderr, "%s: not resolved\n", name);
+        exit(EXIT_FAILURE);
+    }
+
+    double layer_ns = bench_measure([&] { call(layer_pfn); return 1; });
+    double icd_ns = bench_measure([&] { call(icd_pfn); return 1; });
+    printf("%-32s layer %8.2f ns  icd %8.2f ns  overhead %8.2f ns\n",
+           name, layer_ns, icd_ns, layer_ns - icd_ns);
+}
+
+static void bench_proc_addr() {
+    printf("\n[ProcAddr]\n");
+
+    std::vector<std::string> instance_names;
+    std::vector<std::string> device_names;
+    for (const ProcInfo& info : kProcInfos) {
+        (info.level == ProcLevel::Device ? device_names : instance_names).emplace_back(info.name);
+    }
+
+    bench_run("vkGetInstanceProcAddr (instance commands)", [&] {
+        for (const std::string& name : instance_names) {
+            bench_do_not_optimize(g_loader.layer_get_instance_proc_addr(g_instance, name.c_str()));
+        }
+        return instance_names.size();
+    });
+    bench_run("vkGetDeviceProcAddr (device commands)", [&] {
+        for (const std::string& name : device_names) {
+            bench_do_not_optimize(g_loader.layer_get_device_proc_addr(g_device, name.c_str()));
+        }
+        return device_names.size();
+    });
+    bench_run("vkGetDeviceProcAddr (unknown command)", [&] {
+        bench_do_not_optimize(g_loader.layer_get_device_proc_addr(g_device, "vkCmdDrawMeshTasksEXT"));
+        return 1;
+    });
+}
+
+static void bench_create_destroy() {
+    printf("\n[Create / Destroy]\n");
+
+    bench_run("vkCreateInstance + vkDestroyInstance", [&] {
+        VkInstance instance = VK_NULL_HANDLE;
+        g_loader.create_instance(&instance);
+        g_loader.destroy_instance(instance);
+        return 1;
+    });
+    bench_run("vkCreateDevice + vkDestroyDevice", [&] {
+        VkDevice device = VK_NULL_HANDLE;
+        g_loader.create_device(g_physical_device, &device);
+        g_loader.destroy_device(device);
+        return 1;
+    });
+}
+
+static void bench_hot_path() {
+    printf("\n[Hot path]\n");
+
+    bench_command<PFN_vkQueueSubmit>("vkQueueSubmit", [&](PFN_vkQueueSubmit pfn) {
+        VkSubmitInfo submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+        submit_info.commandBufferCount = 1;
+        submit_info.pCommandBuffers = &g_command_buffer;
+        pfn(g_queue, 1, &submit_info, VK_NULL_HANDLE);
+    });
+    bench_command<PFN_vkQueueSubmit2>("vkQueueSubmit2", [&](PFN_vkQueueSubmit2 pfn) {
+        VkCommandBufferSubmitInfo command_buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
+        command_buffer_info.commandBuffer = g_command_buffer;
+        VkSubmitInfo2 submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO_2};
+        submit_info.commandBufferInfoCount = 1;
+        submit_info.pCommandBufferInfos = &command_buffer_info;
+        pfn(g_queue, 1, &submit_info, VK_NULL_HANDLE);
+    });
+    bench_command<PFN_vkQueuePresentKHR>("vkQueuePresentKHR", [&](PFN_vkQueuePresentKHR pfn) {
+        VkPresentInfoKHR present_info = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR};
+        pfn(g_queue, &present_info);
+    });
+    bench_command<PFN_vkCmdBindPipeline>("vkCmdBindPipeline", [&](PFN_vkCmdBindPipeline pfn) {
+        pfn(g_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, VK_NULL_HANDLE);
+    });
+    bench_command<PFN_vkCmdBindDescriptorSets>("vkCmdBindDescriptorSets", [&](PFN_vkCmdBindDescriptorSets pfn) {
+        VkDescriptorSet set = (VkDescriptorSet)(uintptr_t)0x1000;
+        uint32_t dynamic_offset = 256;
+        pfn(g_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, VK_NULL_HANDLE, 0, 1, &set, 1, &dynamic_offset);
+    });
+    bench_command<PFN_vkCmdSetViewport>("vkCmdSetViewport", [&](PFN_vkCmdSetViewport pfn) {
+        VkViewport viewport = {0.0f, 0.0f, 1920.0f, 1080.0f, 0.0f, 1.0f};
+        pfn(g_command_buffer, 0, 1, &viewport);
+    });
+    bench_command<PFN_vkCmdDraw>("vkCmdDraw", [&](PFN_vkCmdDraw pfn) {
+        pfn(g_command_buffer, 3, 1, 0, 0);
+    });
+    bench_command<PFN_vkCmdDrawIndexed>("vkCmdDrawIndexed", [&](PFN_vkCmdDrawIndexed pfn) {
+        pfn(g_command_buffer, 3, 1, 0, 0, 0);
+    });
+    bench_command<PFN_vkCmdDrawIndirect>("vkCmdDrawIndirect", [&](PFN_vkCmdDrawIndirect pfn) {
+        pfn(g_command_buffer, VK_NULL_HANDLE, 0, 1, 16);
+    });
+    bench_command<PFN_vkCmdDrawIndexedIndirect>("vkCmdDrawIndexedIndirect", [&](PFN_vkCmdDrawIndexedIndirect pfn) {
+        pfn(g_command_buffer, VK_NULL_HANDLE, 0, 1, 20);
+    });
+    bench_command<PFN_vkCmdDrawIndirectCount>("vkCmdDrawIndirectCount", [&](PFN_vkCmdDrawIndirectCount pfn) {
+        pfn(g_command_buffer, VK_NULL_HANDLE, 0, VK_NULL_HANDLE, 0, 1, 16);
+    });
+    bench_command<PFN_vkCmdDrawIndexedIndirectCount>(
+        "vkCmdDrawIndexedIndirectCount", [&](PFN_vkCmdDrawIndexedIndirectCount pfn) {
+            pfn(g_command_buffer, VK_NULL_HANDLE, 0, VK_NULL_HANDLE, 0, 1, 20);
+        });
+    bench_command<PFN_vkCmdDispatch>("vkCmdDispatch", [&](PFN_vkCmdDispatch pfn) {
+        pfn(g_command_buffer, 1, 1, 1);
+    });
+    bench_command<PFN_vkCmdDispatchBase>("vkCmdDispatchBase", [&](PFN_vkCmdDispatchBase pfn) {
+        pfn(g_command_buffer, 0, 0, 0, 1, 1, 1);
+    });
+    bench_command<PFN_vkCmdDispatchIndirect>("vkCmdDispatchIndirect", [&](PFN_vkCmdDispatchIndirect pfn) {
+        pfn(g_command_buffer, VK_NULL_HANDLE, 0);
+    });
+    bench_command<PFN_vkCmdPushConstants>("vkCmdPushConstants", [&](PFN_vkCmdPushConstants pfn) {
+        uint32_t values[4] = {1, 2, 3, 4};
+        pfn(g_command_buffer, VK_NULL_HANDLE, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(values), values);
+    });
+    bench_command<PFN_vkCmdPushDescriptorSetKHR>("vkCmdPushDescriptorSetKHR", [&](PFN_vkCmdPushDescriptorSetKHR pfn) {
+        pfn(g_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, VK_NULL_HANDLE, 0, 0, nullptr);
+    });
+}
+
+// 상태 필터가 보는 바인딩 / 동적 상태 명령. 필터가 꺼져 있으면 (기본) 조회 + 전달 비용만 남습니다.
+static void bench_state_commands() {
+    printf("\n[State]\n");
+
+    VkBuffer buffer = (VkBuffer)(uintptr_t)0x2000;
+    VkDeviceSize offset = 0;
+    bench_command<PFN_vkCmdBindVertexBuffers>("vkCmdBindVertexBuffers", [&](PFN_vkCmdBindVertexBuffers pfn) {
+        pfn(g_command_buffer, 0, 1, &buffer, &offset);
+    });
+    bench_command<PFN_vkCmdBindVertexBuffers2>("vkCmdBindVertexBuffers2", [&](PFN_vkCmdBindVertexBuffers2 pfn) {
+        VkDeviceSize size = 4096;
+        VkDeviceSize stride = 16;
+        pfn(g_command_buffer, 0, 1, &buffer, &offset, &size, &stride);
+    });
+    bench_command<PFN_vkCmdBindIndexBuffer>("vkCmdBindIndexBuffer", [&](PFN_vkCmdBindIndexBuffer pfn) {
+        pfn(g_command_buffer, buffer, 0, VK_INDEX_TYPE_UINT16);
+    });
+    bench_command<PFN_vkCmdSetScissor>("vkCmdSetScissor", [&](PFN_vkCmdSetScissor pfn) {
+        VkRect2D scissor = {{0, 0}, {1920, 1080}};
+        pfn(g_command_buffer, 0, 1, &scissor);
+    });
+    bench_command<PFN_vkCmdSetViewportWithCount>("vkCmdSetViewportWithCount", [&](PFN_vkCmdSetViewportWithCount pfn) {
+        VkViewport viewport = {0.0f, 0.0f, 1920.0f, 1080.0f, 0.0f, 1.0f};
+        pfn(g_command_buffer, 1, &viewport);
+    });
+    bench_command<PFN_vkCmdSetScissorWithCount>("vkCmdSetScissorWithCount", [&](PFN_vkCmdSetScissorWithCount pfn) {
+        VkRect2D scissor = {{0, 0}, {1920, 1080}};
+        pfn(g_command_buffer, 1, &scissor);
+    });
+    bench_command<PFN_vkCmdSetLineWidth>("vkCmdSetLineWidth", [&](PFN_vkCmdSetLineWidth pfn) {
+        pfn(g_command_buffer, 1.0f);
+    });
+    bench_command<PFN_vkCmdSetBlendConstants>("vkCmdSetBlendConstants", [&](PFN_vkCmdSetBlendConstants pfn) {
+        const float constants[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+        pfn(g_command_buffer, constants);
+    });
+    bench_command<PFN_vkCmdSetDepthBounds>("vkCmdSetDepthBounds", [&](PFN_vkCmdSetDepthBounds pfn) {
+        pfn(g_command_buffer, 0.0f, 1.0f);
+    });
+    bench_command<PFN_vkCmdSetStencilCompareMask>("vkCmdSetStencilCompareMask", [&](PFN_vkCmdSetStencilCompareMask pfn) {
+        pfn(g_command_buffer, VK_STENCIL_FACE_FRONT_AND_BACK, 0xff);
+    });
+    bench_command<PFN_vkCmdSetStencilWriteMask>("vkCmdSetStencilWriteMask", [&](PFN_vkCmdSetStencilWriteMask pfn) {
+        pfn(g_command_buffer, VK_STENCIL_FACE_FRONT_AND_BACK, 0xff);
+    });
+    bench_command<PFN_vkCmdSetStencilReference>("vkCmdSetStencilReference", [&](PFN_vkCmdSetStencilReference pfn) {
+        pfn(g_command_buffer, VK_STENCIL_FACE_FRONT_AND_BACK, 1);
+    });
+    bench_command<PFN_vkCmdSetCullMode>("vkCmdSetCullMode", [&](PFN_vkCmdSetCullMode pfn) {
+        pfn(g_command_buffer, VK_CULL_MODE_BACK_BIT);
+    });
+    bench_command<PFN_vkCmdSetFrontFace>("vkCmdSetFrontFace", [&](PFN_vkCmdSetFrontFace pfn) {
+        pfn(g_command_buffer, VK_FRONT_FACE_COUNTER_CLOCKWISE);
+    });
+    bench_command<PFN_vkCmdSetPrimitiveTopology>("vkCmdSetPrimitiveTopology", [&](PFN_vkCmdSetPrimitiveTopology pfn) {
+        pfn(g_command_buffer, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
+    });
+    bench_command<PFN_vkCmdSetDepthTestEnable>("vkCmdSetDepthTestEnable", [&](PFN_vkCmdSetDepthTestEnable pfn) {
+        pfn(g_command_buffer, VK_TRUE);
+    });
+    bench_command<PFN_vkCmdSetDepthWriteEnable>("vkCmdSetDepthWriteEnable", [&](PFN_vkCmdSetDepthWriteEnable pfn) {
+        pfn(g_command_buffer, VK_TRUE);
+    });
+    bench_command<PFN_vkCmdSetDepthCompareOp>("vkCmdSetDepthCompareOp", [&](PFN_vkCmdSetDepthCompareOp pfn) {
+        pfn(g_command_buffer, VK_COMPARE_OP_LESS);
+    });
+}
+
+// 같은 SPIR-V 를 반복해서 만들고 파괴합니다. 레이어 경유 시에는 미리 만들어 둔 모듈과 공유되므로
+// 드라이버 호출 대신 해시 + 비교 비용만 남습니다.
+static void bench_shader_modules() {
+    printf("\n[Shader modules]\n");
+
+    std::vector<uint32_t> spirv(16 * 1024 / sizeof(uint32_t));
+    spirv[0] = 0x07230203;  // SPIR-V magic
+    for (size_t i = 1; i < spirv.size(); ++i) spirv[i] = (uint32_t)(i * 2654435761u);
+
+    bench_run("hash_words (16 KiB)", [&] {
+        bench_do_not_optimize(hash_words(spirv.data(), spirv.size()));
+        return 1;
+    });
+
+    VkShaderModuleCreateInfo create_info = {VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
+    create_info.codeSize = spirv.size() * sizeof(uint32_t);
+    create_info.pCode = spirv.data();
+
+    auto create_shader_module = get_layer_proc<PFN_vkCreateShaderModule>("vkCreateShaderModule");
+    auto destroy_shader_module = get_layer_proc<PFN_vkDestroyShaderModule>("vkDestroyShaderModule");
+    VkShaderModule resident = VK_NULL_HANDLE;
+    create_shader_module(g_device, &create_info, nullptr, &resident);
+
+    // 16 KiB 모듈. bench_command 는 PFN 하나만 받으므로 destroy 는 같은 경로 (레이어 / ICD) 의 것을 따로 고릅니다.
+    auto icd_destroy = get_icd_proc<PFN_vkDestroyShaderModule>("vkDestroyShaderModule");
+    bench_command<PFN_vkCreateShaderModule>("vkCreateShaderModule", [&](PFN_vkCreateShaderModule pfn) {
+        VkShaderModule module = VK_NULL_HANDLE;
+        pfn(g_device, &create_info, nullptr, &module);
+        (pfn == create_shader_module ? destroy_shader_module : icd_destroy)(g_device, module, nullptr);
+    });
+
+    destroy_shader_module(g_device, resident, nullptr);
+}
+
+// 작은 버퍼용 할당 / 해제. suballocation 모드에서는 레이어 경유 시 드라이버 할당 대신 블록에서 잘라 줍니다.
+static void bench_memory() {
+    printf("\n[Device memory]\n");
+
+    VkMemoryAllocateInfo allocate_info = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+    allocate_info.allocationSize = 4096;
+    allocate_info.memoryTypeIndex = 1;
+
+    auto layer_allocate = get_layer_proc<PFN_vkAllocateMemory>("vkAllocateMemory");
+    auto layer_free = get_layer_proc<PFN_vkFreeMemory>("vkFreeMemory");
+    auto icd_free = get_icd_proc<PFN_vkFreeMemory>("vkFreeMemory");
+    bench_command<PFN_vkAllocateMemory>("vkAllocateMemory", [&](PFN_vkAllocateMemory pfn) {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        pfn(g_device, &allocate_info, nullptr, &memory);
+        (pfn == layer_allocate ? layer_free : icd_free)(g_device, memory, nullptr);
+    });
+}
+
+static bool setup() {
+    if (!g_loader.init()) return false;
+    if (g_loader.create_instance(&g_instance) != VK_SUCCESS) return false;
+    g_physical_device = g_loader.get_physical_device(g_instance);
+    if (g_loader.create_device(g_physical_device, &g_device) != VK_SUCCESS) return false;
+
+    auto get_device_queue = get_layer_proc<PFN_vkGetDeviceQueue>("vkGetDeviceQueue");
+    get_device_queue(g_device, 0, 0, &g_queue);
+
+    VkCommandPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    get_layer_proc<PFN_vkCreateCommandPool>("vkCreateCommandPool")(g_device, &pool_info, nullptr, &g_command_pool);
+
+    VkCommandBufferAllocateInfo allocate_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+    allocate_info.commandPool = g_command_pool;
+    allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocate_info.commandBufferCount = 1;
+    get_layer_proc<PFN_vkAllocateCommandBuffers>("vkAllocateCommandBuffers")(g_device, &allocate_info, &g_command_buffer);
+
+    VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    get_layer_proc<PFN_vkBeginCommandBuffer>("vkBeginCommandBuffer")(g_command_buffer, &begin_info);
+    return true;
+}
+
+static void teardown() {
+    get_layer_proc<PFN_vkEndCommandBuffer>("vkEndCommandBuffer")(g_command_buffer);
+    get_layer_proc<PFN_vkFreeCommandBuffers>("vkFreeCommandBuffers")(g_device, g_command_pool, 1, &g_command_buffer);
+    get_layer_proc<PFN_vkDestroyCommandPool>("vkDestroyCommandPool")(g_device, g_command_pool, nullptr);
+    g_loader.destroy_device(g_device);
+    g_loader.destroy_instance(g_instance);
+}
+
+int main() {
+    // 생성/파괴 루프에서 로그가 측정을 방해하지 않도록 에러 로그만 남깁니다.
+    log_set_min_priority(LogPriority::Error);
+    // 디바이스 생성/파괴 루프마다 파이프라인 캐시 파일을 읽고 쓰지 않도록 끕니다.
+    setenv("DEBUG_MY_LAYER_PIPELINE_CACHE", "0", 1);
+    // 할당 벤치마크가 suballocation 경로를 타도록 합니다.
+    setenv("DEBUG_MY_LAYER_MEMORY", "2", 1);
+
+    if (!setup()) {
+        fprintf(stderr, "failed to set up the layer on the mock ICD\n");
+        return EXIT_FAILURE;
+    }
+
+    bench_proc_addr();
+    bench_create_destroy();
+    bench_hot_path();
+    bench_state_commands();
+    bench_shader_modules();
+    bench_memory();
+
+    teardown();
+    return EXIT_SUCCESS;
+}
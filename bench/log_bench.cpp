@@ -0,0 +1,81 @@
+// 로깅 비용 벤치마크.
+// 훅 안에서 ALOGI 를 호출했을 때 호출 스레드가 부담하는 비용을
+// 기존 방식 (호출 스레드에서 포맷팅 + 출력) 과 비교합니다.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "bench_util.h"
+#include "log.h"
+
+namespace {
+
+class CountingLogSink : public LogSink {
+public:
+    void write(LogPriority, const char*, const char* message) override {
+        count.fetch_add(1, std::memory_order_relaxed);
+        bench_do_not_optimize(message);
+    }
+    std::atomic<uint64_t> count{0};
+};
+
+constexpr int kBatch = 128;  // ring (256) 을 넘기지 않도록 배치마다 flush
+
+}  // namespace
+
+int main() {
+    // drain 스레드가 모든 레코드를 sink 로 보내도록 rate limit 을 끕니다.
+    setenv("DEBUG_MY_LAYER_LOG_RATE_LIMIT", "0", 1);
+
+    auto sink = std::make_unique<CountingLogSink>();
+    CountingLogSink* counting_sink = sink.get();
+    log_clear_sinks();
+    log_add_sink(std::move(sink));
+
+    printf("Logging cost on the calling thread\n");
+
+    log_set_min_priority(LogPriority::Error);
+    bench_run("ALOGI filtered out (level = error)", [] {
+        ALOGI("vkQueueSubmit queue=%p submits=%u", (void*)0x1234, 3u);
+        return 1;
+    });
+
+    // drain 스레드가 따라잡도록 배치 사이에 flush 하고, 배치 안의 호출 시간만 잽니다.
+    log_set_min_priority(LogPriority::Info);
+    using Clock = std::chrono::steady_clock;
+    Clock::duration producer_time{};
+    uint64_t calls = 0;
+    Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(300);
+    while (Clock::now() < deadline) {
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < kBatch; ++i) {
+            ALOGI("vkQueueSubmit queue=%p submits=%u app=%s", (void*)0x1234, (unsigned)i, "com.example.app");
+        }
+        producer_time += Clock::now() - start;
+        calls += kBatch;
+        log_flush(1000);
+    }
+    printf("%-48s %10.2f ns/op\n", "ALOGI async (3 args)",
+           std::chrono::duration<double, std::nano>(producer_time).count() / (double)calls);
+
+    // 기존 방식: 호출 스레드에서 printf 포맷팅 후 바로 출력 (/dev/null 로 write)
+    int null_fd = open("/dev/null", O_WRONLY);
+    bench_run("snprintf + write (synchronous)", [&] {
+        char message[256];
+        int length = snprintf(message, sizeof(message), "vkQueueSubmit queue=%p submits=%u app=%s",
+                              (void*)0x1234, 3u, "com.example.app");
+        bench_do_not_optimize(write(null_fd, message, (size_t)length));
+        return 1;
+    });
+    close(null_fd);
+
+    log_flush(1000);
+    printf("delivered %llu, dropped %llu\n",
+           (unsigned long long)counting_sink->count.load(), (unsigned long long)log_dropped_count());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,775 @@
+#include "mock_icd.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct MockDispatchable {
+    void* dispatch_key;
+};
+
+struct MockInstance : MockDispatchable {
+    MockDispatchable physical_device;
+};
+
+struct MockDevice : MockDispatchable {
+    MockDispatchable queue;
+};
+
+uint64_t g_call_count = 0;
+uint64_t g_next_handle = 1;
+MockMemoryCall g_last_memory_call;
+uint64_t g_live_memory_count = 0;
+VkMemoryRequirements g_image_memory_requirements = {64 * 1024, 4096, 0x1};
+size_t g_min_memory_map_alignment = 64;
+
+template <typename T>
+T next_handle() {
+    return (T)(uintptr_t)(g_next_handle++);
+}
+
+// 캐시는 "컴파일된" 셰이더 모듈 핸들 목록만 들고 있습니다.
+struct MockPipelineCache {
+    std::vector<uint64_t> entries;
+};
+
+// host 메모리로 흉내 내는 VkDeviceMemory. 핸들은 이 구조체의 주소입니다.
+// map 주소 (base) 는 할당 시점의 minMemoryMapAlignment 에 맞춥니다.
+struct MockDeviceMemory {
+    std::vector<uint8_t> data;
+    uint8_t* base;
+};
+
+MockInstance* to_mock(VkInstance instance) { return reinterpret_cast<MockInstance*>(instance); }
+MockDevice* to_mock(VkDevice device) { return reinterpret_cast<MockDevice*>(device); }
+
+// --- Instance 레벨 ---
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkCreateInstance(
+    const VkInstanceCreateInfo*, const VkAllocationCallbacks*, VkInstance* pInstance)
+{
+    g_call_count++;
+    MockInstance* instance = new MockInstance;
+    instance->dispatch_key = instance;
+    instance->physical_device.dispatch_key = instance;
+    *pInstance = reinterpret_cast<VkInstance>(instance);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkDestroyInstance(VkInstance instance, const VkAllocationCallbacks*) {
+    g_call_count++;
+    delete to_mock(instance);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkEnumeratePhysicalDevices(
+    VkInstance instance, uint32_t* pPhysicalDeviceCount, VkPhysicalDevice* pPhysicalDevices)
+{
+    g_call_count++;
+    if (!pPhysicalDevices) {
+        *pPhysicalDeviceCount = 1;
+        return VK_SUCCESS;
+    }
+    if (*pPhysicalDeviceCount < 1) return VK_INCOMPLETE;
+    pPhysicalDevices[0] = reinterpret_cast<VkPhysicalDevice>(&to_mock(instance)->physical_device);
+    *pPhysicalDeviceCount = 1;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceProperties(
+    VkPhysicalDevice, VkPhysicalDeviceProperties* pProperties)
+{
+    g_call_count++;
+    *pProperties = {};
+    pProperties->apiVersion = VK_API_VERSION_1_3;
+    pProperties->driverVersion = 1;
+    pProperties->vendorID = 0x10005;  // VK_VENDOR_ID_MESA
+    pProperties->deviceID = 1;
+    pProperties->deviceType = VK_PHYSICAL_DEVICE_TYPE_CPU;
+    strncpy(pProperties->deviceName, "MyLayer Mock ICD", VK_MAX_PHYSICAL_DEVICE_NAME_SIZE);
+    memset(pProperties->pipelineCacheUUID, 0x4d, VK_UUID_SIZE);
+    pProperties->limits.maxMemoryAllocationCount = 4096;
+    pProperties->limits.bufferImageGranularity = 1;
+    pProperties->limits.nonCoherentAtomSize = 64;
+    pProperties->limits.minMemoryMapAlignment = g_min_memory_map_alignment;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceMemoryProperties(
+    VkPhysicalDevice, VkPhysicalDeviceMemoryProperties* pMemoryProperties)
+{
+    g_call_count++;
+    *pMemoryProperties = {};
+    pMemoryProperties->memoryHeapCount = 1;
+    pMemoryProperties->memoryHeaps[0].size = 4ull << 30;
+    pMemoryProperties->memoryHeaps[0].flags = VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+    pMemoryProperties->memoryTypeCount = 2;
+    pMemoryProperties->memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    pMemoryProperties->memoryTypes[1].propertyFlags =
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkGetPhysicalDeviceQueueFamilyProperties(
+    VkPhysicalDevice, uint32_t* pQueueFamilyPropertyCount, VkQueueFamilyProperties* pQueueFamilyProperties)
+{
+    g_call_count++;
+    if (!pQueueFamilyProperties) {
+        *pQueueFamilyPropertyCount = 1;
+        return;
+    }
+    if (*pQueueFamilyPropertyCount < 1) return;
+    pQueueFamilyProperties[0] = {};
+    pQueueFamilyProperties[0].queueFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+    pQueueFamilyProperties[0].queueCount = 1;
+    pQueueFamilyProperties[0].timestampValidBits = 64;
+    *pQueueFamilyPropertyCount = 1;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkEnumerateDeviceExtensionProperties(
+    VkPhysicalDevice, const char*, uint32_t* pPropertyCount, VkExtensionProperties*)
+{
+    g_call_count++;
+    *pPropertyCount = 0;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkCreateDevice(
+    VkPhysicalDevice, const VkDeviceCreateInfo*, const VkAllocationCallbacks*, VkDevice* pDevice)
+{
+    g_call_count++;
+    MockDevice* device = new MockDevice;
+    device->dispatch_key = device;
+    device->queue.dispatch_key = device;
+    *pDevice = reinterpret_cast<VkDevice>(device);
+    return VK_SUCCESS;
+}
+
+// --- Device 레벨 ---
+
+VKAPI_ATTR void VKAPI_CALL mock_vkDestroyDevice(VkDevice device, const VkAllocationCallbacks*) {
+    g_call_count++;
+    delete to_mock(device);
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkGetDeviceQueue(VkDevice device, uint32_t, uint32_t, VkQueue* pQueue) {
+    g_call_count++;
+    *pQueue = reinterpret_cast<VkQueue>(&to_mock(device)->queue);
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkGetDeviceQueue2(VkDevice device, const VkDeviceQueueInfo2*, VkQueue* pQueue) {
+    g_call_count++;
+    *pQueue = reinterpret_cast<VkQueue>(&to_mock(device)->queue);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkQueueSubmit(VkQueue, uint32_t, const VkSubmitInfo*, VkFence) {
+    g_call_count++;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkQueueSubmit2(VkQueue, uint32_t, const VkSubmitInfo2*, VkFence) {
+    g_call_count++;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkQueueWaitIdle(VkQueue) {
+    g_call_count++;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkQueuePresentKHR(VkQueue, const VkPresentInfoKHR*) {
+    g_call_count++;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkDeviceWaitIdle(VkDevice) {
+    g_call_count++;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkCreateCommandPool(
+    VkDevice, const VkCommandPoolCreateInfo*, const VkAllocationCallbacks*, VkCommandPool* pCommandPool)
+{
+    g_call_count++;
+    *pCommandPool = next_handle<VkCommandPool>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkDestroyCommandPool(VkDevice, VkCommandPool, const VkAllocationCallbacks*) {
+    g_call_count++;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkAllocateCommandBuffers(
+    VkDevice device, const VkCommandBufferAllocateInfo* pAllocateInfo, VkCommandBuffer* pCommandBuffers)
+{
+    g_call_count++;
+    for (uint32_t i = 0; i < pAllocateInfo->commandBufferCount; ++i) {
+        MockDispatchable* command_buffer = new MockDispatchable;
+        command_buffer->dispatch_key = to_mock(device)->dispatch_key;
+        pCommandBuffers[i] = reinterpret_cast<VkCommandBuffer>(command_buffer);
+    }
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkFreeCommandBuffers(
+    VkDevice, VkCommandPool, uint32_t commandBufferCount, const VkCommandBuffer* pCommandBuffers)
+{
+    g_call_count++;
+    for (uint32_t i = 0; i < commandBufferCount; ++i) {
+        delete reinterpret_cast<MockDispatchable*>(pCommandBuffers[i]);
+    }
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkBeginCommandBuffer(VkCommandBuffer, const VkCommandBufferBeginInfo*) {
+    g_call_count++;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkEndCommandBuffer(VkCommandBuffer) {
+    g_call_count++;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkCreatePipelineCache(
+    VkDevice, const VkPipelineCacheCreateInfo* pCreateInfo, const VkAllocationCallbacks*, VkPipelineCache* pPipelineCache)
+{
+    g_call_count++;
+    MockPipelineCache* cache = new MockPipelineCache;
+    VkPipelineCacheHeaderVersionOne header;
+    if (pCreateInfo->initialDataSize >= sizeof(header)) {
+        memcpy(&header, pCreateInfo->pInitialData, sizeof(header));
+        if (header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+            delete cache;
+            return VK_ERROR_INITIALIZATION_FAILED;
+        }
+        size_t count = (pCreateInfo->initialDataSize - sizeof(header)) / sizeof(uint64_t);
+        cache->entries.resize(count);
+        memcpy(cache->entries.data(), (const uint8_t*)pCreateInfo->pInitialData + sizeof(header),
+               count * sizeof(uint64_t));
+    }
+    *pPipelineCache = reinterpret_cast<VkPipelineCache>(cache);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkDestroyPipelineCache(
+    VkDevice, VkPipelineCache pipelineCache, const VkAllocationCallbacks*)
+{
+    g_call_count++;
+    delete reinterpret_cast<MockPipelineCache*>(pipelineCache);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkGetPipelineCacheData(
+    VkDevice, VkPipelineCache pipelineCache, size_t* pDataSize, void* pData)
+{
+    g_call_count++;
+    MockPipelineCache* cache = reinterpret_cast<MockPipelineCache*>(pipelineCache);
+    VkPipelineCacheHeaderVersionOne header = {};
+    header.headerSize = sizeof(header);
+    header.headerVersion = VK_PIPELINE_CACHE_HEADER_VERSION_ONE;
+    header.vendorID = 0x10005;
+    header.deviceID = 1;
+    memset(header.pipelineCacheUUID, 0x4d, VK_UUID_SIZE);
+
+    size_t size = sizeof(header) + cache->entries.size() * sizeof(uint64_t);
+    if (!pData) {
+        *pDataSize = size;
+        return VK_SUCCESS;
+    }
+    if (*pDataSize < size) return VK_INCOMPLETE;
+    memcpy(pData, &header, sizeof(header));
+    memcpy((uint8_t*)pData + sizeof(header), cache->entries.data(), cache->entries.size() * sizeof(uint64_t));
+    *pDataSize = size;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkMergePipelineCaches(
+    VkDevice, VkPipelineCache dstCache, uint32_t srcCacheCount, const VkPipelineCache* pSrcCaches)
+{
+    g_call_count++;
+    MockPipelineCache* dst = reinterpret_cast<MockPipelineCache*>(dstCache);
+    for (uint32_t i = 0; i < srcCacheCount; ++i) {
+        for (uint64_t entry : reinterpret_cast<MockPipelineCache*>(pSrcCaches[i])->entries) {
+            if (std::find(dst->entries.begin(), dst->entries.end(), entry) == dst->entries.end()) {
+                dst->entries.push_back(entry);
+            }
+        }
+    }
+    return VK_SUCCESS;
+}
+
+// 셰이더 모듈 핸들이 캐시에 있으면 hit, 없으면 "컴파일" 해서 캐시에 넣습니다.
+template <typename CreateInfo>
+VkResult create_mock_pipelines(VkPipelineCache pipelineCache, uint32_t createInfoCount,
+                               const CreateInfo* pCreateInfos, VkPipeline* pPipelines,
+                               uint64_t (*key_of)(const CreateInfo&))
+{
+    g_call_count++;
+    MockPipelineCache* cache = reinterpret_cast<MockPipelineCache*>(pipelineCache);
+    for (uint32_t i = 0; i < createInfoCount; ++i) {
+        uint64_t key = key_of(pCreateInfos[i]);
+        bool hit = cache && std::find(cache->entries.begin(), cache->entries.end(), key) != cache->entries.end();
+        if (cache && !hit) cache->entries.push_back(key);
+
+        for (const VkBaseInStructure* next = static_cast<const VkBaseInStructure*>(pCreateInfos[i].pNext);
+             next; next = next->pNext) {
+            if (next->sType != VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO) continue;
+            VkPipelineCreationFeedback* feedback =
+                reinterpret_cast<const VkPipelineCreationFeedbackCreateInfo*>(next)->pPipelineCreationFeedback;
+            feedback->flags = VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT |
+                (hit ? VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT : 0);
+            feedback->duration = hit ? 1000 : 1000000;
+        }
+        pPipelines[i] = next_handle<VkPipeline>();
+    }
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkCreateGraphicsPipelines(
+    VkDevice, VkPipelineCache pipelineCache, uint32_t createInfoCount,
+    const VkGraphicsPipelineCreateInfo* pCreateInfos, const VkAllocationCallbacks*, VkPipeline* pPipelines)
+{
+    return create_mock_pipelines<VkGraphicsPipelineCreateInfo>(
+        pipelineCache, createInfoCount, pCreateInfos, pPipelines, [](const VkGraphicsPipelineCreateInfo& info) {
+            return info.stageCount ? (uint64_t)info.pStages[0].module : 0;
+        });
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkCreateComputePipelines(
+    VkDevice, VkPipelineCache pipelineCache, uint32_t createInfoCount,
+    const VkComputePipelineCreateInfo* pCreateInfos, const VkAllocationCallbacks*, VkPipeline* pPipelines)
+{
+    return create_mock_pipelines<VkComputePipelineCreateInfo>(
+        pipelineCache, createInfoCount, pCreateInfos, pPipelines, [](const VkComputePipelineCreateInfo& info) {
+            return (uint64_t)info.stage.module;
+        });
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkDestroyPipeline(VkDevice, VkPipeline, const VkAllocationCallbacks*) {
+    g_call_count++;
+}
+
+// 드라이버가 SPIR-V 를 한 번은 읽는다고 보고 모든 워드를 훑습니다.
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkCreateShaderModule(
+    VkDevice, const VkShaderModuleCreateInfo* pCreateInfo, const VkAllocationCallbacks*, VkShaderModule* pShaderModule)
+{
+    g_call_count++;
+    uint32_t checksum = 0;
+    for (size_t i = 0; i < pCreateInfo->codeSize / sizeof(uint32_t); ++i) checksum ^= pCreateInfo->pCode[i];
+    asm volatile("" : : "r"(checksum));
+    *pShaderModule = next_handle<VkShaderModule>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkDestroyShaderModule(VkDevice, VkShaderModule, const VkAllocationCallbacks*) {
+    g_call_count++;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkAllocateMemory(
+    VkDevice, const VkMemoryAllocateInfo* pAllocateInfo, const VkAllocationCallbacks*, VkDeviceMemory* pMemory)
+{
+    g_call_count++;
+    MockDeviceMemory* memory = new MockDeviceMemory;
+    memory->data.resize(pAllocateInfo->allocationSize + g_min_memory_map_alignment);
+    uintptr_t address = (uintptr_t)memory->data.data();
+    memory->base = (uint8_t*)((address + g_min_memory_map_alignment - 1) & ~(uintptr_t)(g_min_memory_map_alignment - 1));
+    *pMemory = (VkDeviceMemory)(uintptr_t)memory;
+    g_live_memory_count++;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkFreeMemory(VkDevice, VkDeviceMemory memory, const VkAllocationCallbacks*) {
+    g_call_count++;
+    if (memory != VK_NULL_HANDLE) g_live_memory_count--;
+    delete reinterpret_cast<MockDeviceMemory*>((uintptr_t)memory);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkMapMemory(
+    VkDevice, VkDeviceMemory memory, VkDeviceSize offset, VkDeviceSize size, VkMemoryMapFlags, void** ppData)
+{
+    g_call_count++;
+    g_last_memory_call = {memory, offset, size};
+    *ppData = reinterpret_cast<MockDeviceMemory*>((uintptr_t)memory)->base + offset;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkUnmapMemory(VkDevice, VkDeviceMemory) {
+    g_call_count++;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkFlushMappedMemoryRanges(
+    VkDevice, uint32_t memoryRangeCount, const VkMappedMemoryRange* pMemoryRanges)
+{
+    g_call_count++;
+    for (uint32_t i = 0; i < memoryRangeCount; ++i) {
+        g_last_memory_call = {pMemoryRanges[i].memory, pMemoryRanges[i].offset, pMemoryRanges[i].size};
+    }
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkInvalidateMappedMemoryRanges(
+    VkDevice, uint32_t memoryRangeCount, const VkMappedMemoryRange* pMemoryRanges)
+{
+    g_call_count++;
+    for (uint32_t i = 0; i < memoryRangeCount; ++i) {
+        g_last_memory_call = {pMemoryRanges[i].memory, pMemoryRanges[i].offset, pMemoryRanges[i].size};
+    }
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkGetBufferMemoryRequirements(
+    VkDevice, VkBuffer, VkMemoryRequirements* pMemoryRequirements)
+{
+    g_call_count++;
+    pMemoryRequirements->size = 4096;
+    pMemoryRequirements->alignment = 256;
+    pMemoryRequirements->memoryTypeBits = 0x3;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkGetImageMemoryRequirements(
+    VkDevice, VkImage, VkMemoryRequirements* pMemoryRequirements)
+{
+    g_call_count++;
+    *pMemoryRequirements = g_image_memory_requirements;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkBindBufferMemory(
+    VkDevice, VkBuffer, VkDeviceMemory memory, VkDeviceSize memoryOffset)
+{
+    g_call_count++;
+    g_last_memory_call = {memory, memoryOffset, 0};
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkBindImageMemory(
+    VkDevice, VkImage, VkDeviceMemory memory, VkDeviceSize memoryOffset)
+{
+    g_call_count++;
+    g_last_memory_call = {memory, memoryOffset, 0};
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkBindBufferMemory2(
+    VkDevice, uint32_t bindInfoCount, const VkBindBufferMemoryInfo* pBindInfos)
+{
+    g_call_count++;
+    for (uint32_t i = 0; i < bindInfoCount; ++i) g_last_memory_call = {pBindInfos[i].memory, pBindInfos[i].memoryOffset, 0};
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkBindImageMemory2(
+    VkDevice, uint32_t bindInfoCount, const VkBindImageMemoryInfo* pBindInfos)
+{
+    g_call_count++;
+    for (uint32_t i = 0; i < bindInfoCount; ++i) g_last_memory_call = {pBindInfos[i].memory, pBindInfos[i].memoryOffset, 0};
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkCmdBindPipeline(VkCommandBuffer, VkPipelineBindPoint, VkPipeline) {
+    g_call_count++;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkCmdBindDescriptorSets(
+    VkCommandBuffer, VkPipelineBindPoint, VkPipelineLayout, uint32_t, uint32_t, const VkDescriptorSet*, uint32_t,
+    const uint32_t*)
+{
+    g_call_count++;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkCmdBindVertexBuffers(
+    VkCommandBuffer, uint32_t, uint32_t, const VkBuffer*, const VkDeviceSize*)
+{
+    g_call_count++;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkCmdBindIndexBuffer(VkCommandBuffer, VkBuffer, VkDeviceSize, VkIndexType) {
+    g_call_count++;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkCmdSetViewport(VkCommandBuffer, uint32_t, uint32_t, const VkViewport*) {
+    g_call_count++;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkCmdSetScissor(VkCommandBuffer, uint32_t, uint32_t, const VkRect2D*) {
+    g_call_count++;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkCmdDraw(VkCommandBuffer, uint32_t, uint32_t, uint32_t, uint32_t) {
+    g_call_count++;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkCmdDrawIndexed(VkCommandBuffer, uint32_t, uint32_t, uint32_t, int32_t, uint32_t) {
+    g_call_count++;
+}
+
+VKAPI_ATTR void VKAPI_CALL mock_vkCmdDispatch(VkCommandBuffer, uint32_t, uint32_t, uint32_t) {
+    g_call_count++;
+}
+
+// 상태만 바꾸는 vkCmd* (동적 상태, 바인딩, render pass 경계). 호출 수만 셉니다.
+// PFN 타입으로 캐스팅할 때 인자 타입이 정해집니다.
+template <typename... Args>
+VKAPI_ATTR void VKAPI_CALL mock_vkCmdNoop(Args...) {
+    g_call_count++;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL mock_vkResetCommandBuffer(VkCommandBuffer, VkCommandBufferResetFlags) {
+    g_call_count++;
+    return VK_SUCCESS;
+}
+
+struct MockProc {
+    const char* name;
+    PFN_vkVoidFunction pfn;
+    bool device_level;
+};
+
+#define MOCK_INSTANCE_PROC(name) {"vk" #name, (PFN_vkVoidFunction)mock_vk##name, false}
+#define MOCK_DEVICE_PROC(name) {"vk" #name, (PFN_vkVoidFunction)mock_vk##name, true}
+#define MOCK_CMD_NOOP(name) {"vk" #name, (PFN_vkVoidFunction)(PFN_vk##name)mock_vkCmdNoop, true}
+
+const MockProc g_mock_procs[] = {
+    MOCK_INSTANCE_PROC(CreateInstance),
+    MOCK_INSTANCE_PROC(DestroyInstance),
+    MOCK_INSTANCE_PROC(EnumeratePhysicalDevices),
+    MOCK_INSTANCE_PROC(GetPhysicalDeviceProperties),
+    MOCK_INSTANCE_PROC(GetPhysicalDeviceMemoryProperties),
+    MOCK_INSTANCE_PROC(GetPhysicalDeviceQueueFamilyProperties),
+    MOCK_INSTANCE_PROC(EnumerateDeviceExtensionProperties),
+    MOCK_INSTANCE_PROC(CreateDevice),
+    MOCK_DEVICE_PROC(DestroyDevice),
+    MOCK_DEVICE_PROC(GetDeviceQueue),
+    MOCK_DEVICE_PROC(GetDeviceQueue2),
+    MOCK_DEVICE_PROC(QueueSubmit),
+    MOCK_DEVICE_PROC(QueueSubmit2),
+    MOCK_DEVICE_PROC(QueueWaitIdle),
+    MOCK_DEVICE_PROC(QueuePresentKHR),
+    MOCK_DEVICE_PROC(DeviceWaitIdle),
+    MOCK_DEVICE_PROC(CreateCommandPool),
+    MOCK_DEVICE_PROC(DestroyCommandPool),
+    MOCK_DEVICE_PROC(AllocateCommandBuffers),
+    MOCK_DEVICE_PROC(FreeCommandBuffers),
+    MOCK_DEVICE_PROC(BeginCommandBuffer),
+    MOCK_DEVICE_PROC(EndCommandBuffer),
+    MOCK_DEVICE_PROC(CreatePipelineCache),
+    MOCK_DEVICE_PROC(DestroyPipelineCache),
+    MOCK_DEVICE_PROC(GetPipelineCacheData),
+    MOCK_DEVICE_PROC(MergePipelineCaches),
+    MOCK_DEVICE_PROC(CreateGraphicsPipelines),
+    MOCK_DEVICE_PROC(CreateComputePipelines),
+    MOCK_DEVICE_PROC(DestroyPipeline),
+    MOCK_DEVICE_PROC(CreateShaderModule),
+    MOCK_DEVICE_PROC(DestroyShaderModule),
+    MOCK_DEVICE_PROC(AllocateMemory),
+    MOCK_DEVICE_PROC(FreeMemory),
+    MOCK_DEVICE_PROC(MapMemory),
+    MOCK_DEVICE_PROC(UnmapMemory),
+    MOCK_DEVICE_PROC(FlushMappedMemoryRanges),
+    MOCK_DEVICE_PROC(InvalidateMappedMemoryRanges),
+    MOCK_DEVICE_PROC(GetBufferMemoryRequirements),
+    MOCK_DEVICE_PROC(GetImageMemoryRequirements),
+    MOCK_DEVICE_PROC(BindBufferMemory),
+    MOCK_DEVICE_PROC(BindImageMemory),
+    MOCK_DEVICE_PROC(BindBufferMemory2),
+    MOCK_DEVICE_PROC(BindImageMemory2),
+    MOCK_DEVICE_PROC(CmdBindPipeline),
+    MOCK_DEVICE_PROC(CmdBindDescriptorSets),
+    MOCK_DEVICE_PROC(CmdBindVertexBuffers),
+    MOCK_DEVICE_PROC(CmdBindIndexBuffer),
+    MOCK_DEVICE_PROC(CmdSetViewport),
+    MOCK_DEVICE_PROC(CmdSetScissor),
+    MOCK_DEVICE_PROC(CmdDraw),
+    MOCK_DEVICE_PROC(CmdDrawIndexed),
+    MOCK_DEVICE_PROC(CmdDispatch),
+    MOCK_DEVICE_PROC(ResetCommandBuffer),
+    MOCK_CMD_NOOP(CmdDrawIndirect),
+    MOCK_CMD_NOOP(CmdDrawIndexedIndirect),
+    MOCK_CMD_NOOP(CmdDrawIndirectCount),
+    MOCK_CMD_NOOP(CmdDrawIndirectCountKHR),
+    MOCK_CMD_NOOP(CmdDrawIndexedIndirectCount),
+    MOCK_CMD_NOOP(CmdDrawIndexedIndirectCountKHR),
+    MOCK_CMD_NOOP(CmdDispatchBase),
+    MOCK_CMD_NOOP(CmdDispatchIndirect),
+    MOCK_CMD_NOOP(CmdExecuteCommands),
+    MOCK_CMD_NOOP(CmdBeginRenderPass),
+    MOCK_CMD_NOOP(CmdBeginRenderPass2),
+    MOCK_CMD_NOOP(CmdBeginRenderPass2KHR),
+    MOCK_CMD_NOOP(CmdNextSubpass),
+    MOCK_CMD_NOOP(CmdNextSubpass2),
+    MOCK_CMD_NOOP(CmdNextSubpass2KHR),
+    MOCK_CMD_NOOP(CmdEndRenderPass),
+    MOCK_CMD_NOOP(CmdEndRenderPass2),
+    MOCK_CMD_NOOP(CmdEndRenderPass2KHR),
+    MOCK_CMD_NOOP(CmdBeginRendering),
+    MOCK_CMD_NOOP(CmdBeginRenderingKHR),
+    MOCK_CMD_NOOP(CmdEndRendering),
+    MOCK_CMD_NOOP(CmdEndRenderingKHR),
+    MOCK_CMD_NOOP(CmdPushConstants),
+    MOCK_CMD_NOOP(CmdPushDescriptorSetKHR),
+    MOCK_CMD_NOOP(CmdBindVertexBuffers2),
+    MOCK_CMD_NOOP(CmdBindVertexBuffers2EXT),
+    MOCK_CMD_NOOP(CmdSetLineWidth),
+    MOCK_CMD_NOOP(CmdSetBlendConstants),
+    MOCK_CMD_NOOP(CmdSetDepthBounds),
+    MOCK_CMD_NOOP(CmdSetStencilCompareMask),
+    MOCK_CMD_NOOP(CmdSetStencilWriteMask),
+    MOCK_CMD_NOOP(CmdSetStencilReference),
+    MOCK_CMD_NOOP(CmdSetCullMode),
+    MOCK_CMD_NOOP(CmdSetCullModeEXT),
+    MOCK_CMD_NOOP(CmdSetFrontFace),
+    MOCK_CMD_NOOP(CmdSetFrontFaceEXT),
+    MOCK_CMD_NOOP(CmdSetPrimitiveTopology),
+    MOCK_CMD_NOOP(CmdSetPrimitiveTopologyEXT),
+    MOCK_CMD_NOOP(CmdSetDepthTestEnable),
+    MOCK_CMD_NOOP(CmdSetDepthTestEnableEXT),
+    MOCK_CMD_NOOP(CmdSetDepthWriteEnable),
+    MOCK_CMD_NOOP(CmdSetDepthWriteEnableEXT),
+    MOCK_CMD_NOOP(CmdSetDepthCompareOp),
+    MOCK_CMD_NOOP(CmdSetDepthCompareOpEXT),
+    MOCK_CMD_NOOP(CmdSetViewportWithCount),
+    MOCK_CMD_NOOP(CmdSetViewportWithCountEXT),
+    MOCK_CMD_NOOP(CmdSetScissorWithCount),
+    MOCK_CMD_NOOP(CmdSetScissorWithCountEXT),
+};
+
+#undef MOCK_INSTANCE_PROC
+#undef MOCK_DEVICE_PROC
+#undef MOCK_CMD_NOOP
+
+const MockProc* find_mock_proc(const char* pName) {
+    for (const MockProc& proc : g_mock_procs) {
+        if (strcmp(proc.name, pName) == 0) return &proc;
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+PFN_vkVoidFunction VKAPI_CALL mock_icd_get_instance_proc_addr(VkInstance, const char* pName) {
+    if (strcmp(pName, "vkGetInstanceProcAddr") == 0) return (PFN_vkVoidFunction)mock_icd_get_instance_proc_addr;
+    if (strcmp(pName, "vkGetDeviceProcAddr") == 0) return (PFN_vkVoidFunction)mock_icd_get_device_proc_addr;
+    const MockProc* proc = find_mock_proc(pName);
+    return proc ? proc->pfn : nullptr;
+}
+
+PFN_vkVoidFunction VKAPI_CALL mock_icd_get_device_proc_addr(VkDevice, const char* pName) {
+    if (strcmp(pName, "vkGetDeviceProcAddr") == 0) return (PFN_vkVoidFunction)mock_icd_get_device_proc_addr;
+    const MockProc* proc = find_mock_proc(pName);
+    return (proc && proc->device_level) ? proc->pfn : nullptr;
+}
+
+uint64_t mock_icd_call_count() {
+    return g_call_count;
+}
+
+MockMemoryCall mock_icd_last_memory_call() {
+    return g_last_memory_call;
+}
+
+uint64_t mock_icd_live_memory_count() {
+    return g_live_memory_count;
+}
+
+void mock_icd_set_image_memory_requirements(const VkMemoryRequirements& requirements) {
+    g_image_memory_requirements = requirements;
+}
+
+void mock_icd_set_min_memory_map_alignment(size_t alignment) {
+    g_min_memory_map_alignment = alignment;
+}
+
+// --- MockLoader ---
+
+bool MockLoader::init() {
+    // debug.my_layer_package 가 비어 있으면 레이어가 pass-through 이므로, main 에서 따로 정하지 않았으면
+    // mock 위의 프로세스를 대상으로 합니다.
+    setenv("DEBUG_MY_LAYER_PACKAGE", "*", 0);
+
+    VkNegotiateLayerInterface negotiate = {};
+    negotiate.sType = LAYER_NEGOTIATE_INTERFACE_STRUCT;
+    negotiate.loaderLayerInterfaceVersion = CURRENT_LOADER_LAYER_INTERFACE_VERSION;
+    if (vkNegotiateLoaderLayerInterfaceVersion(&negotiate) != VK_SUCCESS) return false;
+
+    layer_get_instance_proc_addr = negotiate.pfnGetInstanceProcAddr;
+    layer_get_device_proc_addr = negotiate.pfnGetDeviceProcAddr;
+    return layer_get_instance_proc_addr && layer_get_device_proc_addr;
+}
+
+VkResult MockLoader::create_instance(VkInstance* pInstance) {
+    VkLayerInstanceLink link = {};
+    link.pfnNextGetInstanceProcAddr = mock_icd_get_instance_proc_addr;
+
+    VkLayerInstanceCreateInfo layer_info = {};
+    layer_info.sType = VK_STRUCTURE_TYPE_LOADER_INSTANCE_CREATE_INFO;
+    layer_info.function = VK_LAYER_LINK_INFO;
+    layer_info.u.pLayerInfo = &link;
+
+    VkApplicationInfo app_info = {};
+    app_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    app_info.pApplicationName = "layer_bench";
+    app_info.apiVersion = VK_API_VERSION_1_3;
+
+    VkInstanceCreateInfo create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    create_info.pNext = &layer_info;
+    create_info.pApplicationInfo = &app_info;
+
+    auto create_instance = (PFN_vkCreateInstance)layer_get_instance_proc_addr(VK_NULL_HANDLE, "vkCreateInstance");
+    return create_instance(&create_info, nullptr, pInstance);
+}
+
+void MockLoader::destroy_instance(VkInstance instance) {
+    auto destroy_instance = (PFN_vkDestroyInstance)layer_get_instance_proc_addr(instance, "vkDestroyInstance");
+    destroy_instance(instance, nullptr);
+}
+
+VkPhysicalDevice MockLoader::get_physical_device(VkInstance instance) {
+    auto enumerate = (PFN_vkEnumeratePhysicalDevices)
+        layer_get_instance_proc_addr(instance, "vkEnumeratePhysicalDevices");
+    uint32_t count = 1;
+    VkPhysicalDevice physical_device = VK_NULL_HANDLE;
+    enumerate(instance, &count, &physical_device);
+    return physical_device;
+}
+
+VkResult MockLoader::create_device(VkPhysicalDevice physicalDevice, VkDevice* pDevice,
+                                   const VkDeviceCreateInfo* pCreateInfo) {
+    // VkInstance 는 physicalDevice 와 같은 dispatch key 를 갖는 아무 핸들이면 됩니다.
+    VkInstance instance = reinterpret_cast<VkInstance>(physicalDevice);
+
+    VkLayerDeviceLink link = {};
+    link.pfnNextGetInstanceProcAddr = mock_icd_get_instance_proc_addr;
+    link.pfnNextGetDeviceProcAddr = mock_icd_get_device_proc_addr;
+
+    VkLayerDeviceCreateInfo layer_info = {};
+    layer_info.sType = VK_STRUCTURE_TYPE_LOADER_DEVICE_CREATE_INFO;
+    layer_info.function = VK_LAYER_LINK_INFO;
+    layer_info.u.pLayerInfo = &link;
+
+    float priority = 1.0f;
+    VkDeviceQueueCreateInfo queue_info = {};
+    queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queue_info.queueCount = 1;
+    queue_info.pQueuePriorities = &priority;
+
+    VkDeviceCreateInfo create_info = {};
+    if (pCreateInfo) {
+        create_info = *pCreateInfo;
+    } else {
+        create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        create_info.queueCreateInfoCount = 1;
+        create_info.pQueueCreateInfos = &queue_info;
+    }
+
+    // 로더처럼 앱의 pNext 체인 맨 앞에 link info 를 끼워 넣습니다.
+    layer_info.pNext = create_info.pNext;
+    create_info.pNext = &layer_info;
+
+    auto create_device = (PFN_vkCreateDevice)layer_get_instance_proc_addr(instance, "vkCreateDevice");
+    return create_device(physicalDevice, &create_info, nullptr, pDevice);
+}
+
+void MockLoader::destroy_device(VkDevice device) {
+    auto destroy_device = (PFN_vkDestroyDevice)layer_get_device_proc_addr(device, "vkDestroyDevice");
+    destroy_device(device, nullptr);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vulkan/vk_layer.h>
+
+#include <cstdint>
+
+// 벤치마크 / 테스트용 in-process "다음 레이어/ICD".
+// GPU 없이 vkNegotiateLoaderLayerInterfaceVersion -> vkCreateInstance -> vkCreateDevice 체인을
+// 레이어에 그대로 태울 수 있도록, 로더가 하는 일 (인터페이스 협상, VK_LAYER_LINK_INFO 체인 구성)
+// 과 드라이버가 하는 일 (핸들 생성, 아무 일도 하지 않는 명령들) 을 흉내 냅니다.
+//
+// 디스패치 가능한 핸들은 로더와 마찬가지로 첫 번째 포인터가 dispatch key 입니다.
+// VkPhysicalDevice 는 VkInstance 와, VkQueue / VkCommandBuffer 는 VkDevice 와 같은 key 를 갖습니다.
+
+PFN_vkVoidFunction VKAPI_CALL mock_icd_get_instance_proc_addr(VkInstance instance, const char* pName);
+PFN_vkVoidFunction VKAPI_CALL mock_icd_get_device_proc_addr(VkDevice device, const char* pName);
+
+// mock ICD 명령이 호출된 총 횟수. 레이어가 호출을 걸러내는지 확인할 때 사용합니다.
+uint64_t mock_icd_call_count();
+
+// 드라이버가 마지막으로 받은 메모리 인자. vkBind*Memory(2), vkMapMemory, vkFlush/InvalidateMappedMemoryRanges
+// 가 기록합니다. (range 가 여러 개면 마지막 것) bind 는 size 가 0 입니다.
+struct MockMemoryCall {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+};
+MockMemoryCall mock_icd_last_memory_call();
+
+// 드라이버에 살아 있는 VkDeviceMemory 수
+uint64_t mock_icd_live_memory_count();
+
+// vkGetImageMemoryRequirements 가 돌려줄 값 (기본 64 KiB, alignment 4 KiB, type 0)
+void mock_icd_set_image_memory_requirements(const VkMemoryRequirements& requirements);
+
+// VkPhysicalDeviceLimits::minMemoryMapAlignment (기본 64). vkMapMemory 주소도 이 값에 맞습니다.
+void mock_icd_set_min_memory_map_alignment(size_t alignment);
+
+class MockLoader {
+public:
+    // 레이어와 인터페이스 버전을 협상하고 레이어의 vkGet*ProcAddr 를 얻습니다.
+    bool init();
+
+    VkResult create_instance(VkInstance* pInstance);
+    void destroy_instance(VkInstance instance);
+
+    VkPhysicalDevice get_physical_device(VkInstance instance);
+
+    // pCreateInfo 가 nullptr 이면 큐 1개짜리 기본 디바이스를 만듭니다.
+    VkResult create_device(VkPhysicalDevice physicalDevice, VkDevice* pDevice,
+                           const VkDeviceCreateInfo* pCreateInfo = nullptr);
+    void destroy_device(VkDevice device);
+
+    PFN_vkGetInstanceProcAddr layer_get_instance_proc_addr = nullptr;
+    PFN_vkGetDeviceProcAddr layer_get_device_proc_addr = nullptr;
+};
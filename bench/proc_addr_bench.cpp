@@ -0,0 +1,63 @@
+// vkGet*ProcAddr 이름 해석 마이크로벤치마크.
+// 이전 구현과 같은 strcmp 체인과 컴파일 타임 perfect hash (kProcHashTable) 를
+// 레이어가 아는 전체 명령 목록 + 모르는 확장 명령에 대해 비교합니다.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "proc_table.h"
+
+// 명령이 추가될 때마다 늘어나던 기존 방식의 strcmp 체인.
+__attribute__((noinline)) static int find_proc_index_strcmp(const char* name) {
+    for (size_t i = 0; i < kProcCount; ++i) {
+        if (strcmp(name, kProcInfos[i].name.data()) == 0) return (int)i;
+    }
+    return -1;
+}
+
+__attribute__((noinline)) static int find_proc_index_hash(const char* name) {
+    return find_proc_index(name);
+}
+
+int main() {
+    // 포인터 비교로 빠져나가지 않도록 이름은 별도 버퍼에 복사해서 사용합니다.
+    std::vector<std::string> names;
+    for (const ProcInfo& info : kProcInfos) names.emplace_back(info.name);
+    const char* unknown_names[] = {
+        "vkCmdDrawMeshTasksEXT", "vkCreateRayTracingPipelinesKHR", "vkGetMemoryFdKHR",
+        "vkCmdSetColorWriteEnableEXT", "vkSetHdrMetadataEXT", "vkNotACommand",
+    };
+    for (const char* name : unknown_names) names.emplace_back(name);
+
+    for (size_t i = 0; i < names.size(); ++i) {
+        int expected = i < kProcCount ? (int)i : -1;
+        if (find_proc_index_strcmp(names[i].c_str()) != expected ||
+            find_proc_index_hash(names[i].c_str()) != expected) {
+            fprintf(stderr, "lookup mismatch: %s\n", names[i].c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("ProcAddr name resolution (%zu known + %zu unknown names)\n",
+           (size_t)kProcCount, names.size() - kProcCount);
+
+    double strcmp_ns = bench_run("strcmp chain", [&] {
+        int sum = 0;
+        for (const std::string& name : names) sum += find_proc_index_strcmp(name.c_str());
+        bench_do_not_optimize(sum);
+        return names.size();
+    });
+    double hash_ns = bench_run("perfect hash", [&] {
+        int sum = 0;
+        for (const std::string& name : names) sum += find_proc_index_hash(name.c_str());
+        bench_do_not_optimize(sum);
+        return names.size();
+    });
+
+    printf("speedup: %.1fx\n", strcmp_ns / hash_ns);
+    return hash_ns < strcmp_ns ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,429 @@
+#include "api_trace.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "clock.h"
+#include "proc_table.h"
+#include "settings.h"
+#include "utils.h"
+
+std::atomic<bool> g_api_trace_capturing{false};
+std::atomic<uint32_t> g_api_trace_frame{0};
+
+namespace {
+
+constexpr uint32_t kRingWords = 32768;  // 스레드당 256 KiB, 2의 거듭제곱
+constexpr uint32_t kSegmentBytes = 4u << 20;
+constexpr auto kFlushInterval = std::chrono::milliseconds(10);
+
+static_assert(kSegmentBytes % 4096 == 0 && kApiTraceHeaderBytes % 4096 == 0);
+static_assert(kRingWords * sizeof(uint64_t) + sizeof(ApiTraceChunkHeader) <= kSegmentBytes);
+
+std::atomic<bool> g_enabled{false};
+
+// 스레드 하나가 쓰고 flush 스레드 하나가 읽는 SPSC ring. (log.cpp 의 LogRing 과 같은 구조)
+// 이벤트는 word 단위로 이어 쓰고 끝에서 감아 돕니다.
+struct TraceRing {
+    std::atomic<uint64_t> head{0};     // producer 만 씀 (word index)
+    std::atomic<uint64_t> tail{0};     // consumer 만 씀
+    std::atomic<uint64_t> dropped{0};  // producer 만 씀
+    std::atomic<bool> retired{false};
+    uint32_t thread_id = 0;
+    uint64_t words[kRingWords];
+};
+
+class ApiTracer {
+public:
+    ~ApiTracer() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wakeup.notify_all();
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+    bool open(uint32_t first_frame, uint32_t last_frame, uint64_t max_bytes) {
+        const std::string& package = get_app_package_name();
+        std::string dir = layer_settings().trace_dir;
+        if (dir.empty()) dir = platform_get_cache_dir(package);
+        if (dir.empty()) {
+            ALOGW("trace: no directory to write the trace file in");
+            return false;
+        }
+
+        m_path = dir + "/trace_" + to_file_name_part(package) + "_" + std::to_string(getpid()) + ".bin";
+        m_fd = ::open(m_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (m_fd < 0) {
+            ALOGW("trace: can't open %s (errno %d)", m_path.c_str(), errno);
+            return false;
+        }
+        if (ftruncate(m_fd, kApiTraceHeaderBytes) != 0) {
+            ALOGW("trace: can't resize %s (errno %d)", m_path.c_str(), errno);
+            close(m_fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, kApiTraceHeaderBytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (mapped == MAP_FAILED) {
+            ALOGW("trace: can't map %s (errno %d)", m_path.c_str(), errno);
+            close(m_fd);
+            return false;
+        }
+        m_max_bytes = std::max<uint64_t>(max_bytes, kApiTraceHeaderBytes + kSegmentBytes);
+
+        // ftruncate 로 늘린 영역은 0 이므로 atomic 들도 0 으로 시작합니다.
+        m_header = new (mapped) ApiTraceFileHeader;
+        m_header->version = kApiTraceVersion;
+        m_header->header_size = kApiTraceHeaderBytes;
+        m_header->segment_size = kSegmentBytes;
+        m_header->event_header_size = sizeof(ApiTraceEvent);
+        m_header->command_count = (uint32_t)kProcCount;
+        m_header->pid = (int32_t)getpid();
+        m_header->start_ns = monotonic_now_ns();
+        m_header->data_end.store(kApiTraceHeaderBytes, std::memory_order_relaxed);
+        m_header->first_frame = first_frame;
+        m_header->last_frame = last_frame;
+        strncpy(m_header->package, package.c_str(), kApiTracePackageBytes - 1);
+        if (!kApiTraceIsHandle<VkBuffer>) {
+            m_header->flags.store(kApiTraceUntypedHandles, std::memory_order_relaxed);
+            ALOGW("trace: 32-bit build, non-dispatchable handles are recorded as values (no object lifetimes)");
+        }
+        write_command_names();
+        m_header->magic.store(kApiTraceMagic, std::memory_order_release);
+
+        if (first_frame != 0 || last_frame != 0) {
+            ALOGI("trace: writing %s (frames %u-%u, max %" PRIu64 " MiB)", m_path.c_str(), first_frame, last_frame,
+                  m_max_bytes >> 20);
+        } else {
+            ALOGI("trace: writing %s (all frames, max %" PRIu64 " MiB)", m_path.c_str(), m_max_bytes >> 20);
+        }
+        return true;
+    }
+
+    TraceRing* register_ring() {
+        auto ring = std::make_unique<TraceRing>();
+        ring->thread_id = (uint32_t)syscall(SYS_gettid);
+        TraceRing* raw = ring.get();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rings.push_back(std::move(ring));
+        if (!m_thread.joinable()) m_thread = std::thread(&ApiTracer::flush_loop, this);
+        return raw;
+    }
+
+    void flush(uint32_t timeout_ms) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_thread.joinable()) return;
+        uint64_t target = ++m_flush_requested;
+        m_wakeup.notify_all();
+        m_flushed.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                           [&] { return m_flush_completed >= target; });
+    }
+
+    // 프레임 구간이 끝났습니다. 다음 flush 에서 남은 이벤트를 쓰고 파일을 마무리합니다.
+    void request_finish() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_finish_requested = true;
+        }
+        m_wakeup.notify_all();
+    }
+
+private:
+    // 다음 segment 를 만들어 map 합니다. 크기 제한에 걸리면 false.
+    bool next_segment() {
+        if (m_segment) {
+            munmap(m_segment, kSegmentBytes);
+            m_segment = nullptr;
+            m_segment_offset += kSegmentBytes;
+        }
+        if (m_segment_offset + kSegmentBytes > m_max_bytes) return false;
+        if (ftruncate(m_fd, (off_t)(m_segment_offset + kSegmentBytes)) != 0) {
+            ALOGW("trace: can't grow %s (errno %d)", m_path.c_str(), errno);
+            return false;
+        }
+        void* mapped = mmap(nullptr, kSegmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, (off_t)m_segment_offset);
+        if (mapped == MAP_FAILED) {
+            ALOGW("trace: can't map %s (errno %d)", m_path.c_str(), errno);
+            return false;
+        }
+        m_segment = static_cast<uint8_t*>(mapped);
+        m_segment_used = 0;
+        return true;
+    }
+
+    // 현재 segment 에 chunk 를 시작합니다. 페이로드를 최소 min_payload 바이트 쓸 수 없으면 다음 segment 로
+    // 넘어갑니다. 돌려준 chunk 헤더의 size 는 호출한 쪽이 채웁니다.
+    ApiTraceChunkHeader* begin_chunk(uint16_t type, uint32_t thread_id, size_t min_payload) {
+        size_t needed = sizeof(ApiTraceChunkHeader) + min_payload;
+        if (!m_segment || m_segment_used + needed > kSegmentBytes) {
+            if (!next_segment()) return nullptr;
+        }
+        auto* chunk = reinterpret_cast<ApiTraceChunkHeader*>(m_segment + m_segment_used);
+        chunk->magic = kApiTraceChunkMagic;
+        chunk->type = type;
+        chunk->thread_id = thread_id;
+        chunk->size = 0;
+        chunk->sequence = m_sequence++;
+        m_segment_used += sizeof(ApiTraceChunkHeader);
+        return chunk;
+    }
+
+    size_t segment_space() const { return m_segment ? kSegmentBytes - m_segment_used : 0; }
+
+    void write_command_names() {
+        size_t bytes = 0;
+        for (const ProcInfo& info : kProcInfos) bytes += info.name.size() + 1;
+        size_t padded = (bytes + 7) & ~(size_t)7;
+
+        ApiTraceChunkHeader* chunk = begin_chunk(kApiTraceChunkCommands, 0, padded);
+        if (!chunk) return;
+        char* out = reinterpret_cast<char*>(m_segment + m_segment_used);
+        for (const ProcInfo& info : kProcInfos) {
+            memcpy(out, info.name.data(), info.name.size());
+            out[info.name.size()] = '\0';
+            out += info.name.size() + 1;
+        }
+        chunk->size = (uint32_t)padded;
+        m_segment_used += padded;
+        m_header->data_end.store(m_segment_offset + m_segment_used, std::memory_order_release);
+    }
+
+    // ring 에 쌓인 이벤트를 chunk 로 옮깁니다. 크기 제한에 걸리면 false.
+    bool drain_ring(TraceRing* ring) {
+        uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        while (tail != head) {
+            // 첫 이벤트는 항상 들어가야 하므로 그 크기만큼은 확보합니다.
+            // (ApiTraceEvent::size_words 는 첫 word 의 하위 16 bit)
+            uint32_t first_words = (uint32_t)(ring->words[tail & (kRingWords - 1)] & 0xffff);
+            ApiTraceChunkHeader* chunk = begin_chunk(kApiTraceChunkEvents, ring->thread_id,
+                                                     first_words * sizeof(uint64_t));
+            if (!chunk) {
+                ring->tail.store(head, std::memory_order_release);
+                return false;
+            }
+
+            // 이벤트 경계에서만 자릅니다.
+            size_t space_words = segment_space() / sizeof(uint64_t);
+            uint64_t end = tail;
+            while (end != head) {
+                uint32_t size = (uint32_t)(ring->words[end & (kRingWords - 1)] & 0xffff);
+                if (end - tail + size > space_words) break;
+                end += size;
+            }
+
+            uint64_t* out = reinterpret_cast<uint64_t*>(m_segment + m_segment_used);
+            uint64_t count = end - tail;
+            uint32_t begin_index = (uint32_t)(tail & (kRingWords - 1));
+            uint64_t first_part = std::min<uint64_t>(count, kRingWords - begin_index);
+            memcpy(out, ring->words + begin_index, first_part * sizeof(uint64_t));
+            memcpy(out + first_part, ring->words, (count - first_part) * sizeof(uint64_t));
+
+            chunk->size = (uint32_t)(count * sizeof(uint64_t));
+            m_segment_used += count * sizeof(uint64_t);
+            tail = end;
+            ring->tail.store(tail, std::memory_order_release);
+        }
+        return true;
+    }
+
+    // 남은 이벤트를 쓴 뒤 파일을 잘라내고 닫습니다. 이후 이벤트는 버립니다.
+    void finish_file() {
+        if (m_finished) return;
+        m_finished = true;
+        g_api_trace_capturing.store(false, std::memory_order_relaxed);
+
+        uint64_t data_end = m_segment_offset + m_segment_used;
+        if (m_segment) munmap(m_segment, kSegmentBytes);
+        m_segment = nullptr;
+        if (ftruncate(m_fd, (off_t)data_end) != 0) ALOGW("trace: can't truncate %s (errno %d)", m_path.c_str(), errno);
+        m_header->data_end.store(data_end, std::memory_order_release);
+        m_header->flags.fetch_or(kApiTraceComplete, std::memory_order_release);
+        munmap(m_header, kApiTraceHeaderBytes);
+        m_header = nullptr;
+        close(m_fd);
+        m_fd = -1;
+
+        ALOGI("trace: finished %s (%" PRIu64 " KiB, %" PRIu64 " events dropped)", m_path.c_str(), data_end >> 10,
+              m_dropped);
+    }
+
+    void flush_loop() {
+        std::vector<TraceRing*> rings;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_wakeup.wait_for(lock, kFlushInterval, [&] {
+                return m_stopping || m_finish_requested || m_flush_requested > m_flush_completed;
+            });
+            bool stopping = m_stopping;
+            bool finish = m_finish_requested || stopping;
+            uint64_t flush_target = m_flush_requested;
+
+            rings.clear();
+            for (const auto& ring : m_rings) rings.push_back(ring.get());
+            lock.unlock();
+
+            uint64_t dropped = m_retired_dropped;
+            for (TraceRing* ring : rings) {
+                if (m_finished) {
+                    ring->tail.store(ring->head.load(std::memory_order_acquire), std::memory_order_release);
+                } else if (!drain_ring(ring)) {
+                    ALOGW("trace: %s reached debug.my_layer.trace_max_mb, stopping capture", m_path.c_str());
+                    finish = true;
+                }
+                dropped += ring->dropped.load(std::memory_order_relaxed);
+            }
+            m_dropped = dropped;
+
+            if (!m_finished) {
+                m_header->dropped_events.store(dropped, std::memory_order_relaxed);
+                m_header->data_end.store(m_segment_offset + m_segment_used, std::memory_order_release);
+                if (finish) finish_file();
+            }
+
+            lock.lock();
+            // 종료된 스레드의 ring 은 비워진 뒤 해제합니다.
+            m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), [&](const std::unique_ptr<TraceRing>& ring) {
+                bool done = ring->retired.load(std::memory_order_acquire) &&
+                            ring->tail.load(std::memory_order_relaxed) == ring->head.load(std::memory_order_acquire);
+                if (done) m_retired_dropped += ring->dropped.load(std::memory_order_relaxed);
+                return done;
+            }), m_rings.end());
+
+            if (flush_target > m_flush_completed) {
+                m_flush_completed = flush_target;
+                m_flushed.notify_all();
+            }
+            if (stopping) break;
+        }
+    }
+
+    std::mutex m_mutex;  // rings, flush / finish 요청
+    std::condition_variable m_wakeup;
+    std::condition_variable m_flushed;
+    std::thread m_thread;
+    bool m_stopping = false;
+    bool m_finish_requested = false;
+    uint64_t m_flush_requested = 0;
+    uint64_t m_flush_completed = 0;
+    uint64_t m_retired_dropped = 0;
+    std::vector<std::unique_ptr<TraceRing>> m_rings;
+
+    // 파일. open() 이후에는 flush 스레드만 만집니다.
+    std::string m_path;
+    int m_fd = -1;
+    ApiTraceFileHeader* m_header = nullptr;
+    uint8_t* m_segment = nullptr;
+    uint64_t m_segment_offset = kApiTraceHeaderBytes;  // 현재 segment 의 파일 offset
+    uint64_t m_segment_used = 0;
+    uint64_t m_max_bytes = 0;
+    uint64_t m_sequence = 0;
+    uint64_t m_dropped = 0;
+    bool m_finished = false;
+};
+
+ApiTracer& get_tracer() {
+    static ApiTracer tracer;
+    return tracer;
+}
+
+uint32_t g_first_frame = 0;
+uint32_t g_last_frame = 0;  // 0 이면 끝까지
+
+// 스레드가 처음 기록할 때 ring 을 등록하고, 스레드가 끝나면 retired 로 표시합니다.
+struct ThreadTraceRing {
+    TraceRing* ring = nullptr;
+    ~ThreadTraceRing() {
+        if (ring) ring->retired.store(true, std::memory_order_release);
+    }
+};
+
+thread_local ThreadTraceRing t_trace_ring;
+
+// "300-600", "300-", "300" (300 부터 끝까지)
+void parse_frame_range(const std::string& value, uint32_t* first, uint32_t* last) {
+    *first = 0;
+    *last = 0;
+    if (value.empty()) return;
+    char* end = nullptr;
+    *first = (uint32_t)strtoul(value.c_str(), &end, 10);
+    if (end && *end == '-') *last = (uint32_t)strtoul(end + 1, nullptr, 10);
+    if (*last != 0 && *last <= *first) {
+        ALOGW("trace: invalid debug.my_layer.trace_frames \"%s\", capturing all frames", value.c_str());
+        *first = 0;
+        *last = 0;
+    }
+}
+
+}  // namespace
+
+void api_trace_init() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        const LayerSettings& settings = layer_settings();
+        if (!settings.trace) return;
+        parse_frame_range(settings.trace_frames, &g_first_frame, &g_last_frame);
+        uint64_t max_bytes = settings.trace_max_mb << 20;
+        if (!get_tracer().open(g_first_frame, g_last_frame, max_bytes)) return;
+        g_api_trace_capturing.store(g_first_frame == 0, std::memory_order_relaxed);
+        g_enabled.store(true, std::memory_order_release);
+    });
+}
+
+bool api_trace_enabled() {
+    return g_enabled.load(std::memory_order_acquire);
+}
+
+void api_trace_flush() {
+    if (api_trace_enabled()) get_tracer().flush(100);
+}
+
+void api_trace_on_present() {
+    uint32_t frame = g_api_trace_frame.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (frame == g_first_frame) {
+        ALOGI("trace: capture started at frame %u", frame);
+        g_api_trace_capturing.store(true, std::memory_order_relaxed);
+    }
+    if (frame == g_last_frame) {
+        ALOGI("trace: capture ended at frame %u", frame);
+        g_api_trace_capturing.store(false, std::memory_order_relaxed);
+        get_tracer().request_finish();
+    }
+}
+
+void api_trace_write(const uint64_t* words, uint32_t word_count) {
+    TraceRing* ring = t_trace_ring.ring;
+    if (!ring) ring = t_trace_ring.ring = get_tracer().register_ring();
+
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    uint64_t tail = ring->tail.load(std::memory_order_acquire);
+    if (kRingWords - (head - tail) < word_count) {
+        ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+
+    uint32_t begin_index = (uint32_t)(head & (kRingWords - 1));
+    uint32_t first_part = std::min(word_count, kRingWords - begin_index);
+    memcpy(ring->words + begin_index, words, first_part * sizeof(uint64_t));
+    memcpy(ring->words, words + first_part, (word_count - first_part) * sizeof(uint64_t));
+    ring->head.store(head + word_count, std::memory_order_release);
+}
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#include "api_trace_format.h"
+
+// 바이너리 API 트레이스 캡처 (opt-in).
+//
+// 켜져 있으면 vkGetDeviceProcAddr 가 레이어가 아는 모든 디바이스 명령에 대해 트레이스 thunk 를
+// 돌려줍니다. thunk 는 훅 (없으면 다음 체인) 을 부른 뒤 명령 id, 시각, 걸린 시간, 반환 값과 인자를
+// 스레드별 버퍼에 씁니다. 인자는 구조체를 깊게 따라가지 않고 값 / 핸들 / 배열 / sType 만 기록합니다
+// (api_trace_format.h 의 ApiTraceArgKind). 버퍼는 백그라운드 스레드가 주기적으로 mmap 한 파일에
+// chunk 로 옮기므로 호출 스레드는 시스템 콜이나 lock 없이 기록만 합니다. 버퍼가 가득 차면 이벤트를
+// 버리고 개수를 헤더에 남깁니다.
+//
+// 프레임은 vkQueuePresentKHR 로 셉니다. trace_frames 로 구간을 주면 그 사이에만 기록하고, 구간이
+// 끝나면 파일을 마무리합니다. 레이어 내부에서 다음 체인으로 부르는 호출은 기록되지 않습니다.
+//
+// 파일: <trace_dir>/trace_<패키지>_<pid>.bin
+//
+// 설정:
+//   debug.my_layer.trace          1 이면 켬 (기본 0). 디바이스를 만들기 전에 설정해야 합니다.
+//   debug.my_layer.trace_dir      파일 디렉터리 (기본 platform_get_cache_dir())
+//   debug.my_layer.trace_frames   "<시작>-<끝>" 프레임 구간, 끝은 제외 ("300-600", "300-") (기본 전체)
+//   debug.my_layer.trace_max_mb   파일이 이 크기를 넘으면 캡처를 멈춤 (기본 1024)
+
+// vkCreateDevice 에서 호출합니다. 처음 한 번만 설정을 읽고 파일을 만듭니다.
+void api_trace_init();
+
+// 설정이 켜져 있고 파일을 만들었으면 true. 이후로는 바뀌지 않습니다.
+bool api_trace_enabled();
+
+// kProcInfos 인덱스의 트레이스 thunk. 디바이스 명령이 아니면 nullptr.
+PFN_vkVoidFunction api_trace_thunk(int proc_index);
+
+// 남은 스레드 버퍼를 파일로 옮기고 기다립니다. (vkDestroyDevice)
+void api_trace_flush();
+
+extern std::atomic<bool> g_api_trace_capturing;
+extern std::atomic<uint32_t> g_api_trace_frame;
+
+// 지금 프레임이 캡처 구간 안이면 true. thunk 마다 부르므로 relaxed load 하나입니다.
+inline bool api_trace_capturing() {
+    return g_api_trace_capturing.load(std::memory_order_relaxed);
+}
+
+// vkQueuePresentKHR thunk 가 호출이 끝난 뒤 부릅니다. 프레임 구간의 시작 / 끝을 처리합니다.
+void api_trace_on_present();
+
+// 완성된 이벤트를 호출 스레드의 버퍼에 넣습니다.
+void api_trace_write(const uint64_t* words, uint32_t word_count);
+
+// --- 인자 인코딩 ---
+
+template <typename T, typename = void>
+struct ApiTraceIsComplete : std::false_type {};
+template <typename T>
+struct ApiTraceIsComplete<T, std::void_t<decltype(sizeof(T))>> : std::true_type {};
+
+// 핸들은 불완전 타입 (VkXxx_T) 에 대한 포인터입니다. 32-bit 에서 non-dispatchable 핸들은 uint64_t
+// 이므로 Uint 로 기록되고, 파일 헤더에 kApiTraceUntypedHandles 를 켭니다. (디코더가 lifetime 을 거부)
+template <typename T>
+inline constexpr bool kApiTraceIsHandle =
+    std::is_pointer_v<T> && std::is_class_v<std::remove_pointer_t<T>> &&
+    !ApiTraceIsComplete<std::remove_pointer_t<T>>::value;
+
+// const char* 는 문자열이므로 값 배열로 보지 않습니다.
+template <typename T>
+inline constexpr bool kApiTraceIsValue =
+    std::is_enum_v<T> || (std::is_integral_v<T> && !std::is_same_v<T, char>);
+
+template <typename T>
+inline uint64_t api_trace_handle_bits(T handle) {
+    if constexpr (std::is_pointer_v<T>) return (uint64_t)(uintptr_t)handle;
+    else return (uint64_t)handle;
+}
+
+// 생성 정보 구조체의 부모 객체. 디코더의 lifetime 그래프에서 부모가 파괴되면 자식도 같이 파괴된 것으로
+// 봅니다. (command pool / descriptor pool) 나머지는 의존 관계만 표시합니다.
+template <typename T>
+inline uint64_t api_trace_struct_parent(const T*) { return 0; }
+inline uint64_t api_trace_struct_parent(const VkCommandBufferAllocateInfo* info) {
+    return api_trace_handle_bits(info->commandPool);
+}
+inline uint64_t api_trace_struct_parent(const VkDescriptorSetAllocateInfo* info) {
+    return api_trace_handle_bits(info->descriptorPool);
+}
+inline uint64_t api_trace_struct_parent(const VkImageViewCreateInfo* info) {
+    return api_trace_handle_bits(info->image);
+}
+inline uint64_t api_trace_struct_parent(const VkBufferViewCreateInfo* info) {
+    return api_trace_handle_bits(info->buffer);
+}
+inline uint64_t api_trace_struct_parent(const VkSwapchainCreateInfoKHR* info) {
+    return api_trace_handle_bits(info->surface);
+}
+
+// 생성 정보 구조체 뒤에 오는 출력 핸들 배열의 개수. 기본은 바로 앞의 개수 인자 (createInfoCount) 입니다.
+template <typename T>
+inline uint64_t api_trace_struct_output_count(const T*, uint64_t count) { return count; }
+inline uint64_t api_trace_struct_output_count(const VkCommandBufferAllocateInfo* info, uint64_t) {
+    return info->commandBufferCount;
+}
+inline uint64_t api_trace_struct_output_count(const VkDescriptorSetAllocateInfo* info, uint64_t) {
+    return info->descriptorSetCount;
+}
+
+// 이벤트 하나를 스택 버퍼에 만듭니다. 인자는 호출이 끝난 뒤 순서대로 add() 합니다.
+// 배열 개수는 바로 앞의 정수 인자를 씁니다 (bindingCount, pBuffers, pOffsets 처럼 배열이 이어지면 같은 개수).
+// 출력 핸들 배열은 앞의 생성 정보 구조체나 uint32_t* 출력 값이 정한 개수를 씁니다.
+class ApiTraceEncoder {
+public:
+    static constexpr uint32_t kMaxWords =
+        kApiTraceEventWords + kApiTraceMaxArgs * (2 + kApiTraceMaxArrayElements);
+
+    template <typename T>
+    void add(T value) {
+        using U = std::remove_cv_t<T>;
+        if constexpr (std::is_enum_v<U> || std::is_integral_v<U>) {
+            uint64_t bits;
+            if constexpr (std::is_enum_v<U>) bits = (uint64_t)(std::underlying_type_t<U>)value;
+            else bits = std::is_signed_v<U> ? (uint64_t)(int64_t)value : (uint64_t)value;
+            push(std::is_signed_v<U> ? ApiTraceArgKind::Int : ApiTraceArgKind::Uint, bits);
+            m_count = bits;
+            m_has_count = true;
+            return;
+        } else if constexpr (std::is_floating_point_v<U>) {
+            double d = (double)value;
+            uint64_t bits;
+            __builtin_memcpy(&bits, &d, sizeof(bits));
+            push(ApiTraceArgKind::Float, bits);
+        } else if constexpr (kApiTraceIsHandle<U>) {
+            push(ApiTraceArgKind::Handle, api_trace_handle_bits(value));
+        } else if constexpr (std::is_pointer_v<U>) {
+            add_pointer(value);
+            return;
+        } else {
+            push(ApiTraceArgKind::Pointer, 0);
+        }
+        m_has_count = false;
+    }
+
+    // 헤더를 채우고 전체 word 수를 돌려줍니다.
+    uint32_t finish(uint16_t command, uint64_t begin_ns, uint64_t end_ns, uint32_t frame,
+                    ApiTraceResultKind result_kind, uint64_t result) {
+        ApiTraceEvent event = {};
+        event.size_words = (uint16_t)m_size;
+        event.command = command;
+        event.arg_count = (uint8_t)m_arg_count;
+        event.result_kind = (uint8_t)result_kind;
+        event.frame = frame;
+        uint64_t duration = end_ns - begin_ns;
+        event.duration_ns = duration > UINT32_MAX ? UINT32_MAX : (uint32_t)duration;
+        event.begin_ns = begin_ns;
+        event.result = result;
+        event.arg_kinds = m_arg_kinds;
+        __builtin_memcpy(m_words, &event, sizeof(event));
+        return m_size;
+    }
+
+    const uint64_t* words() const { return m_words; }
+
+private:
+    template <typename P>
+    void add_pointer(P pointer) {
+        using Pointee = std::remove_pointer_t<P>;
+        using Element = std::remove_cv_t<Pointee>;
+        uint64_t count = m_has_count ? m_count : 1;
+        m_has_count = m_has_count && (kApiTraceIsHandle<Element> || kApiTraceIsValue<Element>);
+
+        if constexpr (kApiTraceIsHandle<Element>) {
+            if constexpr (std::is_const_v<Pointee>) {
+                push_array(ApiTraceArgKind::HandleArray, pointer, pointer ? count : 0);
+            } else {
+                uint64_t out_count = m_has_output_count ? m_output_count : 1;
+                push_array(ApiTraceArgKind::OutHandleArray, pointer, pointer ? out_count : 0);
+                m_has_count = false;
+            }
+        } else if constexpr (kApiTraceIsValue<Element>) {
+            if constexpr (std::is_const_v<Pointee>) {
+                push_array(ApiTraceArgKind::ValueArray, pointer, pointer ? count : 0);
+            } else {
+                uint64_t value = pointer ? (uint64_t)*pointer : 0;
+                push(ApiTraceArgKind::OutValue, value);
+                m_output_count = value;
+                m_has_output_count = true;
+                m_has_count = false;
+            }
+        } else if constexpr (std::is_class_v<Element> && ApiTraceIsComplete<Element>::value) {
+            if constexpr (requires { pointer->sType; }) {
+                if (m_arg_count >= kApiTraceMaxArgs) return;
+                push(ApiTraceArgKind::Struct, pointer ? (uint64_t)pointer->sType : 0);
+                m_words[m_size++] = pointer ? api_trace_struct_parent(pointer) : 0;
+                if (pointer && std::is_const_v<Pointee>) {
+                    m_output_count = api_trace_struct_output_count(pointer, count);
+                    m_has_output_count = true;
+                }
+            } else {
+                push(ApiTraceArgKind::Pointer, (uint64_t)(uintptr_t)pointer);
+            }
+            m_has_count = false;
+        } else {
+            push(ApiTraceArgKind::Pointer, (uint64_t)(uintptr_t)pointer);
+            m_has_count = false;
+        }
+    }
+
+    void push(ApiTraceArgKind kind, uint64_t word) {
+        if (m_arg_count >= kApiTraceMaxArgs) return;
+        m_arg_kinds |= (uint64_t)kind << (4 * m_arg_count);
+        m_arg_count++;
+        m_words[m_size++] = word;
+    }
+
+    template <typename P>
+    void push_array(ApiTraceArgKind kind, P pointer, uint64_t count) {
+        if (m_arg_count >= kApiTraceMaxArgs) return;
+        push(kind, count);
+        uint64_t n = count < kApiTraceMaxArrayElements ? count : kApiTraceMaxArrayElements;
+        for (uint64_t i = 0; i < n; ++i) {
+            if constexpr (kApiTraceIsHandle<std::remove_cv_t<std::remove_pointer_t<P>>>) {
+                m_words[m_size++] = api_trace_handle_bits(pointer[i]);
+            } else {
+                m_words[m_size++] = (uint64_t)pointer[i];
+            }
+        }
+    }
+
+    uint64_t m_words[kMaxWords];
+    uint32_t m_size = kApiTraceEventWords;
+    uint32_t m_arg_count = 0;
+    uint64_t m_arg_kinds = 0;
+    uint64_t m_count = 0;         // 바로 앞 정수 인자 (배열 개수 후보)
+    bool m_has_count = false;
+    uint64_t m_output_count = 0;  // 출력 핸들 배열 개수
+    bool m_has_output_count = false;
+};
+
+template <typename R, typename... Args>
+inline void api_trace_record(uint16_t command, uint64_t begin_ns, uint64_t end_ns, R result, Args... args) {
+    static_assert(sizeof...(Args) <= kApiTraceMaxArgs);
+    ApiTraceEncoder encoder;
+    (encoder.add(args), ...);
+
+    ApiTraceResultKind result_kind = ApiTraceResultKind::Uint;
+    uint64_t result_bits = 0;
+    if constexpr (std::is_same_v<R, VkResult> || std::is_signed_v<R>) {
+        result_kind = ApiTraceResultKind::Int;
+        result_bits = (uint64_t)(int64_t)result;
+    } else if constexpr (std::is_pointer_v<R>) {
+        result_bits = (uint64_t)(uintptr_t)result;
+    } else {
+        result_bits = (uint64_t)result;
+    }
+    uint32_t size = encoder.finish(command, begin_ns, end_ns, g_api_trace_frame.load(std::memory_order_relaxed),
+                                   result_kind, result_bits);
+    api_trace_write(encoder.words(), size);
+}
+
+template <typename... Args>
+inline void api_trace_record_void(uint16_t command, uint64_t begin_ns, uint64_t end_ns, Args... args) {
+    static_assert(sizeof...(Args) <= kApiTraceMaxArgs);
+    ApiTraceEncoder encoder;
+    (encoder.add(args), ...);
+    uint32_t size = encoder.finish(command, begin_ns, end_ns, g_api_trace_frame.load(std::memory_order_relaxed),
+                                   ApiTraceResultKind::Void, 0);
+    api_trace_write(encoder.words(), size);
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// 레이어와 오프라인 디코더 (tools/trace_decoder) 가 공유하는 API 트레이스 파일 레이아웃.
+// 레이어 의존성 없이 이 헤더만으로 읽을 수 있어야 합니다. 레이아웃을 바꾸면 kApiTraceVersion 을 올립니다.
+//
+// [ApiTraceFileHeader (kApiTraceHeaderBytes)][segment 0][segment 1]...
+//
+// - 파일은 segment 단위 (header.segment_size) 로 늘리고 segment 하나씩 mmap 해서 씁니다.
+//   chunk 는 segment 경계를 넘지 않으므로, segment 끝에 남은 공간은 0 으로 남고 리더는 magic 이 0 이면
+//   다음 segment 로 넘어갑니다.
+// - header.data_end 는 flush 가 끝날 때마다 갱신되는 유효한 끝 (파일 offset) 입니다. 앱이 도중에
+//   죽어도 data_end 까지는 온전합니다. kApiTraceComplete 가 켜져 있으면 캡처가 정상 종료된 것입니다.
+// - 첫 chunk 는 kApiTraceChunkCommands 로, 명령 id 순서대로 NUL 로 끝나는 이름들입니다.
+// - kApiTraceChunkEvents 는 스레드 하나의 이벤트를 시간 순서대로 담습니다. 스레드끼리의 순서는
+//   begin_ns 로 맞춥니다. (flush 주기마다 스레드별 chunk 가 하나씩 생깁니다)
+// - 시각은 CLOCK_MONOTONIC ns 입니다.
+
+constexpr uint32_t kApiTraceMagic = 0x52544c4d;       // "MLTR"
+constexpr uint32_t kApiTraceChunkMagic = 0x4b4e4843;  // "CHNK"
+constexpr uint32_t kApiTraceVersion = 2;
+constexpr uint32_t kApiTraceHeaderBytes = 4096;
+constexpr size_t kApiTracePackageBytes = 128;
+constexpr uint32_t kApiTraceMaxArgs = 16;
+constexpr uint32_t kApiTraceMaxArrayElements = 32;  // 배열 인자는 개수 전체 + 앞 32 개만 기록
+
+enum ApiTraceFileFlags : uint32_t {
+    kApiTraceComplete = 1u << 0,
+    // 32-bit 빌드의 캡처. non-dispatchable 핸들이 uint64_t 라서 VkDeviceSize 등과 구분할 수 없으므로
+    // Uint 로 기록되어 있습니다. 객체 lifetime 은 만들 수 없습니다.
+    kApiTraceUntypedHandles = 1u << 1,
+};
+
+struct ApiTraceFileHeader {
+    std::atomic<uint32_t> magic;  // 헤더를 다 쓴 뒤 마지막에 씁니다
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t segment_size;
+    uint32_t event_header_size;
+    uint32_t command_count;
+    int32_t pid;
+    std::atomic<uint32_t> flags;
+    uint64_t start_ns;
+    std::atomic<uint64_t> data_end;
+    std::atomic<uint64_t> dropped_events;  // 스레드 버퍼가 가득 차서 버린 이벤트 (누적)
+    uint32_t first_frame;                  // 캡처 구간 [first_frame, last_frame), last_frame 0 이면 끝까지
+    uint32_t last_frame;
+    char package[kApiTracePackageBytes];
+};
+
+static_assert(sizeof(ApiTraceFileHeader) <= kApiTraceHeaderBytes);
+
+enum ApiTraceChunkType : uint16_t {
+    kApiTraceChunkCommands = 1,
+    kApiTraceChunkEvents = 2,
+};
+
+struct ApiTraceChunkHeader {
+    uint32_t magic;
+    uint16_t type;
+    uint16_t reserved;
+    uint32_t thread_id;
+    uint32_t size;      // 헤더를 뺀 페이로드 바이트 (8의 배수)
+    uint64_t sequence;  // 파일 전체에서 chunk 순서
+};
+
+static_assert(sizeof(ApiTraceChunkHeader) % sizeof(uint64_t) == 0);
+
+// 인자 하나의 종류. 이벤트 헤더의 arg_kinds 에 인자마다 4 bit 씩 들어갑니다.
+enum class ApiTraceArgKind : uint8_t {
+    None = 0,
+    Int,             // 1 word, 부호 확장
+    Uint,            // 1 word (enum, flags, VkBool32 포함)
+    Float,           // 1 word, double 비트
+    Handle,          // 1 word
+    Pointer,         // 1 word, 포인터 값만 (void*, 문자열, sType 이 없는 구조체 등)
+    Struct,          // 2 words: sType (nullptr 이면 0), 부모 핸들 (command pool 등, 없으면 0)
+    HandleArray,     // 1 + n words: 개수, 핸들들
+    ValueArray,      // 1 + n words: 개수, 값들 (정수 / enum)
+    OutHandleArray,  // 1 + n words: 개수, 호출 후 채워진 핸들들 (생성된 객체)
+    OutValue,        // 1 word: 호출 후 값 (uint32_t* pCount 등)
+};
+
+// 반환 값의 종류
+enum class ApiTraceResultKind : uint8_t {
+    Void = 0,
+    Int,   // VkResult 등
+    Uint,  // VkDeviceAddress 등
+};
+
+// 이벤트 하나: [ApiTraceEvent][인자 words]. 전체 크기는 size_words (8 바이트 단위) 입니다.
+struct ApiTraceEvent {
+    uint16_t size_words;
+    uint16_t command;       // 명령 id (kApiTraceChunkCommands 의 순서)
+    uint8_t arg_count;
+    uint8_t result_kind;    // ApiTraceResultKind
+    uint16_t reserved;
+    uint32_t frame;         // 캡처 시작부터 센 vkQueuePresentKHR 수
+    uint32_t duration_ns;
+    uint64_t begin_ns;
+    uint64_t result;
+    uint64_t arg_kinds;     // 인자 i 의 ApiTraceArgKind 는 (arg_kinds >> (4 * i)) & 0xf
+};
+
+constexpr uint32_t kApiTraceEventWords = sizeof(ApiTraceEvent) / sizeof(uint64_t);
+static_assert(sizeof(ApiTraceEvent) % sizeof(uint64_t) == 0);
+
+inline ApiTraceArgKind api_trace_arg_kind(const ApiTraceEvent& event, uint32_t index) {
+    return (ApiTraceArgKind)((event.arg_kinds >> (4 * index)) & 0xf);
+}
+
+// 인자 kind 에 따른 word 수. data 는 그 인자의 첫 word 입니다.
+inline uint32_t api_trace_arg_words(ApiTraceArgKind kind, const uint64_t* data) {
+    switch (kind) {
+        case ApiTraceArgKind::None: return 0;
+        case ApiTraceArgKind::Struct: return 2;
+        case ApiTraceArgKind::HandleArray:
+        case ApiTraceArgKind::ValueArray:
+        case ApiTraceArgKind::OutHandleArray:
+            return 1 + (uint32_t)(data[0] < kApiTraceMaxArrayElements ? data[0] : kApiTraceMaxArrayElements);
+        default: return 1;
+    }
+}
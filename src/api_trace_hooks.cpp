@@ -0,0 +1,89 @@
+#include "api_trace.h"
+
+#include <array>
+
+#include "clock.h"
+#include "hooks.h"
+#include "log.h"
+#include "layer_data.h"
+#include "proc_table.h"
+
+// 트레이스 thunk. 디바이스 명령마다 하나씩 만들어 vkGetDeviceProcAddr 가 돌려줍니다.
+// 레이어가 훅하는 명령은 훅을, 아니면 디스패치 테이블의 다음 체인을 부르고, 캡처 중이면 호출이 끝난
+// 뒤 이벤트를 기록합니다.
+
+namespace {
+
+constexpr int kQueuePresentIndex = find_proc_index(std::string_view("vkQueuePresentKHR"));
+constexpr int kDestroyDeviceIndex = find_proc_index(std::string_view("vkDestroyDevice"));
+
+template <typename First, typename... Rest>
+const void* dispatchable_handle(First first, Rest...) {
+    static_assert(std::is_pointer_v<First>, "device commands take a dispatchable handle first");
+    return (const void*)first;
+}
+
+template <int Index, typename PFN>
+struct TraceThunk;
+
+template <int Index, typename R, typename... Args>
+struct TraceThunk<Index, R (VKAPI_PTR*)(Args...)> {
+    using Function = R (VKAPI_PTR*)(Args...);
+
+    static Function target(const void* dispatchable) {
+        static const PFN_vkVoidFunction hook = get_layer_hook(Index);
+        if (hook) return (Function)hook;
+        LayerDeviceData* device_data = get_device_data(dispatchable);
+        if (!device_data) return nullptr;
+        return (Function)read_dispatch_slot(device_data->dispatch, kProcInfos[Index].dispatch_offset);
+    }
+
+    static VKAPI_ATTR R VKAPI_CALL call(Args... args) {
+        Function function = target(dispatchable_handle(args...));
+        if (!function) {
+            ALOGE("trace: %s called with an unknown device", kProcInfos[Index].name.data());
+            if constexpr (std::is_void_v<R>) return;
+            else return R{};
+        }
+
+        if (!api_trace_capturing()) {
+            if constexpr (Index == kQueuePresentIndex) {
+                R result = function(args...);
+                api_trace_on_present();
+                return result;
+            } else {
+                return function(args...);
+            }
+        }
+
+        uint64_t begin_ns = monotonic_now_ns();
+        if constexpr (std::is_void_v<R>) {
+            function(args...);
+            api_trace_record_void((uint16_t)Index, begin_ns, monotonic_now_ns(), args...);
+            if constexpr (Index == kDestroyDeviceIndex) api_trace_flush();
+        } else {
+            R result = function(args...);
+            api_trace_record((uint16_t)Index, begin_ns, monotonic_now_ns(), result, args...);
+            if constexpr (Index == kQueuePresentIndex) api_trace_on_present();
+            return result;
+        }
+    }
+};
+
+const std::array<PFN_vkVoidFunction, kProcCount> g_trace_thunks = [] {
+    std::array<PFN_vkVoidFunction, kProcCount> thunks{};
+#define MY_LAYER_REGISTER_THUNK(name) { \
+        constexpr int index = find_proc_index(std::string_view("vk" #name)); \
+        thunks[index] = (PFN_vkVoidFunction)TraceThunk<index, PFN_vk##name>::call; \
+    }
+    MY_LAYER_DEVICE_COMMANDS(MY_LAYER_REGISTER_THUNK)
+#undef MY_LAYER_REGISTER_THUNK
+    return thunks;
+}();
+
+}  // namespace
+
+PFN_vkVoidFunction api_trace_thunk(int proc_index) {
+    if (proc_index < 0 || (size_t)proc_index >= kProcCount) return nullptr;
+    return g_trace_thunks[proc_index];
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "api_trace_format.h"
+
+// API 트레이스 파일 (api_trace_format.h) 을 읽는 순회. tools/trace_decoder 와 테스트가 같이 씁니다.
+// 레이어에는 들어가지 않습니다. 파일 내용은 믿지 않고, chunk / 이벤트 / 이름이 페이로드를 넘으면 거기서
+// 멈춥니다.
+
+struct TraceFile {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    const ApiTraceFileHeader* header = nullptr;
+    uint64_t data_end = 0;
+    std::vector<std::string> commands;
+};
+
+// 이벤트 하나와 인자 words 의 위치
+struct EventRef {
+    const ApiTraceEvent* event;
+    uint32_t thread_id;
+};
+
+inline bool open_trace(const char* path, TraceFile* trace) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        fprintf(stderr, "can't open %s\n", path);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < kApiTraceHeaderBytes) {
+        fprintf(stderr, "%s: too small\n", path);
+        close(fd);
+        return false;
+    }
+    void* mapped = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        fprintf(stderr, "%s: can't map\n", path);
+        return false;
+    }
+
+    trace->data = static_cast<const uint8_t*>(mapped);
+    trace->size = (size_t)st.st_size;
+    trace->header = reinterpret_cast<const ApiTraceFileHeader*>(trace->data);
+    const ApiTraceFileHeader& header = *trace->header;
+    if (header.magic.load(std::memory_order_acquire) != kApiTraceMagic || header.version != kApiTraceVersion ||
+        header.header_size != kApiTraceHeaderBytes || header.event_header_size != sizeof(ApiTraceEvent) ||
+        header.segment_size == 0) {
+        fprintf(stderr, "%s: not a trace file or unsupported version\n", path);
+        return false;
+    }
+    trace->data_end = std::min<uint64_t>(header.data_end.load(std::memory_order_acquire), trace->size);
+    return true;
+}
+
+inline void close_trace(TraceFile* trace) {
+    if (trace->data) munmap(const_cast<uint8_t*>(trace->data), trace->size);
+    *trace = TraceFile();
+}
+
+// 모든 chunk 를 돌면서 이벤트마다 callback 을 부릅니다. (스레드별 chunk 순서)
+template <typename Callback>
+void for_each_event(TraceFile* trace, Callback&& callback) {
+    const uint64_t header_size = trace->header->header_size;
+    const uint64_t segment_size = trace->header->segment_size;
+    uint64_t pos = header_size;
+    while (pos + sizeof(ApiTraceChunkHeader) <= trace->data_end) {
+        ApiTraceChunkHeader chunk;
+        memcpy(&chunk, trace->data + pos, sizeof(chunk));
+        if (chunk.magic == 0) {
+            // segment 끝의 남은 공간
+            pos = header_size + ((pos - header_size) / segment_size + 1) * segment_size;
+            continue;
+        }
+        if (chunk.magic != kApiTraceChunkMagic || pos + sizeof(chunk) + chunk.size > trace->data_end) {
+            fprintf(stderr, "corrupt chunk at offset %" PRIu64 "\n", pos);
+            return;
+        }
+
+        const uint8_t* payload = trace->data + pos + sizeof(chunk);
+        if (chunk.type == kApiTraceChunkCommands) {
+            // 마지막 이름에 NUL 이 없어도 페이로드 밖은 읽지 않습니다.
+            trace->commands.clear();
+            const char* name = reinterpret_cast<const char*>(payload);
+            const char* end = name + chunk.size;
+            while (name < end && trace->commands.size() < trace->header->command_count) {
+                size_t length = strnlen(name, (size_t)(end - name));
+                trace->commands.emplace_back(name, length);
+                name += length + 1;
+            }
+        } else if (chunk.type == kApiTraceChunkEvents) {
+            const uint64_t* words = reinterpret_cast<const uint64_t*>(payload);
+            size_t count = chunk.size / sizeof(uint64_t);
+            for (size_t i = 0; i + kApiTraceEventWords <= count;) {
+                const auto* event = reinterpret_cast<const ApiTraceEvent*>(words + i);
+                if (event->size_words < kApiTraceEventWords || i + event->size_words > count) break;
+                callback(EventRef{event, chunk.thread_id});
+                i += event->size_words;
+            }
+        }
+        pos += sizeof(chunk) + chunk.size;
+    }
+}
+
+inline const uint64_t* event_args(const ApiTraceEvent* event) {
+    return reinterpret_cast<const uint64_t*>(event) + kApiTraceEventWords;
+}
+
+// 인자 index 의 kind 와 첫 word 를 돌려주는 순회
+template <typename Callback>
+void for_each_arg(const ApiTraceEvent* event, Callback&& callback) {
+    const uint64_t* arg = event_args(event);
+    for (uint32_t i = 0; i < event->arg_count; ++i) {
+        ApiTraceArgKind kind = api_trace_arg_kind(*event, i);
+        callback(i, kind, arg);
+        arg += api_trace_arg_words(kind, arg);
+    }
+}
+
+// 배열 인자에 실제로 기록된 원소 수
+inline uint64_t array_elements(const uint64_t* arg) {
+    return std::min<uint64_t>(arg[0], kApiTraceMaxArrayElements);
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// CLOCK_MONOTONIC (vDSO) 기반 타임스탬프. 시스템 콜 없이 읽힙니다.
+inline uint64_t monotonic_now_ns() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,853 @@
+#include <vulkan/vulkan.h>
+
+#include <memory>
+#include <vector>
+
+#include "hooks.h"
+#include "layer_data.h"
+#include "utils.h"
+
+// --- 커맨드 버퍼 수명 ---
+
+// 해제된 데이터는 디바이스 풀로 돌려서 다음 vkAllocateCommandBuffers 에서 재사용합니다.
+static void release_command_buffer_data(std::unique_ptr<LayerCommandBufferData> data) {
+    LayerDeviceData* device_data = data->device_data;
+    std::lock_guard<std::mutex> lock(device_data->command_buffer_mutex);
+    device_data->free_command_buffers.push_back(std::move(data));
+}
+
+void erase_command_buffers(LayerDeviceData* device_data, VkCommandPool command_pool) {
+    std::vector<VkCommandBuffer> command_buffers;
+    g_command_buffer_data_map.for_each([&](LayerCommandBufferData* data) {
+        if (data->device_data == device_data &&
+            (command_pool == VK_NULL_HANDLE || data->command_pool == command_pool)) {
+            command_buffers.push_back(data->command_buffer);
+        }
+    });
+    for (VkCommandBuffer command_buffer : command_buffers) {
+        std::unique_ptr<LayerCommandBufferData> data = g_command_buffer_data_map.erase(command_buffer);
+        if (data) release_command_buffer_data(std::move(data));
+    }
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkAllocateCommandBuffers(
+    VkDevice device,
+    const VkCommandBufferAllocateInfo* pAllocateInfo,
+    VkCommandBuffer* pCommandBuffers)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    VkResult result = device_data->dispatch.AllocateCommandBuffers(device, pAllocateInfo, pCommandBuffers);
+    if (result != VK_SUCCESS || !device_data->track_command_buffers) return result;
+
+    for (uint32_t i = 0; i < pAllocateInfo->commandBufferCount; ++i) {
+        std::unique_ptr<LayerCommandBufferData> data;
+        {
+            std::lock_guard<std::mutex> lock(device_data->command_buffer_mutex);
+            if (!device_data->free_command_buffers.empty()) {
+                data = std::move(device_data->free_command_buffers.back());
+                device_data->free_command_buffers.pop_back();
+            }
+        }
+        if (!data) data = std::make_unique<LayerCommandBufferData>();
+
+        data->command_buffer = pCommandBuffers[i];
+        data->command_pool = pAllocateInfo->commandPool;
+        data->device_data = device_data;
+        data->stats = CommandStats();
+        g_command_buffer_data_map.insert(pCommandBuffers[i], std::move(data));
+    }
+    return result;
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkFreeCommandBuffers(
+    VkDevice device,
+    VkCommandPool commandPool,
+    uint32_t commandBufferCount,
+    const VkCommandBuffer* pCommandBuffers)
+{
+    for (uint32_t i = 0; i < commandBufferCount; ++i) {
+        if (pCommandBuffers[i] == VK_NULL_HANDLE) continue;
+        std::unique_ptr<LayerCommandBufferData> data = g_command_buffer_data_map.erase(pCommandBuffers[i]);
+        if (data) release_command_buffer_data(std::move(data));
+    }
+    get_device_data(device)->dispatch.FreeCommandBuffers(device, commandPool, commandBufferCount, pCommandBuffers);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkDestroyCommandPool(
+    VkDevice device,
+    VkCommandPool commandPool,
+    const VkAllocationCallbacks* pAllocator)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    if (commandPool != VK_NULL_HANDLE) erase_command_buffers(device_data, commandPool);
+    device_data->dispatch.DestroyCommandPool(device, commandPool, pAllocator);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkBeginCommandBuffer(
+    VkCommandBuffer commandBuffer,
+    const VkCommandBufferBeginInfo* pBeginInfo)
+{
+    LayerCommandBufferData* data = g_command_buffer_data_map.find(commandBuffer);
+    if (!data) return get_device_data(commandBuffer)->dispatch.BeginCommandBuffer(commandBuffer, pBeginInfo);
+
+    // Begin 은 이전 기록을 (암시적으로) 리셋합니다. secondary 도 시작 시점의 상태는 정의되지 않습니다.
+    if (data->device_data->command_stats_enabled) data->stats = CommandStats();
+    if (data->device_data->state_filter.enabled) data->shadow.begin(data->device_data->state_filter);
+    return data->device_data->dispatch.BeginCommandBuffer(commandBuffer, pBeginInfo);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkEndCommandBuffer(
+    VkCommandBuffer commandBuffer)
+{
+    LayerCommandBufferData* data = g_command_buffer_data_map.find(commandBuffer);
+    if (!data) return get_device_data(commandBuffer)->dispatch.EndCommandBuffer(commandBuffer);
+
+    if (data->device_data->state_filter.enabled) {
+        data->device_data->state_filter_totals.add(data->shadow.filtered);
+        data->shadow.filtered = StateFilterStats();
+    }
+    return data->device_data->dispatch.EndCommandBuffer(commandBuffer);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdExecuteCommands(
+    VkCommandBuffer commandBuffer,
+    uint32_t commandBufferCount,
+    const VkCommandBuffer* pCommandBuffers)
+{
+    LayerCommandBufferData* data = g_command_buffer_data_map.find(commandBuffer);
+    if (!data) {
+        get_device_data(commandBuffer)->dispatch.CmdExecuteCommands(commandBuffer, commandBufferCount, pCommandBuffers);
+        return;
+    }
+
+    // secondary 는 이미 기록이 끝난 상태이므로 통계를 primary 에 합칩니다.
+    for (uint32_t i = 0; data->device_data->command_stats_enabled && i < commandBufferCount; ++i) {
+        LayerCommandBufferData* secondary = g_command_buffer_data_map.find(pCommandBuffers[i]);
+        if (secondary) data->stats.add(secondary->stats);
+    }
+    data->device_data->dispatch.CmdExecuteCommands(commandBuffer, commandBufferCount, pCommandBuffers);
+    // secondary 실행 후 primary 의 상태는 정의되지 않습니다.
+    if (data->device_data->state_filter.enabled) data->shadow.reset();
+}
+
+// --- 통계를 세는 vkCmd* ---
+
+// cmd_stats 가 켜져 있으면 커맨드 버퍼의 카운터를 올리고 다음 체인의 디스패치 테이블을 돌려줍니다.
+// 커맨드 버퍼 자신의 데이터만 쓰므로 기록 스레드끼리 공유하는 쓰기가 없습니다.
+static inline const DeviceDispatchTable& count_command(
+    VkCommandBuffer commandBuffer,
+    uint64_t CommandStats::*counter)
+{
+    LayerCommandBufferData* data = g_command_buffer_data_map.find(commandBuffer);
+    if (!data) return get_device_data(commandBuffer)->dispatch;
+    if (data->device_data->command_stats_enabled) data->stats.*counter += 1;
+    return data->device_data->dispatch;
+}
+
+// 위와 같고, 상태 필터가 켜져 있으면 *shadow 에 커맨드 버퍼의 사본을 (아니면 nullptr) 돌려줍니다.
+static inline const DeviceDispatchTable& count_command(
+    VkCommandBuffer commandBuffer,
+    uint64_t CommandStats::*counter,
+    StateShadow** shadow)
+{
+    LayerCommandBufferData* data = g_command_buffer_data_map.find(commandBuffer);
+    if (!data) {
+        *shadow = nullptr;
+        return get_device_data(commandBuffer)->dispatch;
+    }
+    if (data->device_data->command_stats_enabled) data->stats.*counter += 1;
+    *shadow = data->device_data->state_filter.enabled ? &data->shadow : nullptr;
+    return data->device_data->dispatch;
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdDraw(
+    VkCommandBuffer commandBuffer,
+    uint32_t vertexCount,
+    uint32_t instanceCount,
+    uint32_t firstVertex,
+    uint32_t firstInstance)
+{
+    count_command(commandBuffer, &CommandStats::draws)
+        .CmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdDrawIndexed(
+    VkCommandBuffer commandBuffer,
+    uint32_t indexCount,
+    uint32_t instanceCount,
+    uint32_t firstIndex,
+    int32_t vertexOffset,
+    uint32_t firstInstance)
+{
+    count_command(commandBuffer, &CommandStats::draws)
+        .CmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdDrawIndirect(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    uint32_t drawCount,
+    uint32_t stride)
+{
+    count_command(commandBuffer, &CommandStats::draws)
+        .CmdDrawIndirect(commandBuffer, buffer, offset, drawCount, stride);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdDrawIndexedIndirect(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    uint32_t drawCount,
+    uint32_t stride)
+{
+    count_command(commandBuffer, &CommandStats::draws)
+        .CmdDrawIndexedIndirect(commandBuffer, buffer, offset, drawCount, stride);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdDrawIndirectCount(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    VkBuffer countBuffer,
+    VkDeviceSize countBufferOffset,
+    uint32_t maxDrawCount,
+    uint32_t stride)
+{
+    count_command(commandBuffer, &CommandStats::draws)
+        .CmdDrawIndirectCount(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdDrawIndirectCountKHR(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    VkBuffer countBuffer,
+    VkDeviceSize countBufferOffset,
+    uint32_t maxDrawCount,
+    uint32_t stride)
+{
+    count_command(commandBuffer, &CommandStats::draws)
+        .CmdDrawIndirectCountKHR(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdDrawIndexedIndirectCount(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    VkBuffer countBuffer,
+    VkDeviceSize countBufferOffset,
+    uint32_t maxDrawCount,
+    uint32_t stride)
+{
+    count_command(commandBuffer, &CommandStats::draws)
+        .CmdDrawIndexedIndirectCount(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdDrawIndexedIndirectCountKHR(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    VkBuffer countBuffer,
+    VkDeviceSize countBufferOffset,
+    uint32_t maxDrawCount,
+    uint32_t stride)
+{
+    count_command(commandBuffer, &CommandStats::draws)
+        .CmdDrawIndexedIndirectCountKHR(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdDispatch(
+    VkCommandBuffer commandBuffer,
+    uint32_t groupCountX,
+    uint32_t groupCountY,
+    uint32_t groupCountZ)
+{
+    count_command(commandBuffer, &CommandStats::dispatches)
+        .CmdDispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdDispatchBase(
+    VkCommandBuffer commandBuffer,
+    uint32_t baseGroupX,
+    uint32_t baseGroupY,
+    uint32_t baseGroupZ,
+    uint32_t groupCountX,
+    uint32_t groupCountY,
+    uint32_t groupCountZ)
+{
+    count_command(commandBuffer, &CommandStats::dispatches)
+        .CmdDispatchBase(commandBuffer, baseGroupX, baseGroupY, baseGroupZ, groupCountX, groupCountY, groupCountZ);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdDispatchIndirect(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset)
+{
+    count_command(commandBuffer, &CommandStats::dispatches)
+        .CmdDispatchIndirect(commandBuffer, buffer, offset);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdBindPipeline(
+    VkCommandBuffer commandBuffer,
+    VkPipelineBindPoint pipelineBindPoint,
+    VkPipeline pipeline)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = count_command(commandBuffer, &CommandStats::pipeline_binds, &shadow);
+    if (shadow && shadow->filter_bind_pipeline(pipelineBindPoint, pipeline)) return;
+    dispatch.CmdBindPipeline(commandBuffer, pipelineBindPoint, pipeline);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdBindDescriptorSets(
+    VkCommandBuffer commandBuffer,
+    VkPipelineBindPoint pipelineBindPoint,
+    VkPipelineLayout layout,
+    uint32_t firstSet,
+    uint32_t descriptorSetCount,
+    const VkDescriptorSet* pDescriptorSets,
+    uint32_t dynamicOffsetCount,
+    const uint32_t* pDynamicOffsets)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = count_command(commandBuffer, &CommandStats::descriptor_set_binds, &shadow);
+    if (shadow && shadow->filter_bind_descriptor_sets(pipelineBindPoint, layout, firstSet, descriptorSetCount,
+                                                      pDescriptorSets, dynamicOffsetCount, pDynamicOffsets)) {
+        return;
+    }
+    dispatch.CmdBindDescriptorSets(commandBuffer, pipelineBindPoint, layout, firstSet, descriptorSetCount,
+                                   pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdPushDescriptorSetKHR(
+    VkCommandBuffer commandBuffer,
+    VkPipelineBindPoint pipelineBindPoint,
+    VkPipelineLayout layout,
+    uint32_t set,
+    uint32_t descriptorWriteCount,
+    const VkWriteDescriptorSet* pDescriptorWrites)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = count_command(commandBuffer, &CommandStats::descriptor_set_binds, &shadow);
+    if (shadow) shadow->on_push_descriptor_set(pipelineBindPoint, layout, set);
+    dispatch.CmdPushDescriptorSetKHR(commandBuffer, pipelineBindPoint, layout, set, descriptorWriteCount,
+                                     pDescriptorWrites);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdPushDescriptorSetWithTemplateKHR(
+    VkCommandBuffer commandBuffer,
+    VkDescriptorUpdateTemplate descriptorUpdateTemplate,
+    VkPipelineLayout layout,
+    uint32_t set,
+    const void* pData)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = count_command(commandBuffer, &CommandStats::descriptor_set_binds, &shadow);
+    if (shadow) {
+        // bind point 는 템플릿에 들어 있으므로 양쪽 모두 버립니다.
+        shadow->on_push_descriptor_set(VK_PIPELINE_BIND_POINT_GRAPHICS, layout, set);
+        shadow->on_push_descriptor_set(VK_PIPELINE_BIND_POINT_COMPUTE, layout, set);
+    }
+    dispatch.CmdPushDescriptorSetWithTemplateKHR(commandBuffer, descriptorUpdateTemplate, layout, set, pData);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdBindVertexBuffers(
+    VkCommandBuffer commandBuffer,
+    uint32_t firstBinding,
+    uint32_t bindingCount,
+    const VkBuffer* pBuffers,
+    const VkDeviceSize* pOffsets)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = count_command(commandBuffer, &CommandStats::vertex_buffer_binds, &shadow);
+    if (shadow &&
+        shadow->filter_bind_vertex_buffers(firstBinding, bindingCount, pBuffers, pOffsets, nullptr, nullptr)) {
+        return;
+    }
+    dispatch.CmdBindVertexBuffers(commandBuffer, firstBinding, bindingCount, pBuffers, pOffsets);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdBindVertexBuffers2(
+    VkCommandBuffer commandBuffer,
+    uint32_t firstBinding,
+    uint32_t bindingCount,
+    const VkBuffer* pBuffers,
+    const VkDeviceSize* pOffsets,
+    const VkDeviceSize* pSizes,
+    const VkDeviceSize* pStrides)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = count_command(commandBuffer, &CommandStats::vertex_buffer_binds, &shadow);
+    if (shadow &&
+        shadow->filter_bind_vertex_buffers(firstBinding, bindingCount, pBuffers, pOffsets, pSizes, pStrides)) {
+        return;
+    }
+    dispatch.CmdBindVertexBuffers2(commandBuffer, firstBinding, bindingCount, pBuffers, pOffsets, pSizes, pStrides);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdBindVertexBuffers2EXT(
+    VkCommandBuffer commandBuffer,
+    uint32_t firstBinding,
+    uint32_t bindingCount,
+    const VkBuffer* pBuffers,
+    const VkDeviceSize* pOffsets,
+    const VkDeviceSize* pSizes,
+    const VkDeviceSize* pStrides)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = count_command(commandBuffer, &CommandStats::vertex_buffer_binds, &shadow);
+    if (shadow &&
+        shadow->filter_bind_vertex_buffers(firstBinding, bindingCount, pBuffers, pOffsets, pSizes, pStrides)) {
+        return;
+    }
+    dispatch.CmdBindVertexBuffers2EXT(commandBuffer, firstBinding, bindingCount, pBuffers, pOffsets, pSizes, pStrides);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdPushConstants(
+    VkCommandBuffer commandBuffer,
+    VkPipelineLayout layout,
+    VkShaderStageFlags stageFlags,
+    uint32_t offset,
+    uint32_t size,
+    const void* pValues)
+{
+    count_command(commandBuffer, &CommandStats::push_constants)
+        .CmdPushConstants(commandBuffer, layout, stageFlags, offset, size, pValues);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdBeginRenderPass(
+    VkCommandBuffer commandBuffer,
+    const VkRenderPassBeginInfo* pRenderPassBegin,
+    VkSubpassContents contents)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = count_command(commandBuffer, &CommandStats::render_passes, &shadow);
+    if (shadow) shadow->reset();
+    dispatch.CmdBeginRenderPass(commandBuffer, pRenderPassBegin, contents);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdBeginRenderPass2(
+    VkCommandBuffer commandBuffer,
+    const VkRenderPassBeginInfo* pRenderPassBegin,
+    const VkSubpassBeginInfo* pSubpassBeginInfo)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = count_command(commandBuffer, &CommandStats::render_passes, &shadow);
+    if (shadow) shadow->reset();
+    dispatch.CmdBeginRenderPass2(commandBuffer, pRenderPassBegin, pSubpassBeginInfo);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdBeginRenderPass2KHR(
+    VkCommandBuffer commandBuffer,
+    const VkRenderPassBeginInfo* pRenderPassBegin,
+    const VkSubpassBeginInfo* pSubpassBeginInfo)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = count_command(commandBuffer, &CommandStats::render_passes, &shadow);
+    if (shadow) shadow->reset();
+    dispatch.CmdBeginRenderPass2KHR(commandBuffer, pRenderPassBegin, pSubpassBeginInfo);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdBeginRendering(
+    VkCommandBuffer commandBuffer,
+    const VkRenderingInfo* pRenderingInfo)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = count_command(commandBuffer, &CommandStats::render_passes, &shadow);
+    if (shadow) shadow->reset();
+    dispatch.CmdBeginRendering(commandBuffer, pRenderingInfo);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdBeginRenderingKHR(
+    VkCommandBuffer commandBuffer,
+    const VkRenderingInfo* pRenderingInfo)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = count_command(commandBuffer, &CommandStats::render_passes, &shadow);
+    if (shadow) shadow->reset();
+    dispatch.CmdBeginRenderingKHR(commandBuffer, pRenderingInfo);
+}
+
+// 끝은 세기만 합니다. 바인드된 상태는 render pass 가 끝나도 유지되므로 섀도는 다음 시작에서 지웁니다.
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdEndRenderPass(
+    VkCommandBuffer commandBuffer)
+{
+    count_command(commandBuffer, &CommandStats::render_pass_ends).CmdEndRenderPass(commandBuffer);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdEndRenderPass2(
+    VkCommandBuffer commandBuffer,
+    const VkSubpassEndInfo* pSubpassEndInfo)
+{
+    count_command(commandBuffer, &CommandStats::render_pass_ends).CmdEndRenderPass2(commandBuffer, pSubpassEndInfo);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdEndRenderPass2KHR(
+    VkCommandBuffer commandBuffer,
+    const VkSubpassEndInfo* pSubpassEndInfo)
+{
+    count_command(commandBuffer, &CommandStats::render_pass_ends)
+        .CmdEndRenderPass2KHR(commandBuffer, pSubpassEndInfo);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdEndRendering(
+    VkCommandBuffer commandBuffer)
+{
+    count_command(commandBuffer, &CommandStats::render_pass_ends).CmdEndRendering(commandBuffer);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdEndRenderingKHR(
+    VkCommandBuffer commandBuffer)
+{
+    count_command(commandBuffer, &CommandStats::render_pass_ends).CmdEndRenderingKHR(commandBuffer);
+}
+
+// --- 상태 필터만 보는 vkCmd* ---
+
+// 상태 필터가 켜져 있으면 *shadow 에 커맨드 버퍼의 사본을 (아니면 nullptr) 돌려줍니다. 통계는 세지 않습니다.
+static inline const DeviceDispatchTable& find_state_shadow(
+    VkCommandBuffer commandBuffer,
+    StateShadow** shadow)
+{
+    LayerCommandBufferData* data = g_command_buffer_data_map.find(commandBuffer);
+    if (!data) {
+        *shadow = nullptr;
+        return get_device_data(commandBuffer)->dispatch;
+    }
+    *shadow = data->device_data->state_filter.enabled ? &data->shadow : nullptr;
+    return data->device_data->dispatch;
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdNextSubpass(
+    VkCommandBuffer commandBuffer,
+    VkSubpassContents contents)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow) shadow->reset();
+    dispatch.CmdNextSubpass(commandBuffer, contents);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdNextSubpass2(
+    VkCommandBuffer commandBuffer,
+    const VkSubpassBeginInfo* pSubpassBeginInfo,
+    const VkSubpassEndInfo* pSubpassEndInfo)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow) shadow->reset();
+    dispatch.CmdNextSubpass2(commandBuffer, pSubpassBeginInfo, pSubpassEndInfo);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdNextSubpass2KHR(
+    VkCommandBuffer commandBuffer,
+    const VkSubpassBeginInfo* pSubpassBeginInfo,
+    const VkSubpassEndInfo* pSubpassEndInfo)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow) shadow->reset();
+    dispatch.CmdNextSubpass2KHR(commandBuffer, pSubpassBeginInfo, pSubpassEndInfo);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdBindIndexBuffer(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    VkIndexType indexType)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_bind_index_buffer(buffer, offset, indexType)) return;
+    dispatch.CmdBindIndexBuffer(commandBuffer, buffer, offset, indexType);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetViewport(
+    VkCommandBuffer commandBuffer,
+    uint32_t firstViewport,
+    uint32_t viewportCount,
+    const VkViewport* pViewports)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_set_viewport(firstViewport, viewportCount, pViewports)) return;
+    dispatch.CmdSetViewport(commandBuffer, firstViewport, viewportCount, pViewports);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetScissor(
+    VkCommandBuffer commandBuffer,
+    uint32_t firstScissor,
+    uint32_t scissorCount,
+    const VkRect2D* pScissors)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_set_scissor(firstScissor, scissorCount, pScissors)) return;
+    dispatch.CmdSetScissor(commandBuffer, firstScissor, scissorCount, pScissors);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetLineWidth(
+    VkCommandBuffer commandBuffer,
+    float lineWidth)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_dynamic_state(StateShadow::kLineWidth, shadow->dynamic.line_width, lineWidth)) return;
+    dispatch.CmdSetLineWidth(commandBuffer, lineWidth);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetBlendConstants(
+    VkCommandBuffer commandBuffer,
+    const float blendConstants[4])
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_dynamic_state(StateShadow::kBlendConstants, shadow->dynamic.blend_constants,
+                                               *reinterpret_cast<const float(*)[4]>(blendConstants))) {
+        return;
+    }
+    dispatch.CmdSetBlendConstants(commandBuffer, blendConstants);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetDepthBounds(
+    VkCommandBuffer commandBuffer,
+    float minDepthBounds,
+    float maxDepthBounds)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    const float bounds[2] = {minDepthBounds, maxDepthBounds};
+    if (shadow && shadow->filter_dynamic_state(StateShadow::kDepthBounds, shadow->dynamic.depth_bounds, bounds)) return;
+    dispatch.CmdSetDepthBounds(commandBuffer, minDepthBounds, maxDepthBounds);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetStencilCompareMask(
+    VkCommandBuffer commandBuffer,
+    VkStencilFaceFlags faceMask,
+    uint32_t compareMask)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_set_stencil(faceMask, compareMask, shadow->dynamic.stencil_compare_mask,
+                                             StateShadow::kStencilCompareMask)) {
+        return;
+    }
+    dispatch.CmdSetStencilCompareMask(commandBuffer, faceMask, compareMask);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetStencilWriteMask(
+    VkCommandBuffer commandBuffer,
+    VkStencilFaceFlags faceMask,
+    uint32_t writeMask)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_set_stencil(faceMask, writeMask, shadow->dynamic.stencil_write_mask,
+                                             StateShadow::kStencilWriteMask)) {
+        return;
+    }
+    dispatch.CmdSetStencilWriteMask(commandBuffer, faceMask, writeMask);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetStencilReference(
+    VkCommandBuffer commandBuffer,
+    VkStencilFaceFlags faceMask,
+    uint32_t reference)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_set_stencil(faceMask, reference, shadow->dynamic.stencil_reference,
+                                             StateShadow::kStencilReference)) {
+        return;
+    }
+    dispatch.CmdSetStencilReference(commandBuffer, faceMask, reference);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetCullMode(
+    VkCommandBuffer commandBuffer,
+    VkCullModeFlags cullMode)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_dynamic_state(StateShadow::kCullMode, shadow->dynamic.cull_mode, cullMode)) return;
+    dispatch.CmdSetCullMode(commandBuffer, cullMode);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetCullModeEXT(
+    VkCommandBuffer commandBuffer,
+    VkCullModeFlags cullMode)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_dynamic_state(StateShadow::kCullMode, shadow->dynamic.cull_mode, cullMode)) return;
+    dispatch.CmdSetCullModeEXT(commandBuffer, cullMode);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetFrontFace(
+    VkCommandBuffer commandBuffer,
+    VkFrontFace frontFace)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_dynamic_state(StateShadow::kFrontFace, shadow->dynamic.front_face, frontFace)) return;
+    dispatch.CmdSetFrontFace(commandBuffer, frontFace);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetFrontFaceEXT(
+    VkCommandBuffer commandBuffer,
+    VkFrontFace frontFace)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_dynamic_state(StateShadow::kFrontFace, shadow->dynamic.front_face, frontFace)) return;
+    dispatch.CmdSetFrontFaceEXT(commandBuffer, frontFace);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetPrimitiveTopology(
+    VkCommandBuffer commandBuffer,
+    VkPrimitiveTopology primitiveTopology)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_dynamic_state(StateShadow::kPrimitiveTopology, shadow->dynamic.primitive_topology,
+                                               primitiveTopology)) {
+        return;
+    }
+    dispatch.CmdSetPrimitiveTopology(commandBuffer, primitiveTopology);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetPrimitiveTopologyEXT(
+    VkCommandBuffer commandBuffer,
+    VkPrimitiveTopology primitiveTopology)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_dynamic_state(StateShadow::kPrimitiveTopology, shadow->dynamic.primitive_topology,
+                                               primitiveTopology)) {
+        return;
+    }
+    dispatch.CmdSetPrimitiveTopologyEXT(commandBuffer, primitiveTopology);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetDepthTestEnable(
+    VkCommandBuffer commandBuffer,
+    VkBool32 depthTestEnable)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_dynamic_state(StateShadow::kDepthTestEnable, shadow->dynamic.depth_test_enable,
+                                               depthTestEnable)) {
+        return;
+    }
+    dispatch.CmdSetDepthTestEnable(commandBuffer, depthTestEnable);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetDepthTestEnableEXT(
+    VkCommandBuffer commandBuffer,
+    VkBool32 depthTestEnable)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_dynamic_state(StateShadow::kDepthTestEnable, shadow->dynamic.depth_test_enable,
+                                               depthTestEnable)) {
+        return;
+    }
+    dispatch.CmdSetDepthTestEnableEXT(commandBuffer, depthTestEnable);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetDepthWriteEnable(
+    VkCommandBuffer commandBuffer,
+    VkBool32 depthWriteEnable)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_dynamic_state(StateShadow::kDepthWriteEnable, shadow->dynamic.depth_write_enable,
+                                               depthWriteEnable)) {
+        return;
+    }
+    dispatch.CmdSetDepthWriteEnable(commandBuffer, depthWriteEnable);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetDepthWriteEnableEXT(
+    VkCommandBuffer commandBuffer,
+    VkBool32 depthWriteEnable)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_dynamic_state(StateShadow::kDepthWriteEnable, shadow->dynamic.depth_write_enable,
+                                               depthWriteEnable)) {
+        return;
+    }
+    dispatch.CmdSetDepthWriteEnableEXT(commandBuffer, depthWriteEnable);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetDepthCompareOp(
+    VkCommandBuffer commandBuffer,
+    VkCompareOp depthCompareOp)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_dynamic_state(StateShadow::kDepthCompareOp, shadow->dynamic.depth_compare_op,
+                                               depthCompareOp)) {
+        return;
+    }
+    dispatch.CmdSetDepthCompareOp(commandBuffer, depthCompareOp);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetDepthCompareOpEXT(
+    VkCommandBuffer commandBuffer,
+    VkCompareOp depthCompareOp)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow && shadow->filter_dynamic_state(StateShadow::kDepthCompareOp, shadow->dynamic.depth_compare_op,
+                                               depthCompareOp)) {
+        return;
+    }
+    dispatch.CmdSetDepthCompareOpEXT(commandBuffer, depthCompareOp);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetViewportWithCount(
+    VkCommandBuffer commandBuffer,
+    uint32_t viewportCount,
+    const VkViewport* pViewports)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow) shadow->on_set_viewport_with_count();
+    dispatch.CmdSetViewportWithCount(commandBuffer, viewportCount, pViewports);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetViewportWithCountEXT(
+    VkCommandBuffer commandBuffer,
+    uint32_t viewportCount,
+    const VkViewport* pViewports)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow) shadow->on_set_viewport_with_count();
+    dispatch.CmdSetViewportWithCountEXT(commandBuffer, viewportCount, pViewports);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetScissorWithCount(
+    VkCommandBuffer commandBuffer,
+    uint32_t scissorCount,
+    const VkRect2D* pScissors)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow) shadow->on_set_scissor_with_count();
+    dispatch.CmdSetScissorWithCount(commandBuffer, scissorCount, pScissors);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkCmdSetScissorWithCountEXT(
+    VkCommandBuffer commandBuffer,
+    uint32_t scissorCount,
+    const VkRect2D* pScissors)
+{
+    StateShadow* shadow;
+    const DeviceDispatchTable& dispatch = find_state_shadow(commandBuffer, &shadow);
+    if (shadow) shadow->on_set_scissor_with_count();
+    dispatch.CmdSetScissorWithCountEXT(commandBuffer, scissorCount, pScissors);
+}
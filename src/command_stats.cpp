@@ -0,0 +1,34 @@
+#include "command_stats.h"
+
+#include "layer_data.h"
+#include "settings.h"
+#include "utils.h"
+
+bool load_command_stats_enabled() {
+    return layer_settings().cmd_stats;
+}
+
+static inline void add_submitted(CommandStats* total, VkCommandBuffer command_buffer) {
+    LayerCommandBufferData* data = g_command_buffer_data_map.find(command_buffer);
+    if (data) total->add(data->stats);
+}
+
+void command_stats_on_submit(LayerQueueData* queue_data, uint32_t submit_count, const VkSubmitInfo* submits) {
+    CommandStats total;
+    for (uint32_t i = 0; i < submit_count; ++i) {
+        for (uint32_t j = 0; j < submits[i].commandBufferCount; ++j) {
+            add_submitted(&total, submits[i].pCommandBuffers[j]);
+        }
+    }
+    queue_data->submitted_commands.add(total);
+}
+
+void command_stats_on_submit2(LayerQueueData* queue_data, uint32_t submit_count, const VkSubmitInfo2* submits) {
+    CommandStats total;
+    for (uint32_t i = 0; i < submit_count; ++i) {
+        for (uint32_t j = 0; j < submits[i].commandBufferInfoCount; ++j) {
+            add_submitted(&total, submits[i].pCommandBufferInfos[j].commandBuffer);
+        }
+    }
+    queue_data->submitted_commands.add(total);
+}
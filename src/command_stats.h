@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <cstdint>
+
+#include "state_filter.h"
+
+// 커맨드 버퍼별 draw / dispatch / bind / render pass 시작·끝 통계.
+//
+// 기록 중에는 커맨드 버퍼마다 있는 CommandStats 의 일반 카운터만 올립니다. 커맨드 버퍼는 외부
+// 동기화 대상이므로 여러 스레드가 동시에 기록해도 공유 lock 이나 atomic RMW 가 필요 없습니다.
+// vkQueueSubmit 시점에 큐의 누적 카운터 (SubmittedCommandStats) 로 합산하고,
+// 프레임 프로파일러가 present 마다 디바이스 전체의 증가분을 프레임 통계로 씁니다.
+//
+// 설정:
+//   debug.my_layer.cmd_stats  0 이면 끔 (기본 1). 상태 필터도 꺼져 있으면 커맨드 버퍼를 추적하지 않고
+//                             vkGetDeviceProcAddr 가 vkCmd* 에 다음 체인의 포인터를 그대로 돌려줍니다.
+
+#define MY_LAYER_COMMAND_STATS(X) \
+    X(draws) \
+    X(dispatches) \
+    X(pipeline_binds) \
+    X(descriptor_set_binds) \
+    X(vertex_buffer_binds) \
+    X(push_constants) \
+    X(render_passes) \
+    X(render_pass_ends)
+
+struct CommandStats {
+#define MY_LAYER_COMMAND_STAT_FIELD(name) uint64_t name = 0;
+    MY_LAYER_COMMAND_STATS(MY_LAYER_COMMAND_STAT_FIELD)
+#undef MY_LAYER_COMMAND_STAT_FIELD
+
+    void add(const CommandStats& other) {
+#define MY_LAYER_COMMAND_STAT_ADD(name) name += other.name;
+        MY_LAYER_COMMAND_STATS(MY_LAYER_COMMAND_STAT_ADD)
+#undef MY_LAYER_COMMAND_STAT_ADD
+    }
+
+    void subtract(const CommandStats& other) {
+#define MY_LAYER_COMMAND_STAT_SUBTRACT(name) name -= other.name;
+        MY_LAYER_COMMAND_STATS(MY_LAYER_COMMAND_STAT_SUBTRACT)
+#undef MY_LAYER_COMMAND_STAT_SUBTRACT
+    }
+
+    uint64_t state_changes() const {
+        return pipeline_binds + descriptor_set_binds + vertex_buffer_binds + push_constants;
+    }
+};
+
+// 큐에 submit 된 커맨드의 누적값. 큐를 submit 하는 스레드만 쓰고 (relaxed load/store),
+// present 하는 스레드가 읽습니다.
+struct SubmittedCommandStats {
+#define MY_LAYER_COMMAND_STAT_FIELD(name) std::atomic<uint64_t> name{0};
+    MY_LAYER_COMMAND_STATS(MY_LAYER_COMMAND_STAT_FIELD)
+#undef MY_LAYER_COMMAND_STAT_FIELD
+
+    void add(const CommandStats& stats) {
+#define MY_LAYER_COMMAND_STAT_ADD(name) \
+        name.store(name.load(std::memory_order_relaxed) + stats.name, std::memory_order_relaxed);
+        MY_LAYER_COMMAND_STATS(MY_LAYER_COMMAND_STAT_ADD)
+#undef MY_LAYER_COMMAND_STAT_ADD
+    }
+
+    void accumulate_into(CommandStats* out) const {
+#define MY_LAYER_COMMAND_STAT_LOAD(name) out->name += name.load(std::memory_order_relaxed);
+        MY_LAYER_COMMAND_STATS(MY_LAYER_COMMAND_STAT_LOAD)
+#undef MY_LAYER_COMMAND_STAT_LOAD
+    }
+};
+
+struct LayerDeviceData;
+struct LayerQueueData;
+
+struct LayerCommandBufferData {
+    VkCommandBuffer command_buffer;
+    VkCommandPool command_pool;
+    LayerDeviceData* device_data;
+    CommandStats stats;
+    StateShadow shadow;  // 상태 필터가 켜져 있을 때만 사용
+};
+
+bool load_command_stats_enabled();
+
+// vkQueueSubmit / vkQueueSubmit2 의 커맨드 버퍼 통계를 큐 누적값에 더합니다.
+void command_stats_on_submit(LayerQueueData* queue_data, uint32_t submit_count, const VkSubmitInfo* submits);
+void command_stats_on_submit2(LayerQueueData* queue_data, uint32_t submit_count, const VkSubmitInfo2* submits);
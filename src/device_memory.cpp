@@ -0,0 +1,722 @@
+#include "device_memory.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <string>
+
+#include "telemetry.h"
+#include "settings.h"
+#include "utils.h"
+
+// order o 노드는 (m_min_node_size << o) 바이트이고, index (m_min_node_size 단위 offset) 가 2^o 의 배수입니다.
+// 빈 노드는 order 별 비트맵으로 들고 있고 (비트 n = index n << o), free_orders 로 빈 노드가 있는 order 를
+// 바로 찾습니다. 블록은 가장 큰 빈 order 별 bin (DeviceMemoryTracker::m_free_bins) 에 연결됩니다.
+struct DeviceMemoryTracker::Block {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    uint32_t memory_type = 0;
+    void* mapped = nullptr;
+    VkDeviceSize used = 0;
+
+    uint32_t max_order = 0;
+    uint64_t free_orders = 0;            // bit o: order o 에 빈 노드가 있음
+    std::vector<uint32_t> first_word;    // order 별 비트맵이 bits 에서 시작하는 위치
+    std::vector<uint32_t> search_hint;   // order 별 이 word 앞에는 빈 노드가 없음
+    std::vector<uint32_t> free_count;    // order 별 빈 노드 수
+    std::vector<uint64_t> bits;
+
+    int bin = -1;                        // 연결된 bin (가장 큰 빈 order), 꽉 차면 -1
+    Block* bin_prev = nullptr;
+    Block* bin_next = nullptr;
+
+    void init(uint32_t orders) {
+        max_order = orders;
+        first_word.resize(max_order + 1);
+        search_hint.assign(max_order + 1, 0);
+        free_count.assign(max_order + 1, 0);
+        uint32_t words = 0;
+        for (uint32_t order = 0; order <= max_order; ++order) {
+            first_word[order] = words;
+            words += ((1u << (max_order - order)) + 63) / 64;
+        }
+        bits.assign(words, 0);
+        set_free(max_order, 0);
+    }
+
+    int largest_free_order() const {
+        return free_orders ? 63 - __builtin_clzll(free_orders) : -1;
+    }
+
+    // 실패하면 UINT32_MAX.
+    uint32_t allocate(uint32_t order) {
+        uint64_t candidates = free_orders & (~0ull << order);
+        if (!candidates) return UINT32_MAX;
+        uint32_t found = (uint32_t)__builtin_ctzll(candidates);
+
+        uint32_t node = take_free(found);
+        // 남는 뒤쪽 절반을 한 단계씩 빈 노드로 돌려줍니다.
+        while (found > order) {
+            --found;
+            node <<= 1;
+            set_free(found, node + 1);
+        }
+        return node << order;
+    }
+
+    void free(uint32_t index, uint32_t order) {
+        uint32_t node = index >> order;
+        while (order < max_order && is_free(order, node ^ 1)) {
+            clear_free(order, node ^ 1);
+            node >>= 1;
+            ++order;
+        }
+        set_free(order, node);
+    }
+
+private:
+    bool is_free(uint32_t order, uint32_t node) const {
+        return bits[first_word[order] + node / 64] & (1ull << (node % 64));
+    }
+
+    void set_free(uint32_t order, uint32_t node) {
+        bits[first_word[order] + node / 64] |= 1ull << (node % 64);
+        search_hint[order] = std::min(search_hint[order], node / 64);
+        if (free_count[order]++ == 0) free_orders |= 1ull << order;
+    }
+
+    void clear_free(uint32_t order, uint32_t node) {
+        bits[first_word[order] + node / 64] &= ~(1ull << (node % 64));
+        if (--free_count[order] == 0) free_orders &= ~(1ull << order);
+    }
+
+    // free_count[order] > 0 일 때만 부릅니다. 가장 앞의 빈 노드를 꺼냅니다.
+    uint32_t take_free(uint32_t order) {
+        const uint64_t* words = &bits[first_word[order]];
+        uint32_t word = search_hint[order];
+        while (words[word] == 0) ++word;
+        search_hint[order] = word;
+        uint32_t node = word * 64 + (uint32_t)__builtin_ctzll(words[word]);
+        clear_free(order, node);
+        return node;
+    }
+};
+
+static VkDeviceSize next_power_of_two(VkDeviceSize value) {
+    VkDeviceSize result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+static uint32_t log2_exact(VkDeviceSize value) {
+    return (uint32_t)__builtin_ctzll(value);
+}
+
+// suballocation 과 함께 켜도 되는 디바이스 확장. 레이어가 번역하지 않는 명령 / 구조체로 앱의
+// VkDeviceMemory 를 드라이버에 넘기지 않는 확장만 둡니다. (메모리를 받는 경우는 pNext 가 있는 할당,
+// 즉 export / import / dedicated 할당에 한정되어 그대로 넘어가는 것들)
+// 여기에 없는 확장이 하나라도 켜져 있으면 suballocation 을 끕니다. (ex. VK_KHR_video_queue 의
+// vkBindVideoSessionMemoryKHR, VK_NV_ray_tracing 의 vkBindAccelerationStructureMemoryNV,
+// VK_EXT_pageable_device_local_memory 의 vkSetDeviceMemoryPriorityEXT, VK_EXT_debug_marker)
+static constexpr const char* kSuballocationCompatibleExtensions[] = {
+    // 메모리 / 바인딩 (레이어가 번역)
+    "VK_KHR_bind_memory2",
+    "VK_KHR_map_memory2",
+    "VK_KHR_dedicated_allocation",
+    "VK_KHR_get_memory_requirements2",
+    "VK_KHR_maintenance1",
+    "VK_KHR_maintenance2",
+    "VK_KHR_maintenance3",
+    "VK_KHR_maintenance4",
+    "VK_KHR_maintenance5",
+    "VK_KHR_maintenance6",
+    "VK_KHR_sampler_ycbcr_conversion",
+    "VK_KHR_buffer_device_address",
+    "VK_EXT_buffer_device_address",
+    "VK_EXT_memory_budget",
+    "VK_EXT_memory_priority",
+    // 외부 메모리 / 동기화 (메모리는 export / import 할당으로만 넘어감)
+    "VK_KHR_external_memory",
+    "VK_KHR_external_memory_fd",
+    "VK_KHR_external_semaphore",
+    "VK_KHR_external_semaphore_fd",
+    "VK_KHR_external_fence",
+    "VK_KHR_external_fence_fd",
+    "VK_EXT_external_memory_dma_buf",
+    "VK_EXT_queue_family_foreign",
+    "VK_ANDROID_external_memory_android_hardware_buffer",
+    // 표시
+    "VK_KHR_swapchain",
+    "VK_KHR_incremental_present",
+    "VK_KHR_present_id",
+    "VK_KHR_present_wait",
+    "VK_GOOGLE_display_timing",
+    "VK_EXT_hdr_metadata",
+    "VK_EXT_swapchain_maintenance1",
+    // 렌더링 / 파이프라인 / 셰이더
+    "VK_KHR_create_renderpass2",
+    "VK_KHR_depth_stencil_resolve",
+    "VK_KHR_dynamic_rendering",
+    "VK_KHR_dynamic_rendering_local_read",
+    "VK_KHR_imageless_framebuffer",
+    "VK_KHR_image_format_list",
+    "VK_KHR_multiview",
+    "VK_KHR_separate_depth_stencil_layouts",
+    "VK_KHR_load_store_op_none",
+    "VK_KHR_fragment_shading_rate",
+    "VK_KHR_synchronization2",
+    "VK_KHR_timeline_semaphore",
+    "VK_KHR_copy_commands2",
+    "VK_KHR_draw_indirect_count",
+    "VK_KHR_descriptor_update_template",
+    "VK_KHR_push_descriptor",
+    "VK_KHR_pipeline_library",
+    "VK_KHR_pipeline_executable_properties",
+    "VK_KHR_format_feature_flags2",
+    "VK_KHR_driver_properties",
+    "VK_KHR_global_priority",
+    "VK_KHR_index_type_uint8",
+    "VK_KHR_line_rasterization",
+    "VK_KHR_vertex_attribute_divisor",
+    "VK_KHR_16bit_storage",
+    "VK_KHR_8bit_storage",
+    "VK_KHR_storage_buffer_storage_class",
+    "VK_KHR_variable_pointers",
+    "VK_KHR_relaxed_block_layout",
+    "VK_KHR_uniform_buffer_standard_layout",
+    "VK_KHR_vulkan_memory_model",
+    "VK_KHR_spirv_1_4",
+    "VK_KHR_shader_draw_parameters",
+    "VK_KHR_shader_float16_int8",
+    "VK_KHR_shader_float_controls",
+    "VK_KHR_shader_integer_dot_product",
+    "VK_KHR_shader_non_semantic_info",
+    "VK_KHR_shader_subgroup_extended_types",
+    "VK_KHR_shader_terminate_invocation",
+    "VK_KHR_zero_initialize_workgroup_memory",
+    "VK_EXT_descriptor_indexing",
+    "VK_EXT_extended_dynamic_state",
+    "VK_EXT_extended_dynamic_state2",
+    "VK_EXT_extended_dynamic_state3",
+    "VK_EXT_vertex_input_dynamic_state",
+    "VK_EXT_vertex_attribute_divisor",
+    "VK_EXT_index_type_uint8",
+    "VK_EXT_line_rasterization",
+    "VK_EXT_custom_border_color",
+    "VK_EXT_robustness2",
+    "VK_EXT_image_robustness",
+    "VK_EXT_pipeline_robustness",
+    "VK_EXT_texture_compression_astc_hdr",
+    "VK_EXT_subgroup_size_control",
+    "VK_EXT_pipeline_creation_feedback",
+    "VK_EXT_pipeline_creation_cache_control",
+    "VK_EXT_graphics_pipeline_library",
+    "VK_EXT_scalar_block_layout",
+    "VK_EXT_host_query_reset",
+    "VK_EXT_separate_stencil_usage",
+    "VK_EXT_sampler_filter_minmax",
+    "VK_EXT_inline_uniform_block",
+    "VK_EXT_shader_viewport_index_layer",
+    "VK_EXT_shader_demote_to_helper_invocation",
+    "VK_EXT_shader_stencil_export",
+    "VK_EXT_fragment_density_map",
+    "VK_EXT_depth_clip_enable",
+    "VK_EXT_depth_clip_control",
+    "VK_EXT_provoking_vertex",
+    "VK_EXT_primitive_topology_list_restart",
+    "VK_EXT_color_write_enable",
+    "VK_EXT_4444_formats",
+    "VK_EXT_load_store_op_none",
+    "VK_EXT_rasterization_order_attachment_access",
+    "VK_EXT_multisampled_render_to_single_sampled",
+    "VK_EXT_transform_feedback",
+    "VK_EXT_conditional_rendering",
+    "VK_EXT_calibrated_timestamps",
+    "VK_EXT_global_priority",
+    "VK_EXT_global_priority_query",
+};
+
+// 번역 목록에 없는 첫 확장, 없으면 nullptr.
+static const char* first_untranslated_extension(const VkDeviceCreateInfo* create_info) {
+    for (uint32_t i = 0; i < create_info->enabledExtensionCount; ++i) {
+        const char* name = create_info->ppEnabledExtensionNames[i];
+        bool compatible = false;
+        for (const char* compatible_name : kSuballocationCompatibleExtensions) {
+            if (strcmp(name, compatible_name) == 0) {
+                compatible = true;
+                break;
+            }
+        }
+        if (!compatible) return name;
+    }
+    return nullptr;
+}
+
+// sparse binding (vkQueueBindSparse) 과 private data (vkSetPrivateData, 1.3 core) 는 코어 기능이라
+// 확장 목록으로는 보이지 않으므로 기능 구조체를 봅니다. 켜져 있으면 그 이름, 아니면 nullptr.
+static const char* first_untranslated_feature(const VkDeviceCreateInfo* create_info) {
+    if (create_info->pEnabledFeatures && create_info->pEnabledFeatures->sparseBinding) return "sparseBinding";
+    for (const VkBaseInStructure* next = static_cast<const VkBaseInStructure*>(create_info->pNext); next;
+         next = next->pNext) {
+        switch (next->sType) {
+            case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2:
+                if (reinterpret_cast<const VkPhysicalDeviceFeatures2*>(next)->features.sparseBinding) {
+                    return "sparseBinding";
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    if (private_data_enabled(create_info)) return "privateData";
+    return nullptr;
+}
+
+std::unique_ptr<DeviceMemoryTracker> DeviceMemoryTracker::create(
+    VkDevice device,
+    const DeviceDispatchTable* dispatch,
+    const VkPhysicalDeviceProperties& properties,
+    const VkPhysicalDeviceMemoryProperties& memory_properties,
+    const VkDeviceCreateInfo* create_info)
+{
+    const LayerSettings& settings = layer_settings();
+    uint64_t mode = settings.memory;
+    if (mode == 0) return nullptr;
+
+    std::unique_ptr<DeviceMemoryTracker> tracker(new DeviceMemoryTracker(
+        device, dispatch, memory_properties, properties.limits.maxMemoryAllocationCount));
+    if (mode < 2) return tracker;
+
+    if (const char* name = first_untranslated_extension(create_info)) {
+        ALOGI("memory: suballocation disabled, %s is enabled", name);
+        return tracker;
+    }
+    if (const char* name = first_untranslated_feature(create_info)) {
+        ALOGI("memory: suballocation disabled, %s is enabled", name);
+        return tracker;
+    }
+
+    VkDeviceSize min_node_size = std::max<VkDeviceSize>({256, properties.limits.bufferImageGranularity,
+                                                         properties.limits.nonCoherentAtomSize});
+    tracker->m_min_node_size = next_power_of_two(min_node_size);
+    tracker->m_block_size = next_power_of_two(settings.suballoc_block_mb << 20);
+    tracker->m_suballoc_max_size = settings.suballoc_max_kb << 10;
+    if (tracker->m_block_size <= tracker->m_min_node_size ||
+        tracker->m_suballoc_max_size > tracker->m_block_size / 2) {
+        ALOGE("memory: invalid suballocation sizes (block %" PRIu64 ", max %" PRIu64 "), suballocation disabled",
+              (uint64_t)tracker->m_block_size, (uint64_t)tracker->m_suballoc_max_size);
+        return tracker;
+    }
+    tracker->m_max_order = log2_exact(tracker->m_block_size / tracker->m_min_node_size);
+    std::fill(std::begin(tracker->m_type_min_node_size), std::end(tracker->m_type_min_node_size),
+              tracker->m_min_node_size);
+    // vkMapMemory 가 돌려준 주소 - offset 은 minMemoryMapAlignment 의 배수여야 합니다. (Mesa 는 4096)
+    // 블록 map 주소는 맞으므로 노드 offset 이 맞도록 host visible 타입의 노드를 그 크기 이상으로 잡습니다.
+    VkDeviceSize map_node_size = std::max<VkDeviceSize>(
+        tracker->m_min_node_size, next_power_of_two(properties.limits.minMemoryMapAlignment));
+    for (uint32_t type = 0; type < memory_properties.memoryTypeCount; ++type) {
+        if (memory_properties.memoryTypes[type].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+            tracker->m_type_min_node_size[type] = map_node_size;
+        }
+    }
+    for (auto& bins : tracker->m_free_bins) bins.assign(tracker->m_max_order + 1, nullptr);
+    tracker->m_suballocate = true;
+    return tracker;
+}
+
+DeviceMemoryTracker::DeviceMemoryTracker(VkDevice device, const DeviceDispatchTable* dispatch,
+                                         const VkPhysicalDeviceMemoryProperties& memory_properties,
+                                         uint32_t allocation_limit)
+    : m_device(device), m_dispatch(dispatch), m_memory_properties(memory_properties),
+      m_allocation_limit(allocation_limit) {}
+
+DeviceMemoryTracker::~DeviceMemoryTracker() {
+    log_census("device destroyed");
+    // 앱이 해제하지 않은 suballocation 이 남아 있어도 블록은 여기서 돌려줍니다.
+    for (auto& blocks : m_blocks) {
+        for (auto& block : blocks) m_dispatch->FreeMemory(m_device, block->memory, nullptr);
+    }
+}
+
+bool DeviceMemoryTracker::can_suballocate(const VkMemoryAllocateInfo* allocate_info) const {
+    if (!m_suballocate || allocate_info->pNext) return false;
+    if (allocate_info->allocationSize == 0 || allocate_info->allocationSize > m_suballoc_max_size) return false;
+    if (allocate_info->memoryTypeIndex >= m_memory_properties.memoryTypeCount) return false;
+    VkMemoryPropertyFlags flags = m_memory_properties.memoryTypes[allocate_info->memoryTypeIndex].propertyFlags;
+    return !(flags & (VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT | VK_MEMORY_PROPERTY_PROTECTED_BIT));
+}
+
+VkResult DeviceMemoryTracker::allocate(const VkMemoryAllocateInfo* allocate_info,
+                                       const VkAllocationCallbacks* allocator, VkDeviceMemory* memory)
+{
+    if (can_suballocate(allocate_info)) {
+        VkResult result = suballocate(allocate_info, memory);
+        if (result == VK_SUCCESS) return result;
+        // 블록을 만들 수 없으면 (ex. 메모리 부족) 요청한 크기로 직접 할당해 봅니다.
+    }
+
+    VkResult result = m_dispatch->AllocateMemory(m_device, allocate_info, allocator, memory);
+    if (result != VK_SUCCESS) return result;
+
+    uint32_t type = allocate_info->memoryTypeIndex;
+    VkDeviceSize size = allocate_info->allocationSize;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    TypeCensus& census = m_census[type];
+    census.live_count++;
+    census.live_bytes += size;
+    census.peak_bytes = std::max(census.peak_bytes, census.live_bytes);
+    census.driver_count++;
+    census.driver_bytes += size;
+    m_allocation_sizes.record(size);
+    m_direct[*memory] = DirectAllocation{size, type};
+    publish_telemetry_locked();
+    return result;
+}
+
+// 블록을 bin 으로 옮깁니다. 노드를 할당 / 해제한 뒤에는 가장 큰 빈 order 로, 블록을 없앨 때는 -1 로 부릅니다.
+void DeviceMemoryTracker::move_to_bin_locked(Block* block, int bin) {
+    if (bin == block->bin) return;
+    std::vector<Block*>& bins = m_free_bins[block->memory_type];
+    if (block->bin >= 0) {
+        if (block->bin_prev) block->bin_prev->bin_next = block->bin_next;
+        else bins[block->bin] = block->bin_next;
+        if (block->bin_next) block->bin_next->bin_prev = block->bin_prev;
+    }
+    block->bin = bin;
+    block->bin_prev = nullptr;
+    block->bin_next = nullptr;
+    if (bin >= 0) {
+        block->bin_next = bins[bin];
+        if (block->bin_next) block->bin_next->bin_prev = block;
+        bins[bin] = block;
+    }
+}
+
+DeviceMemoryTracker::Block* DeviceMemoryTracker::create_block_locked(uint32_t memory_type) {
+    VkMemoryAllocateInfo allocate_info = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+    allocate_info.allocationSize = m_block_size;
+    allocate_info.memoryTypeIndex = memory_type;
+
+    auto block = std::make_unique<Block>();
+    if (m_dispatch->AllocateMemory(m_device, &allocate_info, nullptr, &block->memory) != VK_SUCCESS) {
+        return nullptr;
+    }
+    block->memory_type = memory_type;
+    block->init(m_max_order);
+    move_to_bin_locked(block.get(), block->largest_free_order());
+
+    TypeCensus& census = m_census[memory_type];
+    census.driver_count++;
+    census.driver_bytes += m_block_size;
+
+    m_blocks[memory_type].push_back(std::move(block));
+    return m_blocks[memory_type].back().get();
+}
+
+// 성공하면 sub 의 memory / offset / node_size / block 을 채웁니다.
+bool DeviceMemoryTracker::allocate_node_locked(uint32_t memory_type, VkDeviceSize node_size, SubAllocation* sub) {
+    uint32_t order = log2_exact(node_size / m_min_node_size);
+    if (order > m_max_order) return false;
+
+    // 가장 큰 빈 노드가 요청 order 에 가장 가까운 블록을 씁니다. (큰 빈 노드를 쪼개지 않도록)
+    Block* block = nullptr;
+    for (uint32_t bin = order; bin <= m_max_order && !block; ++bin) block = m_free_bins[memory_type][bin];
+    if (!block) {
+        block = create_block_locked(memory_type);
+        if (!block) return false;
+    }
+    uint32_t index = block->allocate(order);
+    block->used += node_size;
+    move_to_bin_locked(block, block->largest_free_order());
+
+    sub->memory = block->memory;
+    sub->offset = (VkDeviceSize)index * m_min_node_size;
+    sub->node_size = node_size;
+    sub->block = block;
+    return true;
+}
+
+// 노드를 블록에 돌려줍니다. 블록이 비어 드라이버에 돌려줘야 하면 그 메모리를, 아니면 VK_NULL_HANDLE.
+VkDeviceMemory DeviceMemoryTracker::free_node_locked(const SubAllocation& sub) {
+    Block* block = sub.block;
+    block->free((uint32_t)(sub.offset / m_min_node_size), log2_exact(sub.node_size / m_min_node_size));
+    block->used -= sub.node_size;
+    move_to_bin_locked(block, block->largest_free_order());
+
+    // 빈 블록은 타입마다 하나만 남기고 드라이버에 돌려줍니다.
+    auto& blocks = m_blocks[sub.memory_type];
+    if (block->used != 0 || blocks.size() <= 1) return VK_NULL_HANDLE;
+
+    VkDeviceMemory empty_block = block->memory;
+    move_to_bin_locked(block, -1);
+    TypeCensus& census = m_census[sub.memory_type];
+    census.driver_count--;
+    census.driver_bytes -= m_block_size;
+    blocks.erase(std::find_if(blocks.begin(), blocks.end(),
+                              [block](const std::unique_ptr<Block>& b) { return b.get() == block; }));
+    return empty_block;
+}
+
+VkResult DeviceMemoryTracker::suballocate(const VkMemoryAllocateInfo* allocate_info, VkDeviceMemory* memory) {
+    uint32_t type = allocate_info->memoryTypeIndex;
+    VkDeviceSize size = allocate_info->allocationSize;
+
+    auto sub = std::make_unique<SubAllocation>();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        VkDeviceSize node_size = std::max(m_type_min_node_size[type], next_power_of_two(size));
+        if (!allocate_node_locked(type, node_size, sub.get())) return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+        sub->size = size;
+        sub->memory_type = type;
+
+        TypeCensus& census = m_census[type];
+        census.live_count++;
+        census.live_bytes += size;
+        census.peak_bytes = std::max(census.peak_bytes, census.live_bytes);
+        census.suballocated++;
+        m_allocation_sizes.record(size);
+        publish_telemetry_locked();
+    }
+
+    const void* key = sub.get();
+    *memory = (VkDeviceMemory)(uintptr_t)key;
+    m_suballocations.insert(key, std::move(sub));
+    return VK_SUCCESS;
+}
+
+void DeviceMemoryTracker::free(VkDeviceMemory memory, const VkAllocationCallbacks* allocator) {
+    if (memory == VK_NULL_HANDLE) return;
+
+    if (m_suballocate) {
+        const void* key = suballocation_key(memory);
+        std::unique_ptr<SubAllocation> sub = key ? m_suballocations.erase(key) : nullptr;
+        if (sub) {
+            free_suballocation(std::move(sub));
+            return;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_direct.find(memory);
+        if (it != m_direct.end()) {
+            TypeCensus& census = m_census[it->second.memory_type];
+            census.live_count--;
+            census.live_bytes -= it->second.size;
+            census.driver_count--;
+            census.driver_bytes -= it->second.size;
+            m_direct.erase(it);
+            publish_telemetry_locked();
+        }
+    }
+    m_dispatch->FreeMemory(m_device, memory, allocator);
+}
+
+void DeviceMemoryTracker::free_suballocation(std::unique_ptr<SubAllocation> sub) {
+    VkDeviceMemory empty_block = VK_NULL_HANDLE;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        empty_block = free_node_locked(*sub);
+
+        TypeCensus& census = m_census[sub->memory_type];
+        census.live_count--;
+        census.live_bytes -= sub->size;
+        publish_telemetry_locked();
+    }
+    // 블록이 map 되어 있어도 vkFreeMemory 가 암시적으로 unmap 합니다.
+    if (empty_block != VK_NULL_HANDLE) m_dispatch->FreeMemory(m_device, empty_block, nullptr);
+}
+
+VkResult DeviceMemoryTracker::translate_bind(VkDeviceMemory* memory, VkDeviceSize* offset, VkDeviceSize alignment) {
+    BindTranslation bind = {memory, offset, alignment};
+    return translate_binds(&bind, 1);
+}
+
+// 노드 offset 은 노드 크기의 배수이므로, 노드가 alignment 보다 크거나 같으면 (앱 offset 이 맞는 한) 맞습니다.
+// 작은 노드가 우연히 맞는 자리에 있을 수도 있어서 실제 offset 으로 판단합니다.
+// 같은 메모리를 여러 번 bind 하면 그중 가장 큰 alignment 에 맞는 노드로 한 번만 옮깁니다.
+VkResult DeviceMemoryTracker::translate_binds(const BindTranslation* binds, uint32_t count) {
+    if (!m_suballocate) return VK_SUCCESS;
+
+    struct Move {
+        SubAllocation* sub;
+        VkDeviceSize alignment = 0;  // 앱 offset 이 맞는 bind 중 가장 큰 alignment
+        bool misaligned = false;
+        bool allocated = false;      // moved 에 새 노드를 잡았는지
+        SubAllocation moved = {};
+    };
+    std::vector<SubAllocation*> subs(count);
+    std::vector<Move> moves;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (*binds[i].memory == VK_NULL_HANDLE) continue;
+        const void* key = suballocation_key(*binds[i].memory);
+        subs[i] = key ? m_suballocations.find(key) : nullptr;
+    }
+
+    std::vector<VkDeviceMemory> empty_blocks;
+    VkResult result = VK_SUCCESS;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (uint32_t i = 0; i < count; ++i) {
+            SubAllocation* sub = subs[i];
+            if (!sub) continue;
+            auto it = std::find_if(moves.begin(), moves.end(), [sub](const Move& move) { return move.sub == sub; });
+            Move& move = it != moves.end() ? *it : moves.emplace_back(Move{sub});
+            // 앱 offset 자체가 어긋난 것은 앱의 잘못이라 옮겨도 맞출 수 없습니다. 레이어가 없을 때와 같이 넘깁니다.
+            VkDeviceSize alignment = binds[i].alignment;
+            if (alignment <= 1 || *binds[i].offset % alignment != 0) continue;
+            move.alignment = std::max(move.alignment, alignment);
+            if ((sub->offset + *binds[i].offset) % alignment != 0) move.misaligned = true;
+        }
+
+        // 먼저 옮길 노드를 모두 잡아 보고, 하나라도 안 되면 잡은 것을 돌려줍니다.
+        for (Move& move : moves) {
+            if (!move.misaligned) continue;
+            SubAllocation* sub = move.sub;
+            VkDeviceSize aligned_size = next_power_of_two(move.alignment);
+            VkDeviceSize& type_min = m_type_min_node_size[sub->memory_type];
+            if (type_min < aligned_size && aligned_size <= m_block_size) {
+                ALOGI("memory: type %u minimum node %" PRIu64 " -> %" PRIu64 " B for alignment %" PRIu64,
+                      sub->memory_type, (uint64_t)type_min, (uint64_t)aligned_size, (uint64_t)move.alignment);
+                type_min = aligned_size;
+            }
+
+            move.moved = *sub;
+            if (sub->bound || sub->mapped ||
+                !allocate_node_locked(sub->memory_type, std::max(sub->node_size, aligned_size), &move.moved)) {
+                ALOGE("memory: suballocation %p (node %" PRIu64 " B at %" PRIu64 ") cannot meet alignment %" PRIu64
+                      "%s; lower debug.my_layer.suballoc_max_kb or disable suballocation",
+                      (void*)sub, (uint64_t)sub->node_size, (uint64_t)sub->offset, (uint64_t)move.alignment,
+                      sub->bound || sub->mapped ? " after bind / map" : "");
+                result = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+                break;
+            }
+            move.allocated = true;
+        }
+
+        for (Move& move : moves) {
+            if (!move.allocated) continue;
+            // 실패하면 새 노드를, 성공하면 이전 노드를 돌려줍니다.
+            VkDeviceMemory empty_block = free_node_locked(result == VK_SUCCESS ? *move.sub : move.moved);
+            if (empty_block != VK_NULL_HANDLE) empty_blocks.push_back(empty_block);
+            if (result == VK_SUCCESS) *move.sub = move.moved;
+        }
+        if (result == VK_SUCCESS) {
+            for (uint32_t i = 0; i < count; ++i) {
+                SubAllocation* sub = subs[i];
+                if (!sub) continue;
+                sub->bound = true;
+                *binds[i].memory = sub->memory;
+                *binds[i].offset += sub->offset;
+            }
+        }
+    }
+    for (VkDeviceMemory empty_block : empty_blocks) m_dispatch->FreeMemory(m_device, empty_block, nullptr);
+    return result;
+}
+
+VkResult DeviceMemoryTracker::map(const SubAllocation* sub, VkDeviceSize offset, void** data) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // map 한 뒤에는 앱이 주소를 들고 있으므로 translate_bind 가 노드를 옮기지 않습니다.
+    const_cast<SubAllocation*>(sub)->mapped = true;
+    Block* block = sub->block;
+    if (!block->mapped) {
+        VkResult result = m_dispatch->MapMemory(m_device, block->memory, 0, VK_WHOLE_SIZE, 0, &block->mapped);
+        if (result != VK_SUCCESS) {
+            block->mapped = nullptr;
+            return result;
+        }
+    }
+    *data = static_cast<uint8_t*>(block->mapped) + sub->offset + offset;
+    return VK_SUCCESS;
+}
+
+static double to_mib(uint64_t bytes) {
+    return (double)bytes / (1024.0 * 1024.0);
+}
+
+static std::string size_string(uint64_t bytes) {
+    char buffer[32];
+    if (bytes >= (1ull << 20)) {
+        snprintf(buffer, sizeof(buffer), "%.1f MiB", to_mib(bytes));
+    } else {
+        snprintf(buffer, sizeof(buffer), "%.1f KiB", (double)bytes / 1024.0);
+    }
+    return buffer;
+}
+
+void DeviceMemoryTracker::log_totals_locked(const char* prefix) {
+    uint64_t live_count = 0, live_bytes = 0, driver_count = 0, driver_bytes = 0;
+    for (const TypeCensus& census : m_census) {
+        live_count += census.live_count;
+        live_bytes += census.live_bytes;
+        driver_count += census.driver_count;
+        driver_bytes += census.driver_bytes;
+    }
+    ALOGI("%s: %" PRIu64 " live allocations (%.1f MiB), %" PRIu64 " driver allocations (%.1f MiB, limit %u)",
+          prefix, live_count, to_mib(live_bytes), driver_count, to_mib(driver_bytes), m_allocation_limit);
+}
+
+void DeviceMemoryTracker::publish_telemetry_locked() {
+    TelemetryRegion* telemetry = telemetry_region();
+    if (!telemetry) return;
+    uint64_t live_bytes = 0, driver_count = 0, driver_bytes = 0;
+    for (const TypeCensus& census : m_census) {
+        live_bytes += census.live_bytes;
+        driver_count += census.driver_count;
+        driver_bytes += census.driver_bytes;
+    }
+    telemetry_set_counter(telemetry, TelemetryCounter::memory_live_bytes, live_bytes);
+    telemetry_set_counter(telemetry, TelemetryCounter::memory_driver_bytes, driver_bytes);
+    telemetry_set_counter(telemetry, TelemetryCounter::memory_driver_allocations, driver_count);
+}
+
+void DeviceMemoryTracker::log_summary(const char* prefix) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    log_totals_locked(prefix);
+}
+
+void DeviceMemoryTracker::log_census(const char* when) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::string prefix = std::string("memory (") + when + ")";
+    log_totals_locked(prefix.c_str());
+
+    for (uint32_t heap = 0; heap < m_memory_properties.memoryHeapCount; ++heap) {
+        uint64_t live_count = 0, live_bytes = 0, driver_bytes = 0;
+        for (uint32_t type = 0; type < m_memory_properties.memoryTypeCount; ++type) {
+            if (m_memory_properties.memoryTypes[type].heapIndex != heap) continue;
+            live_count += m_census[type].live_count;
+            live_bytes += m_census[type].live_bytes;
+            driver_bytes += m_census[type].driver_bytes;
+        }
+        ALOGI("memory: heap %u (%s, %.0f MiB) %" PRIu64 " live allocations %.1f MiB, driver %.1f MiB",
+              heap,
+              (m_memory_properties.memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) ? "device local" : "host",
+              to_mib(m_memory_properties.memoryHeaps[heap].size), live_count, to_mib(live_bytes), to_mib(driver_bytes));
+    }
+
+    for (uint32_t type = 0; type < m_memory_properties.memoryTypeCount; ++type) {
+        const TypeCensus& census = m_census[type];
+        if (census.peak_bytes == 0 && census.driver_count == 0) continue;
+        ALOGI("memory: type %u (flags 0x%x) %" PRIu64 " live %.1f MiB (peak %.1f MiB), "
+              "driver %" PRIu64 " %.1f MiB, %" PRIu64 " suballocated",
+              type, m_memory_properties.memoryTypes[type].propertyFlags, census.live_count, to_mib(census.live_bytes),
+              to_mib(census.peak_bytes), census.driver_count, to_mib(census.driver_bytes), census.suballocated);
+    }
+
+    Histogram::Snapshot sizes;
+    m_allocation_sizes.snapshot(&sizes);
+    if (sizes.total == 0) return;
+    uint64_t at_least_4k = Histogram::count_at_least(sizes, 4 << 10);
+    uint64_t at_least_64k = Histogram::count_at_least(sizes, 64 << 10);
+    uint64_t at_least_1m = Histogram::count_at_least(sizes, 1 << 20);
+    uint64_t at_least_16m = Histogram::count_at_least(sizes, 16 << 20);
+    ALOGI("memory: %" PRIu64 " allocations, size p50 %s p95 %s p99 %s",
+          sizes.total,
+          size_string(Histogram::percentile(sizes, 0.50)).c_str(),
+          size_string(Histogram::percentile(sizes, 0.95)).c_str(),
+          size_string(Histogram::percentile(sizes, 0.99)).c_str());
+    ALOGI("memory: allocation sizes <4K %" PRIu64 ", <64K %" PRIu64 ", <1M %" PRIu64 ", <16M %" PRIu64
+          ", >=16M %" PRIu64,
+          sizes.total - at_least_4k, at_least_4k - at_least_64k, at_least_64k - at_least_1m,
+          at_least_1m - at_least_16m, at_least_16m);
+}
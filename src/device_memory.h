@@ -0,0 +1,164 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "dispatch_table.h"
+#include "handle_map.h"
+#include "histogram.h"
+
+// 디바이스 메모리 census 와 작은 할당의 suballocation.
+//
+// census: vkAllocateMemory / vkFreeMemory 를 메모리 타입별로 집계합니다. (살아 있는 할당 수 / 바이트,
+//   드라이버 할당 수와 maxMemoryAllocationCount, 할당 크기 히스토그램) 주기 리포트에는 요약 한 줄,
+//   vkDestroyDevice 에는 heap / 타입별 상세를 남깁니다.
+// suballocate: census 에 더해, 작은 할당을 메모리 타입별 큰 블록에서 buddy 방식으로 잘라 줍니다.
+//   앱에는 레이어가 만든 VkDeviceMemory 를 돌려주고, bind / map / flush / invalidate / debug name 에서
+//   (블록 메모리, 블록 내 offset) 으로 바꿔서 넘깁니다.
+//   buddy 노드는 크기가 2의 거듭제곱이고 offset 이 자기 크기의 배수이므로, 리소스 alignment 가 노드
+//   크기 이하이면 따로 맞출 필요가 없습니다. 노드 최소 크기는 256 B, bufferImageGranularity,
+//   nonCoherentAtomSize 중 큰 값에서 시작하고 (host visible 타입은 map 주소 - offset 이 맞도록
+//   minMemoryMapAlignment 이상), bind 에서 더 큰 alignment 를 보면 그 메모리 타입의 최소 크기를 올립니다.
+//   이미 잡은 노드가 alignment 를 맞추지 못하면 아직 bind / map 하지 않은 경우 맞는 노드로 옮기고,
+//   옮길 수 없으면 bind 를 실패시킵니다. (어긋난 offset 은 드라이버에 넘기지 않습니다)
+//   pNext 가 있는 할당 (dedicated, export/import, device address 등) 과 lazily allocated / protected
+//   타입은 그대로 넘깁니다. 레이어가 번역하지 않는 경로로 메모리 핸들이 넘어갈 수 있으므로, 켜진 확장이
+//   모두 허용 목록 (device_memory.cpp) 에 있고 sparse binding / private data 기능이 꺼져 있을 때만
+//   suballocation 을 켭니다.
+//
+// 설정:
+//   debug.my_layer.memory              0 = 끔, 1 = census (기본), 2 = census + suballocation
+//   debug.my_layer.suballoc_max_kb     이 크기 이하만 suballocation (기본 256)
+//   debug.my_layer.suballoc_block_mb   블록 크기, 2의 거듭제곱으로 올림 (기본 16)
+
+class DeviceMemoryTracker {
+public:
+    struct Block;
+
+    // 레이어가 앱에 돌려주는 VkDeviceMemory 는 이 구조체의 주소입니다.
+    struct SubAllocation {
+        VkDeviceMemory memory;      // 블록의 드라이버 메모리
+        VkDeviceSize offset;        // 블록 내 offset
+        VkDeviceSize node_size;     // buddy 노드 크기 (>= 앱이 요청한 크기)
+        VkDeviceSize size;          // 앱이 요청한 크기
+        uint32_t memory_type;
+        Block* block;
+        bool bound = false;         // 리소스를 bind 한 적이 있는지 (m_mutex 아래에서만)
+        bool mapped = false;        // 앱이 map 한 적이 있는지 (m_mutex 아래에서만)
+    };
+
+    // 설정이 꺼져 있으면 nullptr.
+    static std::unique_ptr<DeviceMemoryTracker> create(
+        VkDevice device,
+        const DeviceDispatchTable* dispatch,
+        const VkPhysicalDeviceProperties& properties,
+        const VkPhysicalDeviceMemoryProperties& memory_properties,
+        const VkDeviceCreateInfo* create_info);
+
+    // census 를 남기고 블록을 해제합니다. 디바이스 파괴 전에 호출해야 합니다.
+    ~DeviceMemoryTracker();
+
+    DeviceMemoryTracker(const DeviceMemoryTracker&) = delete;
+    DeviceMemoryTracker& operator=(const DeviceMemoryTracker&) = delete;
+
+    VkResult allocate(const VkMemoryAllocateInfo* allocate_info, const VkAllocationCallbacks* allocator,
+                      VkDeviceMemory* memory);
+    void free(VkDeviceMemory memory, const VkAllocationCallbacks* allocator);
+
+    // 앱 핸들이 suballocation 이면 그 정보를, 아니면 nullptr. 조회는 lock 이 없습니다.
+    const SubAllocation* find(VkDeviceMemory memory) const {
+        if (!m_suballocate || memory == VK_NULL_HANDLE) return nullptr;
+        const void* key = suballocation_key(memory);
+        return key ? m_suballocations.find(key) : nullptr;
+    }
+
+    // (memory, offset) 을 드라이버 기준으로 바꿉니다. suballocation 이 아니면 그대로 둡니다.
+    void translate(VkDeviceMemory* memory, VkDeviceSize* offset) const {
+        if (const SubAllocation* sub = find(*memory)) {
+            *memory = sub->memory;
+            *offset += sub->offset;
+        }
+    }
+
+    // vkBind*Memory 용 translate. suballocation 의 노드가 alignment 를 맞추지 못하면 맞는 노드로 옮기고,
+    // 옮길 수 없으면 (이미 bind / map 됨) 에러를 돌려줍니다. 이때 *memory / *offset 은 그대로입니다.
+    VkResult translate_bind(VkDeviceMemory* memory, VkDeviceSize* offset, VkDeviceSize alignment);
+
+    struct BindTranslation {
+        VkDeviceMemory* memory;
+        VkDeviceSize* offset;
+        VkDeviceSize alignment;
+    };
+    // vkBind*Memory2 용. 모두 맞출 수 있을 때만 노드를 옮기고 bound 로 표시합니다. 하나라도 실패하면
+    // 아무것도 바꾸지 않습니다.
+    VkResult translate_binds(const BindTranslation* binds, uint32_t count);
+
+    // suballocation 은 블록 전체를 한 번 map 해 두고 그 안의 주소를 돌려줍니다.
+    VkResult map(const SubAllocation* sub, VkDeviceSize offset, void** data);
+
+    // 주기 리포트용 요약 한 줄 / vkDestroyDevice 용 상세
+    void log_summary(const char* prefix);
+    void log_census(const char* when);
+
+private:
+    struct TypeCensus {
+        uint64_t live_count = 0;     // 앱 기준
+        uint64_t live_bytes = 0;
+        uint64_t peak_bytes = 0;
+        uint64_t driver_count = 0;   // 드라이버 기준 (직접 할당 + 블록)
+        uint64_t driver_bytes = 0;
+        uint64_t suballocated = 0;   // 누적
+    };
+
+    struct DirectAllocation {
+        VkDeviceSize size;
+        uint32_t memory_type;
+    };
+
+    DeviceMemoryTracker(VkDevice device, const DeviceDispatchTable* dispatch,
+                        const VkPhysicalDeviceMemoryProperties& memory_properties, uint32_t allocation_limit);
+
+    bool can_suballocate(const VkMemoryAllocateInfo* allocate_info) const;
+    VkResult suballocate(const VkMemoryAllocateInfo* allocate_info, VkDeviceMemory* memory);
+    void move_to_bin_locked(Block* block, int bin);
+    Block* create_block_locked(uint32_t memory_type);
+    bool allocate_node_locked(uint32_t memory_type, VkDeviceSize node_size, SubAllocation* sub);
+    VkDeviceMemory free_node_locked(const SubAllocation& sub);
+    void free_suballocation(std::unique_ptr<SubAllocation> sub);
+    void log_totals_locked(const char* prefix);
+    void publish_telemetry_locked();
+
+    VkDevice m_device;
+    const DeviceDispatchTable* m_dispatch;
+    VkPhysicalDeviceMemoryProperties m_memory_properties;
+    uint32_t m_allocation_limit;
+
+    bool m_suballocate = false;
+    VkDeviceSize m_suballoc_max_size = 0;
+    VkDeviceSize m_block_size = 0;
+    VkDeviceSize m_min_node_size = 0;
+    uint32_t m_max_order = 0;  // 블록 = m_min_node_size << m_max_order
+
+    // 할당 / 해제는 hot path 가 아니므로 mutex 하나로 census 와 블록을 함께 보호합니다.
+    std::mutex m_mutex;
+    TypeCensus m_census[VK_MAX_MEMORY_TYPES];
+    // 타입별 노드 최소 크기 (host visible 은 minMemoryMapAlignment, bind 에서 본 alignment)
+    VkDeviceSize m_type_min_node_size[VK_MAX_MEMORY_TYPES] = {};
+    Histogram m_allocation_sizes;  // m_mutex 아래에서만 기록
+    std::unordered_map<VkDeviceMemory, DirectAllocation> m_direct;
+    std::vector<std::unique_ptr<Block>> m_blocks[VK_MAX_MEMORY_TYPES];
+    std::vector<Block*> m_free_bins[VK_MAX_MEMORY_TYPES];  // 가장 큰 빈 order 별 블록 목록 (꽉 찬 블록은 없음)
+    // 키는 SubAllocation 자신의 주소. 앱에 돌려준 핸들도 같은 값입니다.
+    HandleMap<SubAllocation> m_suballocations;
+
+    // 32-bit 에서는 드라이버 핸들이 포인터보다 넓을 수 있습니다. 포인터로 표현되지 않으면 suballocation 이 아닙니다.
+    static const void* suballocation_key(VkDeviceMemory memory) {
+        uint64_t value = (uint64_t)memory;
+        return value <= UINTPTR_MAX ? (const void*)(uintptr_t)value : nullptr;
+    }
+};
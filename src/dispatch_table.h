@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "vk_commands.h"
+
+// 다음 레이어/드라이버의 함수 포인터 테이블.
+// vkCreateInstance / vkCreateDevice 시점에 한 번만 채우고 이후에는 읽기만 합니다.
+// 다음 체인이 지원하지 않는 명령은 nullptr 로 남습니다.
+
+struct InstanceDispatchTable {
+    PFN_vkGetInstanceProcAddr GetInstanceProcAddr;
+#define MY_LAYER_DISPATCH_MEMBER(name) PFN_vk##name name;
+    MY_LAYER_INSTANCE_COMMANDS(MY_LAYER_DISPATCH_MEMBER)
+#undef MY_LAYER_DISPATCH_MEMBER
+};
+
+struct DeviceDispatchTable {
+    PFN_vkGetDeviceProcAddr GetDeviceProcAddr;
+#define MY_LAYER_DISPATCH_MEMBER(name) PFN_vk##name name;
+    MY_LAYER_DEVICE_COMMANDS(MY_LAYER_DISPATCH_MEMBER)
+#undef MY_LAYER_DISPATCH_MEMBER
+};
+
+inline void init_instance_dispatch_table(
+    InstanceDispatchTable* table,
+    VkInstance instance,
+    PFN_vkGetInstanceProcAddr next_pfnGetInstanceProcAddr)
+{
+    table->GetInstanceProcAddr = next_pfnGetInstanceProcAddr;
+#define MY_LAYER_DISPATCH_INIT(name) \
+    table->name = (PFN_vk##name)next_pfnGetInstanceProcAddr(instance, "vk" #name);
+    MY_LAYER_INSTANCE_COMMANDS(MY_LAYER_DISPATCH_INIT)
+#undef MY_LAYER_DISPATCH_INIT
+}
+
+inline void init_device_dispatch_table(
+    DeviceDispatchTable* table,
+    VkDevice device,
+    PFN_vkGetDeviceProcAddr next_pfnGetDeviceProcAddr)
+{
+    table->GetDeviceProcAddr = next_pfnGetDeviceProcAddr;
+#define MY_LAYER_DISPATCH_INIT(name) \
+    table->name = (PFN_vk##name)next_pfnGetDeviceProcAddr(device, "vk" #name);
+    MY_LAYER_DEVICE_COMMANDS(MY_LAYER_DISPATCH_INIT)
+#undef MY_LAYER_DISPATCH_INIT
+}
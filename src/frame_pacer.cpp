@@ -0,0 +1,150 @@
+#include "frame_pacer.h"
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <ctime>
+#include <thread>
+
+#include "clock.h"
+#include "layer_data.h"
+#include "utils.h"
+
+FramePacerConfig frame_pacer_config(const LayerSettings& settings, bool display_timing) {
+    FramePacerConfig config;
+    config.interval_ns = settings.pace_fps ? 1000000000ull / settings.pace_fps : 0;
+    config.refresh_divisor = (uint32_t)settings.pace_refresh_divisor;
+    config.refresh_ns = 1000000000ull / (settings.refresh_hz ? settings.refresh_hz : 60);
+    config.display_timing = display_timing;
+    config.low_latency = settings.pace_mode != 0;
+    config.spin_ns = settings.pace_spin_us * 1000;
+    return config;
+}
+
+bool display_timing_enabled(const VkDeviceCreateInfo* create_info) {
+    for (uint32_t i = 0; i < create_info->enabledExtensionCount; ++i) {
+        if (strcmp(create_info->ppEnabledExtensionNames[i], VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 이번 present 의 목표 간격. 주사율은 스왑체인이나 refresh_hz 가 바뀔 때만 다시 조회합니다.
+static uint64_t target_interval_ns(LayerQueueData* queue_data, const FramePacerConfig& config,
+                                   const VkPresentInfoKHR* present_info) {
+    if (config.interval_ns) return config.interval_ns;
+
+    LayerDeviceData* device_data = queue_data->device_data;
+    QueuePacer& pacer = queue_data->pacer;
+    VkSwapchainKHR swapchain = present_info->swapchainCount ? present_info->pSwapchains[0] : VK_NULL_HANDLE;
+    if (pacer.refresh_ns == 0 || swapchain != pacer.refresh_swapchain || config.refresh_ns != pacer.fallback_ns) {
+        pacer.refresh_swapchain = swapchain;
+        pacer.fallback_ns = config.refresh_ns;
+        pacer.refresh_ns = config.refresh_ns;
+        VkRefreshCycleDurationGOOGLE refresh = {};
+        if (config.display_timing && swapchain != VK_NULL_HANDLE &&
+            device_data->dispatch.GetRefreshCycleDurationGOOGLE(device_data->device, swapchain, &refresh) ==
+                VK_SUCCESS &&
+            refresh.refreshDuration != 0) {
+            pacer.refresh_ns = refresh.refreshDuration;
+        }
+    }
+    return pacer.refresh_ns * config.refresh_divisor;
+}
+
+// deadline 까지 기다립니다. spin_ns 전까지는 자고, 나머지는 spin 합니다. 기다린 시간을 돌려줍니다.
+// monotonic_now_ns() 는 CLOCK_MONOTONIC 기준이므로 절대 시각으로 clock_nanosleep 할 수 있습니다.
+static uint64_t wait_until(uint64_t deadline_ns, uint64_t spin_ns) {
+    uint64_t begin_ns = monotonic_now_ns();
+    if (begin_ns >= deadline_ns) return 0;
+
+    if (deadline_ns - begin_ns > spin_ns) {
+        uint64_t wake_ns = deadline_ns - spin_ns;
+        timespec wake = {(time_t)(wake_ns / 1000000000ull), (long)(wake_ns % 1000000000ull)};
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, nullptr) == EINTR) {}
+    }
+    uint64_t now_ns;
+    while ((now_ns = monotonic_now_ns()) < deadline_ns) std::this_thread::yield();
+    return now_ns - begin_ns;
+}
+
+static void add_relaxed(std::atomic<uint64_t>& counter, uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+uint64_t frame_pacer_before_wake_ns(QueuePacer& pacer, const FramePacerConfig& config, uint64_t interval_ns,
+                                    uint64_t now_ns) {
+    // 한 간격 넘게 밀렸으면 (로딩, 백그라운드, 페이싱을 껐다 켠 경우 등) 이번 작업 시간은 평균에 넣지 않습니다.
+    if (pacer.resume_ns != 0 && pacer.deadline_ns != 0 && now_ns <= pacer.deadline_ns + interval_ns) {
+        uint64_t work_ns = now_ns - pacer.resume_ns;
+        pacer.work_average_ns = pacer.work_average_ns == 0 ? work_ns : (pacer.work_average_ns * 7 + work_ns) / 8;
+    }
+    return config.low_latency ? 0 : pacer.deadline_ns;
+}
+
+void frame_pacer_on_present(QueuePacer& pacer, uint64_t interval_ns, uint64_t now_ns) {
+    if (pacer.deadline_ns != 0) {
+        uint64_t error_ns = now_ns > pacer.deadline_ns ? now_ns - pacer.deadline_ns : pacer.deadline_ns - now_ns;
+        pacer.error_ns.record(error_ns);
+        if (now_ns > pacer.deadline_ns + interval_ns / 10) add_relaxed(pacer.late_count, 1);
+    }
+
+    // 한 간격 넘게 밀렸으면 (로딩, 백그라운드 등) 밀린 만큼 따라잡지 않고 지금부터 다시 셉니다.
+    if (pacer.deadline_ns == 0 || now_ns > pacer.deadline_ns + interval_ns) {
+        pacer.deadline_ns = now_ns + interval_ns;
+    } else {
+        pacer.deadline_ns += interval_ns;
+    }
+}
+
+uint64_t frame_pacer_after_wake_ns(const QueuePacer& pacer, const FramePacerConfig& config) {
+    if (!config.low_latency) return 0;
+    uint64_t work_ns = pacer.work_average_ns + pacer.work_average_ns / 8;
+    return pacer.deadline_ns > work_ns ? pacer.deadline_ns - work_ns : 0;
+}
+
+void frame_pacer_before_present(LayerQueueData* queue_data, const FramePacerConfig& config,
+                                const VkPresentInfoKHR* present_info) {
+    QueuePacer& pacer = queue_data->pacer;
+    uint64_t interval_ns = target_interval_ns(queue_data, config, present_info);
+    uint64_t now_ns = monotonic_now_ns();
+    uint64_t wake_ns = frame_pacer_before_wake_ns(pacer, config, interval_ns, now_ns);
+    if (wake_ns != 0) {
+        add_relaxed(pacer.wait_ns, wait_until(wake_ns, config.spin_ns));
+        now_ns = monotonic_now_ns();
+    }
+    frame_pacer_on_present(pacer, interval_ns, now_ns);
+}
+
+void frame_pacer_after_present(LayerQueueData* queue_data, const FramePacerConfig& config) {
+    QueuePacer& pacer = queue_data->pacer;
+    uint64_t wake_ns = frame_pacer_after_wake_ns(pacer, config);
+    if (wake_ns != 0) add_relaxed(pacer.wait_ns, wait_until(wake_ns, config.spin_ns));
+    pacer.resume_ns = monotonic_now_ns();
+}
+
+void log_frame_pacer_stats(const char* prefix, LayerQueueData* queue_data, bool interval) {
+    QueuePacer& pacer = queue_data->pacer;
+    Histogram::Snapshot current;
+    Histogram::Snapshot errors;
+    pacer.error_ns.snapshot(&current);
+    uint64_t late = pacer.late_count.load(std::memory_order_relaxed);
+    uint64_t wait_ns = pacer.wait_ns.load(std::memory_order_relaxed);
+    if (interval) {
+        Histogram::diff(current, pacer.last_error_ns, &errors);
+        pacer.last_error_ns = current;
+        late -= pacer.last_late_count;
+        pacer.last_late_count += late;
+        wait_ns -= pacer.last_wait_ns;
+        pacer.last_wait_ns += wait_ns;
+    } else {
+        errors = current;
+    }
+    if (errors.total == 0) return;
+
+    ALOGI("%s: queue %p %" PRIu64 " frames, error p50 %.2f ms p99 %.2f ms, %" PRIu64 " late, wait %.2f ms/frame",
+          prefix, (void*)queue_data->queue, errors.total,
+          (double)Histogram::percentile(errors, 0.50) / 1e6, (double)Histogram::percentile(errors, 0.99) / 1e6,
+          late, (double)wait_ns / 1e6 / (double)errors.total);
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <cstdint>
+
+#include "histogram.h"
+#include "settings.h"
+
+// vkQueuePresentKHR 프레임 페이싱 (opt-in).
+//
+// 목표 fps (또는 화면 주사율 / N) 로 present 간격을 제한해서 uncapped 렌더링으로 인한 발열 throttling 을
+// 막습니다. 목표 시각 (deadline) 은 직전 deadline + 간격으로 예측하고, 한 간격 넘게 밀리면 현재 시각에서
+// 다시 시작합니다. 대기는 deadline 직전까지 clock_nanosleep 으로 자고 남은 spin 구간만 spin 합니다.
+//
+// 모드:
+//   0: present 를 드라이버에 넘기기 전에 deadline 까지 기다립니다. 완성된 프레임을 잡아 두는 셈이라
+//      간격은 가장 고르지만 그만큼 입력 지연이 늘어납니다.
+//   1 (기본): present 는 바로 넘기고, present 에서 돌아가기 전에 기다려서 다음 프레임의 CPU 작업 시작을
+//      늦춥니다. 깨어나는 시각은 다음 deadline - 예측 CPU 작업 시간 (present 에서 돌아간 뒤 다음 present
+//      까지의 이동 평균 + 12.5%) 이라, 큐에 프레임이 쌓이지 않고 입력은 최대한 늦게 읽힙니다.
+//
+// present 시각과 deadline 의 차이 (pacing error) 를 큐별 히스토그램에 기록하고, 프레임 프로파일러
+// 리포트와 vkDestroyDevice 에서 p50/p99, 간격의 10% 넘게 늦은 프레임 수, 프레임당 대기 시간을 남깁니다.
+//
+// 설정 (debug.my_layer.<key>.<패키지> 가 있으면 우선합니다, settings.h 참고). 모두 present 마다 현재 설정
+// 스냅샷에서 읽으므로, 설정을 바꾸면 다음 감시 주기 (settings_watch_ms) 뒤의 프레임부터 적용됩니다:
+//   debug.my_layer.pace_fps              목표 fps (기본 0 = 끔)
+//   debug.my_layer.pace_refresh_divisor  pace_fps 가 0 일 때 화면 주사율 / N 으로 제한 (기본 0 = 끔)
+//   debug.my_layer.refresh_hz            VK_GOOGLE_display_timing 을 쓸 수 없을 때의 주사율 (기본 60)
+//   debug.my_layer.pace_mode             0 = present 전 대기, 1 = present 후 대기 (기본 1)
+//   debug.my_layer.pace_spin_us          deadline 전 이 시간은 sleep 대신 spin (기본 500)
+
+struct LayerDeviceData;
+struct LayerQueueData;
+
+struct FramePacerConfig {
+    uint64_t interval_ns = 0;       // pace_fps 로 정한 간격. 0 이면 refresh_divisor 를 봅니다.
+    uint32_t refresh_divisor = 0;
+    uint64_t refresh_ns = 0;        // VK_GOOGLE_display_timing 을 쓸 수 없을 때의 주사율 간격
+    bool display_timing = false;    // 앱이 VK_GOOGLE_display_timing 을 켰는지
+    bool low_latency = true;
+    uint64_t spin_ns = 0;
+};
+
+inline bool frame_pacer_enabled(const LayerSettings& settings) {
+    return settings.pace_fps != 0 || settings.pace_refresh_divisor != 0;
+}
+
+// display_timing: 앱이 VK_GOOGLE_display_timing 을 켰는지 (vkCreateDevice 에서 정해짐)
+FramePacerConfig frame_pacer_config(const LayerSettings& settings, bool display_timing);
+
+bool display_timing_enabled(const VkDeviceCreateInfo* create_info);
+
+struct QueuePacer {
+    Histogram error_ns;
+    std::atomic<uint64_t> late_count{0};
+    std::atomic<uint64_t> wait_ns{0};
+
+    // present 하는 스레드만 사용
+    uint64_t deadline_ns = 0;       // 다음 present 목표 시각. 0 이면 아직 시작 전
+    uint64_t work_average_ns = 0;   // present 에서 돌아간 뒤 다음 present 까지 (모드 1)
+    uint64_t resume_ns = 0;         // 마지막으로 present 에서 돌아간 시각 (모드 1)
+    VkSwapchainKHR refresh_swapchain = VK_NULL_HANDLE;
+    uint64_t refresh_ns = 0;        // refresh_swapchain 의 주사율 간격
+    uint64_t fallback_ns = 0;       // refresh_ns 를 조회할 때의 config.refresh_ns (refresh_hz)
+
+    // 리포트하는 스레드만 사용 (직전 리포트 시점의 누적값)
+    Histogram::Snapshot last_error_ns;
+    uint64_t last_late_count = 0;
+    uint64_t last_wait_ns = 0;
+};
+
+// vkQueuePresentKHR 훅에서 드라이버 호출 전 / 후에 부릅니다. frame_pacer_enabled() 일 때만 호출합니다.
+void frame_pacer_before_present(LayerQueueData* queue_data, const FramePacerConfig& config,
+                                const VkPresentInfoKHR* present_info);
+void frame_pacer_after_present(LayerQueueData* queue_data, const FramePacerConfig& config);
+
+// 위 두 함수의 계산 부분. 시계와 대기 없이 현재 시각 (now_ns) 을 받습니다.
+//   frame_pacer_before_wake_ns: present 전. 작업 시간 평균을 갱신하고, 모드 0 이면 present 전에 기다릴
+//     시각 (deadline) 을 돌려줍니다. 기다리지 않으면 0.
+//   frame_pacer_on_present: 드라이버에 넘기는 시각. pacing error / 늦은 프레임을 기록하고 다음 deadline 을
+//     정합니다.
+//   frame_pacer_after_wake_ns: present 후. 모드 1 이면 다음 프레임의 작업을 시작할 시각을 돌려줍니다.
+uint64_t frame_pacer_before_wake_ns(QueuePacer& pacer, const FramePacerConfig& config, uint64_t interval_ns,
+                                    uint64_t now_ns);
+void frame_pacer_on_present(QueuePacer& pacer, uint64_t interval_ns, uint64_t now_ns);
+uint64_t frame_pacer_after_wake_ns(const QueuePacer& pacer, const FramePacerConfig& config);
+
+// 직전 리포트 이후 구간 (interval = true) 또는 누적 통계를 로그로 남깁니다.
+void log_frame_pacer_stats(const char* prefix, LayerQueueData* queue_data, bool interval);
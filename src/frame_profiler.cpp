@@ -0,0 +1,243 @@
+#include "frame_profiler.h"
+
+#include <cinttypes>
+
+#include "layer_data.h"
+#include "settings.h"
+#include "utils.h"
+
+FrameProfilerConfig load_frame_profiler_config() {
+    FrameProfilerConfig config;
+    const LayerSettings& settings = layer_settings();
+    config.enabled = settings.profile;
+    config.report_interval_ns = settings.profile_interval_ms * 1000000ull;
+    config.stutter_percent = (uint32_t)settings.stutter_percent;
+    return config;
+}
+
+void frame_profiler_on_submit(LayerQueueData* queue_data, uint64_t cpu_ns) {
+    QueueProfile& profile = queue_data->profile;
+    profile.submit_cpu_ns.record(cpu_ns);
+    profile.submit_count.store(profile.submit_count.load(std::memory_order_relaxed) + 1,
+                               std::memory_order_relaxed);
+}
+
+static double ns_to_ms(uint64_t ns) {
+    return (double)ns / 1e6;
+}
+
+static double ns_to_us(uint64_t ns) {
+    return (double)ns / 1e3;
+}
+
+// 직전 리포트 이후 구간의 통계를 큐마다 출력합니다.
+static void report(LayerDeviceData* device_data, uint64_t elapsed_ns) {
+    Histogram::Snapshot current;
+    Histogram::Snapshot interval;
+
+    uint32_t queue_count = device_data->queue_count.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < queue_count; ++i) {
+        LayerQueueData* queue_data = device_data->queues[i];
+        QueueProfile& profile = queue_data->profile;
+
+        uint64_t submits = profile.submit_count.load(std::memory_order_relaxed);
+        uint64_t stutters = profile.stutter_count.load(std::memory_order_relaxed);
+
+        profile.frame_interval_ns.snapshot(&current);
+        Histogram::diff(current, profile.last_frame_interval_ns, &interval);
+        profile.last_frame_interval_ns = current;
+        uint64_t frames = interval.total;
+        if (frames > 0) {
+            ALOGI("profile: queue %p %" PRIu64 " frames (%.1f fps), frame p50 %.2f ms p95 %.2f ms p99 %.2f ms, "
+                  "%" PRIu64 " stutters",
+                  (void*)queue_data->queue, frames, (double)frames * 1e9 / (double)elapsed_ns,
+                  ns_to_ms(Histogram::percentile(interval, 0.50)),
+                  ns_to_ms(Histogram::percentile(interval, 0.95)),
+                  ns_to_ms(Histogram::percentile(interval, 0.99)),
+                  stutters - profile.last_stutter_count);
+
+            Histogram::Snapshot present_interval;
+            profile.present_cpu_ns.snapshot(&current);
+            Histogram::diff(current, profile.last_present_cpu_ns, &present_interval);
+            profile.last_present_cpu_ns = current;
+
+            profile.submits_per_frame.snapshot(&current);
+            Histogram::diff(current, profile.last_submits_per_frame, &interval);
+            profile.last_submits_per_frame = current;
+
+            ALOGI("profile: queue %p present cpu p50 %.1f us p99 %.1f us, submits/frame p50 %" PRIu64 " p99 %" PRIu64,
+                  (void*)queue_data->queue,
+                  ns_to_us(Histogram::percentile(present_interval, 0.50)),
+                  ns_to_us(Histogram::percentile(present_interval, 0.99)),
+                  Histogram::percentile(interval, 0.50),
+                  Histogram::percentile(interval, 0.99));
+
+            if (device_data->command_stats_enabled) {
+                Histogram::Snapshot draws;
+                Histogram::Snapshot dispatches;
+                profile.draws_per_frame.snapshot(&current);
+                Histogram::diff(current, profile.last_draws_per_frame, &draws);
+                profile.last_draws_per_frame = current;
+                profile.dispatches_per_frame.snapshot(&current);
+                Histogram::diff(current, profile.last_dispatches_per_frame, &dispatches);
+                profile.last_dispatches_per_frame = current;
+                profile.state_changes_per_frame.snapshot(&current);
+                Histogram::diff(current, profile.last_state_changes_per_frame, &interval);
+                profile.last_state_changes_per_frame = current;
+
+                ALOGI("profile: queue %p per frame draws p50 %" PRIu64 " p99 %" PRIu64 ", dispatches p50 %" PRIu64
+                      " p99 %" PRIu64 ", state changes p50 %" PRIu64 " p99 %" PRIu64,
+                      (void*)queue_data->queue,
+                      Histogram::percentile(draws, 0.50), Histogram::percentile(draws, 0.99),
+                      Histogram::percentile(dispatches, 0.50), Histogram::percentile(dispatches, 0.99),
+                      Histogram::percentile(interval, 0.50), Histogram::percentile(interval, 0.99));
+            }
+        }
+
+        if (submits != profile.last_submit_count) {
+            profile.submit_cpu_ns.snapshot(&current);
+            Histogram::diff(current, profile.last_submit_cpu_ns, &interval);
+            profile.last_submit_cpu_ns = current;
+
+            ALOGI("profile: queue %p (family %u) %" PRIu64 " submits, submit cpu p50 %.1f us p95 %.1f us p99 %.1f us",
+                  (void*)queue_data->queue, queue_data->family_index, submits - profile.last_submit_count,
+                  ns_to_us(Histogram::percentile(interval, 0.50)),
+                  ns_to_us(Histogram::percentile(interval, 0.95)),
+                  ns_to_us(Histogram::percentile(interval, 0.99)));
+        }
+
+        if (frame_pacer_enabled(layer_settings())) log_frame_pacer_stats("profile: pacing", queue_data, true);
+
+        profile.last_submit_count = submits;
+        profile.last_stutter_count = stutters;
+    }
+
+    if (device_data->memory) device_data->memory->log_summary("profile: memory");
+
+    if (device_data->state_filter.enabled) {
+        StateFilterTotals& totals = device_data->state_filter_totals;
+        StateFilterStats current_filtered = totals.load();
+        StateFilterStats interval_filtered = current_filtered;
+        interval_filtered.subtract(totals.last_reported);
+        totals.last_reported = current_filtered;
+        if (interval_filtered.total() > 0) log_state_filter_stats("profile: state filter", interval_filtered);
+    }
+}
+
+// 주기가 지났으면 한 스레드만 리포트하도록 next_report_ns 를 CAS 로 넘깁니다.
+static void maybe_report(LayerDeviceData* device_data, uint64_t now_ns) {
+    DeviceProfile& profile = device_data->profile;
+    uint64_t interval_ns = profile.config.report_interval_ns;
+    if (interval_ns == 0) return;
+
+    uint64_t next_report_ns = profile.next_report_ns.load(std::memory_order_relaxed);
+    if (next_report_ns == 0) {
+        profile.next_report_ns.compare_exchange_strong(next_report_ns, now_ns + interval_ns,
+                                                       std::memory_order_relaxed);
+        return;
+    }
+    if (now_ns < next_report_ns) return;
+    if (!profile.next_report_ns.compare_exchange_strong(next_report_ns, now_ns + interval_ns,
+                                                        std::memory_order_acquire)) {
+        return;
+    }
+    report(device_data, now_ns - (next_report_ns - interval_ns));
+}
+
+void frame_profiler_on_present(LayerQueueData* queue_data, uint64_t begin_ns, uint64_t end_ns) {
+    QueueProfile& profile = queue_data->profile;
+    LayerDeviceData* device_data = queue_data->device_data;
+
+    profile.present_cpu_ns.record(end_ns - begin_ns);
+
+    // submit 은 다른 큐 (ex. async compute) 에서 올 수 있으므로 디바이스 전체를 셉니다.
+    uint64_t device_submits = 0;
+    CommandStats device_commands;
+    uint32_t queue_count = device_data->queue_count.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < queue_count; ++i) {
+        LayerQueueData* queue = device_data->queues[i];
+        device_submits += queue->profile.submit_count.load(std::memory_order_relaxed);
+        queue->submitted_commands.accumulate_into(&device_commands);
+    }
+
+    TelemetryRegion* telemetry = telemetry_region();
+    if (telemetry && !profile.telemetry_claimed) {
+        profile.telemetry_ring = telemetry_claim_ring(telemetry, (uint64_t)(uintptr_t)queue_data->queue);
+        profile.telemetry_claimed = true;
+    }
+
+    if (profile.last_present_ns != 0) {
+        uint64_t frame_ns = begin_ns - profile.last_present_ns;
+        uint64_t frame_submits = device_submits - profile.device_submits_at_last_present;
+        profile.frame_interval_ns.record(frame_ns);
+        profile.submits_per_frame.record(frame_submits);
+
+        CommandStats frame_commands;
+        if (device_data->command_stats_enabled) {
+            frame_commands = device_commands;
+            frame_commands.subtract(profile.device_commands_at_last_present);
+            profile.draws_per_frame.record(frame_commands.draws);
+            profile.dispatches_per_frame.record(frame_commands.dispatches);
+            profile.state_changes_per_frame.record(frame_commands.state_changes());
+
+            ALOGD("frame: %.2f ms, draws %" PRIu64 ", dispatches %" PRIu64 ", pipelines %" PRIu64
+                  ", descriptor sets %" PRIu64 ", vertex buffers %" PRIu64 ", push constants %" PRIu64
+                  ", render passes %" PRIu64 " (ended %" PRIu64 ")",
+                  ns_to_ms(frame_ns), frame_commands.draws, frame_commands.dispatches,
+                  frame_commands.pipeline_binds, frame_commands.descriptor_set_binds,
+                  frame_commands.vertex_buffer_binds, frame_commands.push_constants,
+                  frame_commands.render_passes, frame_commands.render_pass_ends);
+        }
+
+        bool stutter = profile.frame_average_ns != 0 &&
+            frame_ns * 100 > profile.frame_average_ns * device_data->profile.config.stutter_percent;
+        if (stutter) {
+            profile.stutter_count.store(profile.stutter_count.load(std::memory_order_relaxed) + 1,
+                                        std::memory_order_relaxed);
+        }
+        // 최근 프레임 위주의 이동 평균 (1/8 가중치)
+        profile.frame_average_ns = profile.frame_average_ns == 0
+            ? frame_ns : (profile.frame_average_ns * 7 + frame_ns) / 8;
+
+        if (profile.telemetry_ring) {
+            TelemetryFrameRecord record = {};
+            record.present_ns = begin_ns;
+            record.frame_ns = frame_ns;
+            record.present_cpu_us = (uint32_t)((end_ns - begin_ns) / 1000);
+            record.submits = (uint32_t)frame_submits;
+            record.draws = (uint32_t)frame_commands.draws;
+            record.dispatches = (uint32_t)frame_commands.dispatches;
+            record.state_changes = (uint32_t)frame_commands.state_changes();
+            record.flags = stutter ? kTelemetryFrameStutter : 0;
+            telemetry_publish(profile.telemetry_ring, record);
+        }
+        if (telemetry) {
+            // 큐가 여럿이면 동시에 present 할 수 있으므로 프레임 / stutter 만 RMW 로 더합니다.
+            TelemetryHeader& header = telemetry->header;
+            header.counters[(size_t)TelemetryCounter::frames].fetch_add(1, std::memory_order_relaxed);
+            if (stutter) header.counters[(size_t)TelemetryCounter::stutters].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (telemetry) {
+        telemetry_set_counter(telemetry, TelemetryCounter::submits, device_submits);
+        telemetry_set_counter(telemetry, TelemetryCounter::draws, device_commands.draws);
+        telemetry_set_counter(telemetry, TelemetryCounter::dispatches, device_commands.dispatches);
+        telemetry_set_counter(telemetry, TelemetryCounter::state_changes, device_commands.state_changes());
+        if (device_data->state_filter.enabled) {
+            telemetry_set_counter(telemetry, TelemetryCounter::state_filter_dropped,
+                                  device_data->state_filter_totals.load().total());
+        }
+        if (frame_pacer_enabled(layer_settings())) {
+            telemetry_set_counter(telemetry, TelemetryCounter::pacing_late,
+                                  queue_data->pacer.late_count.load(std::memory_order_relaxed));
+        }
+        telemetry_set_counter(telemetry, TelemetryCounter::log_dropped, log_dropped_count());
+        telemetry->header.update_ns.store(end_ns, std::memory_order_relaxed);
+    }
+    profile.last_present_ns = begin_ns;
+    profile.device_submits_at_last_present = device_submits;
+    profile.device_commands_at_last_present = device_commands;
+
+    maybe_report(device_data, end_ns);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "command_stats.h"
+#include "histogram.h"
+#include "telemetry.h"
+
+// vkQueueSubmit / vkQueueSubmit2 / vkQueuePresentKHR 기반 프레임 프로파일러.
+//
+// - submit/present 가 다음 체인(드라이버) 안에서 보낸 CPU 시간
+// - present 간격 (프레임 시간) 과 프레임당 submit 수
+// - 프레임당 draw / dispatch / state change 수 (command_stats.h)
+// 를 큐별 히스토그램에 기록하고, 설정한 주기마다 p50/p95/p99 와 stutter 수를 로그로 남깁니다.
+// 텔레메트리가 켜져 있으면 (telemetry.h) present 마다 프레임 레코드와 카운터도 공유 메모리에 씁니다.
+// 기록은 큐의 외부 동기화에 기대므로 hot path 에 lock 이나 RMW 가 없습니다.
+//
+// 설정:
+//   debug.my_layer.profile              0 이면 끔 (기본 1)
+//   debug.my_layer.profile_interval_ms  리포트 주기 (기본 5000, 0 이면 리포트 안 함)
+//   debug.my_layer.stutter_percent      직전 프레임 시간 평균 대비 이 비율을 넘으면 stutter (기본 200)
+
+struct LayerDeviceData;
+struct LayerQueueData;
+
+struct FrameProfilerConfig {
+    bool enabled = true;
+    uint64_t report_interval_ns = 0;
+    uint32_t stutter_percent = 200;
+};
+
+FrameProfilerConfig load_frame_profiler_config();
+
+struct QueueProfile {
+    Histogram submit_cpu_ns;
+    Histogram present_cpu_ns;
+    Histogram frame_interval_ns;
+    Histogram submits_per_frame;
+    Histogram draws_per_frame;
+    Histogram dispatches_per_frame;
+    Histogram state_changes_per_frame;
+    std::atomic<uint64_t> submit_count{0};
+    std::atomic<uint64_t> stutter_count{0};
+
+    // present 하는 스레드만 사용
+    uint64_t last_present_ns = 0;
+    uint64_t frame_average_ns = 0;
+    uint64_t device_submits_at_last_present = 0;
+    CommandStats device_commands_at_last_present;
+    TelemetryRing* telemetry_ring = nullptr;
+    bool telemetry_claimed = false;  // 링을 한 번 요청해 봤는지 (남은 링이 없어도 다시 시도하지 않음)
+
+    // 리포트하는 스레드만 사용 (직전 리포트 시점의 누적값)
+    Histogram::Snapshot last_submit_cpu_ns;
+    Histogram::Snapshot last_present_cpu_ns;
+    Histogram::Snapshot last_frame_interval_ns;
+    Histogram::Snapshot last_submits_per_frame;
+    Histogram::Snapshot last_draws_per_frame;
+    Histogram::Snapshot last_dispatches_per_frame;
+    Histogram::Snapshot last_state_changes_per_frame;
+    uint64_t last_submit_count = 0;
+    uint64_t last_stutter_count = 0;
+};
+
+struct DeviceProfile {
+    FrameProfilerConfig config;
+    std::atomic<uint64_t> next_report_ns{0};
+};
+
+void frame_profiler_on_submit(LayerQueueData* queue_data, uint64_t cpu_ns);
+void frame_profiler_on_present(LayerQueueData* queue_data, uint64_t begin_ns, uint64_t end_ns);
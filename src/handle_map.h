@@ -0,0 +1,205 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Dispatch key (또는 dispatchable handle) -> T 매핑.
+//
+// 조회(find)는 lock 없이 atomic load 만 사용하고, 삽입/삭제는 writer mutex 로 직렬화합니다.
+// Open addressing + linear probing 이며, 삭제된 슬롯은 tombstone 으로 남겨서
+// 조회 중인 스레드의 probe 체인이 끊기지 않도록 합니다.
+// 테이블이 차면 먼저 어떤 probe 체인에도 걸치지 않은 tombstone 을 제자리에서 비우고 (purge),
+// 그래도 부족할 때만 2배 이상 큰 새 테이블을 만들어 publish 합니다. 이전 테이블은 읽는 스레드가
+// 남아 있을 수 있으므로 맵이 파괴될 때까지 보관하지만, 크기가 매번 2배 이상이므로 보관 중인 이전
+// 테이블의 합은 현재 테이블보다 작습니다. (생성 / 파괴가 반복되어도 늘어나지 않음)
+//
+// 값(T)의 수명은 Vulkan 의 외부 동기화 규칙에 기댑니다. 앱은 객체를 파괴하는 도중에 같은 객체를
+// 사용할 수 없으므로, erase 로 꺼낸 값은 바로 해제해도 됩니다.
+template <typename T>
+class HandleMap {
+public:
+    HandleMap() {
+        m_table.store(allocate_table(kInitialCapacity), std::memory_order_relaxed);
+    }
+
+    ~HandleMap() {
+        Table* table = m_table.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < table->capacity; ++i) {
+            delete table->slots[i].value.load(std::memory_order_relaxed);
+        }
+    }
+
+    HandleMap(const HandleMap&) = delete;
+    HandleMap& operator=(const HandleMap&) = delete;
+
+    T* find(const void* key) const {
+        const Table* table = m_table.load(std::memory_order_acquire);
+        size_t mask = table->capacity - 1;
+        for (size_t i = hash(key, table->shift);; i = (i + 1) & mask) {
+            const Slot& slot = table->slots[i];
+            const void* slot_key = slot.key.load(std::memory_order_acquire);
+            if (slot_key == key) return slot.value.load(std::memory_order_acquire);
+            if (slot_key == kEmpty) return nullptr;
+        }
+    }
+
+    // 같은 키가 이미 있으면 값을 교체하고 이전 값을 해제합니다.
+    void insert(const void* key, std::unique_ptr<T> value) {
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        Table* table = m_table.load(std::memory_order_relaxed);
+
+        Slot* existing = find_slot(table, key);
+        if (existing) {
+            std::unique_ptr<T> old(existing->value.exchange(value.release(), std::memory_order_acq_rel));
+            return;
+        }
+
+        if ((table->used + 1) * 2 > table->capacity) {
+            purge_tombstones(table);
+            if ((table->used + 1) * 2 > table->capacity) table = grow(table);
+        }
+
+        size_t mask = table->capacity - 1;
+        for (size_t i = hash(key, table->shift);; i = (i + 1) & mask) {
+            Slot& slot = table->slots[i];
+            const void* slot_key = slot.key.load(std::memory_order_relaxed);
+            if (slot_key == kEmpty || slot_key == kTombstone) {
+                if (slot_key == kEmpty) table->used++;
+                slot.value.store(value.release(), std::memory_order_relaxed);
+                slot.key.store(key, std::memory_order_release);
+                table->live++;
+                return;
+            }
+        }
+    }
+
+    std::unique_ptr<T> erase(const void* key) {
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        Table* table = m_table.load(std::memory_order_relaxed);
+
+        Slot* slot = find_slot(table, key);
+        if (!slot) return nullptr;
+
+        std::unique_ptr<T> value(slot->value.exchange(nullptr, std::memory_order_acq_rel));
+        slot->key.store(kTombstone, std::memory_order_release);
+        table->live--;
+        return value;
+    }
+
+    // writer mutex 를 잡은 채로 모든 값을 순회합니다. (리포트 등 드문 경로용)
+    template <typename F>
+    void for_each(F&& fn) const {
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        const Table* table = m_table.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < table->capacity; ++i) {
+            T* value = table->slots[i].value.load(std::memory_order_relaxed);
+            if (value) fn(value);
+        }
+    }
+
+    // 보관 중인 모든 테이블 (현재 + 이전) 의 슬롯 수. 테스트용.
+    size_t retained_slot_count() const {
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        size_t count = 0;
+        for (const auto& table : m_tables) count += table->capacity;
+        return count;
+    }
+
+private:
+    static constexpr size_t kInitialCapacity = 16;
+    static inline const void* const kEmpty = nullptr;
+    static inline const void* const kTombstone = reinterpret_cast<const void*>(uintptr_t(1));
+
+    struct Slot {
+        std::atomic<const void*> key{nullptr};
+        std::atomic<T*> value{nullptr};
+    };
+
+    struct Table {
+        size_t capacity;
+        unsigned shift;
+        size_t used;    // live + tombstone
+        size_t live;
+        std::unique_ptr<Slot[]> slots;
+    };
+
+    // Fibonacci hashing. 상위 비트를 사용하므로 정렬된 포인터에도 고르게 분포합니다.
+    static size_t hash(const void* key, unsigned shift) {
+        uint64_t k = reinterpret_cast<uintptr_t>(key);
+        return static_cast<size_t>((k * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    Table* allocate_table(size_t capacity) {
+        auto table = std::make_unique<Table>();
+        table->capacity = capacity;
+        table->shift = 64;
+        for (size_t c = capacity; c > 1; c >>= 1) table->shift--;
+        table->used = 0;
+        table->live = 0;
+        table->slots = std::make_unique<Slot[]>(capacity);
+        Table* raw = table.get();
+        m_tables.push_back(std::move(table));
+        return raw;
+    }
+
+    Slot* find_slot(Table* table, const void* key) const {
+        size_t mask = table->capacity - 1;
+        for (size_t i = hash(key, table->shift);; i = (i + 1) & mask) {
+            Slot& slot = table->slots[i];
+            const void* slot_key = slot.key.load(std::memory_order_relaxed);
+            if (slot_key == key) return &slot;
+            if (slot_key == kEmpty) return nullptr;
+        }
+    }
+
+    // 살아있는 키의 probe 체인 (홈 슬롯 ~ 실제 슬롯) 밖에 있는 tombstone 을 empty 로 되돌립니다.
+    // 조회 중인 스레드는 자기 키의 체인만 지나가므로, 체인 밖의 슬롯이 empty 가 되어도 결과가 같습니다.
+    // 체인 안의 tombstone 은 항목을 옮겨야 지울 수 있으므로 그대로 둡니다. (다음 grow 에서 정리)
+    void purge_tombstones(Table* table) {
+        size_t mask = table->capacity - 1;
+        std::vector<bool> in_chain(table->capacity, false);
+        for (size_t i = 0; i < table->capacity; ++i) {
+            const void* key = table->slots[i].key.load(std::memory_order_relaxed);
+            if (key == kEmpty || key == kTombstone) continue;
+            for (size_t j = hash(key, table->shift); j != i; j = (j + 1) & mask) in_chain[j] = true;
+        }
+        for (size_t i = 0; i < table->capacity; ++i) {
+            Slot& slot = table->slots[i];
+            if (in_chain[i] || slot.key.load(std::memory_order_relaxed) != kTombstone) continue;
+            slot.key.store(kEmpty, std::memory_order_release);
+            table->used--;
+        }
+    }
+
+    // 살아있는 항목만 2배 이상 큰 새 테이블로 옮기고 publish 합니다. tombstone 은 여기서 정리됩니다.
+    Table* grow(Table* old_table) {
+        size_t capacity = old_table->capacity * 2;
+        while ((old_table->live + 1) * 4 > capacity) capacity *= 2;
+
+        Table* table = allocate_table(capacity);
+        size_t mask = table->capacity - 1;
+        for (size_t i = 0; i < old_table->capacity; ++i) {
+            const void* key = old_table->slots[i].key.load(std::memory_order_relaxed);
+            if (key == kEmpty || key == kTombstone) continue;
+
+            size_t j = hash(key, table->shift);
+            while (table->slots[j].key.load(std::memory_order_relaxed) != kEmpty) j = (j + 1) & mask;
+            table->slots[j].value.store(old_table->slots[i].value.load(std::memory_order_relaxed),
+                                        std::memory_order_relaxed);
+            table->slots[j].key.store(key, std::memory_order_relaxed);
+            table->used++;
+            table->live++;
+        }
+
+        m_table.store(table, std::memory_order_release);
+        return table;
+    }
+
+    std::atomic<Table*> m_table;
+    mutable std::mutex m_writer_mutex;
+    std::vector<std::unique_ptr<Table>> m_tables;  // publish 된 적 있는 모든 테이블 (이전 테이블 포함)
+};
@@ -0,0 +1,94 @@
+#include "hash.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+constexpr uint32_t kPrime1 = 0x9E3779B1u;
+constexpr uint32_t kPrime2 = 0x85EBCA77u;
+constexpr uint32_t kPrime3 = 0xC2B2AE3Du;
+
+constexpr uint32_t rotl32(uint32_t x, int r) {
+    return (x << r) | (x >> (32 - r));
+}
+
+constexpr uint32_t round32(uint32_t acc, uint32_t word) {
+    return rotl32(acc + word * kPrime2, 13) * kPrime1;
+}
+
+constexpr size_t kLanes = 16;
+
+// 워드 i 는 lane (i % 16) 에 누적됩니다. 벡터 4개를 독립적으로 돌려서 곱셈 지연을 가립니다.
+void accumulate_lanes(uint32_t acc[kLanes], const uint32_t* words, size_t block_count) {
+#if defined(__SSE2__)
+    // SSE2 에는 32bit lane 곱셈 (pmulld) 이 없으므로 pmuludq 두 번으로 만듭니다.
+    auto mullo = [](__m128i a, __m128i b) {
+        __m128i even = _mm_mul_epu32(a, b);
+        __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                  _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    };
+    auto round = [&](__m128i v, __m128i w) {
+        v = _mm_add_epi32(v, mullo(w, _mm_set1_epi32((int)kPrime2)));
+        v = _mm_or_si128(_mm_slli_epi32(v, 13), _mm_srli_epi32(v, 19));
+        return mullo(v, _mm_set1_epi32((int)kPrime1));
+    };
+    __m128i v[4];
+    for (int j = 0; j < 4; ++j) v[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + j * 4));
+    for (size_t i = 0; i < block_count; ++i) {
+        const __m128i* block = reinterpret_cast<const __m128i*>(words + i * kLanes);
+        for (int j = 0; j < 4; ++j) v[j] = round(v[j], _mm_loadu_si128(block + j));
+    }
+    for (int j = 0; j < 4; ++j) _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + j * 4), v[j]);
+#elif defined(__ARM_NEON)
+    const uint32x4_t prime1 = vdupq_n_u32(kPrime1);
+    const uint32x4_t prime2 = vdupq_n_u32(kPrime2);
+    uint32x4_t v[4];
+    for (int j = 0; j < 4; ++j) v[j] = vld1q_u32(acc + j * 4);
+    for (size_t i = 0; i < block_count; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            uint32x4_t x = vmlaq_u32(v[j], vld1q_u32(words + i * kLanes + j * 4), prime2);
+            x = vsriq_n_u32(vshlq_n_u32(x, 13), x, 19);
+            v[j] = vmulq_u32(x, prime1);
+        }
+    }
+    for (int j = 0; j < 4; ++j) vst1q_u32(acc + j * 4, v[j]);
+#else
+    for (size_t i = 0; i < block_count; ++i) {
+        for (size_t lane = 0; lane < kLanes; ++lane) acc[lane] = round32(acc[lane], words[i * kLanes + lane]);
+    }
+#endif
+}
+
+uint64_t mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+}  // namespace
+
+uint64_t hash_words(const uint32_t* words, size_t word_count) {
+    uint32_t acc[kLanes];
+    for (size_t lane = 0; lane < kLanes; ++lane) acc[lane] = kPrime1 * (uint32_t)(lane + 1);
+    size_t block_count = word_count / kLanes;
+    accumulate_lanes(acc, words, block_count);
+
+    // 남은 워드 (최대 15개) 는 스칼라로 같은 lane 에 넣습니다.
+    for (size_t i = block_count * kLanes; i < word_count; ++i) {
+        acc[i % kLanes] = round32(acc[i % kLanes], words[i]);
+    }
+
+    uint64_t h = (uint64_t)word_count * kPrime3;
+    for (size_t lane = 0; lane < kLanes; lane += 2) {
+        h = mix64(h ^ (acc[lane] | ((uint64_t)acc[lane + 1] << 32)));
+    }
+    return h;
+}
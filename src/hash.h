@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// 64bit FNV-1a. 파일 무결성 검사처럼 속도가 중요하지 않은 곳에 씁니다.
+inline uint64_t fnv1a_64(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= bytes[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+// 32bit 워드 배열 (ex. SPIR-V) 용 해시. 16개 lane 을 독립적으로 누적하는 xxHash32 방식이라
+// SSE2 / NEON 으로 한 번에 16워드씩 처리하고, 둘 다 없으면 같은 결과를 내는 스칼라 코드를 씁니다.
+uint64_t hash_words(const uint32_t* words, size_t word_count);
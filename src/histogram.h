@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Log-linear 히스토그램 (2의 거듭제곱 구간마다 8개 하위 버킷, 상대 오차 ~12%).
+//
+// 기록하는 스레드는 하나라고 가정합니다 (ex. 큐 하나의 submit/present 는 외부 동기화됨).
+// 그래서 카운터 갱신은 RMW 가 아닌 relaxed load/store 이고, 다른 스레드는 언제든 읽을 수 있습니다.
+// 카운트는 누적만 되며, 구간 통계는 이전 스냅샷과의 차이로 계산합니다.
+class Histogram {
+public:
+    static constexpr unsigned kSubBits = 3;
+    static constexpr size_t kSubBuckets = size_t(1) << kSubBits;
+    static constexpr size_t kBucketCount = (64 - kSubBits + 1) * kSubBuckets;
+
+    struct Snapshot {
+        uint32_t counts[kBucketCount] = {};
+        uint64_t total = 0;
+    };
+
+    void record(uint64_t value) {
+        std::atomic<uint32_t>& count = m_counts[bucket_of(value)];
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // 누적 카운트를 스냅샷에 복사합니다.
+    void snapshot(Snapshot* out) const {
+        out->total = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            out->counts[i] = m_counts[i].load(std::memory_order_relaxed);
+            out->total += out->counts[i];
+        }
+    }
+
+    // current - previous (구간 동안 기록된 값들) 을 out 에 담습니다.
+    static void diff(const Snapshot& current, const Snapshot& previous, Snapshot* out) {
+        out->total = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            out->counts[i] = current.counts[i] - previous.counts[i];
+            out->total += out->counts[i];
+        }
+    }
+
+    // 0 <= q <= 1. 버킷의 중간값을 돌려줍니다. 비어 있으면 0.
+    static uint64_t percentile(const Snapshot& snapshot, double q) {
+        if (snapshot.total == 0) return 0;
+        uint64_t rank = (uint64_t)__builtin_ceil(q * (double)snapshot.total);
+        if (rank == 0) rank = 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            seen += snapshot.counts[i];
+            if (seen >= rank) return (bucket_lower_bound(i) + bucket_lower_bound(i + 1)) / 2;
+        }
+        return bucket_lower_bound(kBucketCount - 1);
+    }
+
+    // value 이상인 (버킷 하한 기준) 기록 수
+    static uint64_t count_at_least(const Snapshot& snapshot, uint64_t value) {
+        uint64_t count = 0;
+        for (size_t i = bucket_of(value); i < kBucketCount; ++i) count += snapshot.counts[i];
+        return count;
+    }
+
+    static size_t bucket_of(uint64_t value) {
+        if (value < kSubBuckets) return (size_t)value;
+        unsigned msb = 63u - (unsigned)__builtin_clzll(value);
+        unsigned shift = msb - kSubBits;
+        return (size_t)(shift + 1) * kSubBuckets + (size_t)((value >> shift) & (kSubBuckets - 1));
+    }
+
+    static uint64_t bucket_lower_bound(size_t bucket) {
+        if (bucket < kSubBuckets) return bucket;
+        unsigned shift = (unsigned)(bucket / kSubBuckets) - 1;
+        if (shift + kSubBits >= 64) return UINT64_MAX;
+        return (uint64_t)(kSubBuckets + bucket % kSubBuckets) << shift;
+    }
+
+private:
+    std::atomic<uint32_t> m_counts[kBucketCount] = {};
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <type_traits>
+
+// 레이어가 가로채는 명령 목록 (Hook_vk<name> 으로 구현). 여기에 없는 명령은
+// 디스패치 테이블에 저장해 둔 다음 체인의 포인터를 그대로 돌려줍니다.
+#define MY_LAYER_HOOKED_COMMANDS(X) \
+    X(CreateInstance) \
+    X(DestroyInstance) \
+    X(CreateDevice) \
+    X(DestroyDevice) \
+    X(GetDeviceQueue) \
+    X(GetDeviceQueue2) \
+    X(QueueSubmit) \
+    X(QueueSubmit2) \
+    X(QueueSubmit2KHR) \
+    X(QueuePresentKHR) \
+    X(AllocateCommandBuffers) \
+    X(FreeCommandBuffers) \
+    X(DestroyCommandPool) \
+    X(BeginCommandBuffer) \
+    X(CmdExecuteCommands) \
+    X(CmdDraw) \
+    X(CmdDrawIndexed) \
+    X(CmdDrawIndirect) \
+    X(CmdDrawIndexedIndirect) \
+    X(CmdDrawIndirectCount) \
+    X(CmdDrawIndirectCountKHR) \
+    X(CmdDrawIndexedIndirectCount) \
+    X(CmdDrawIndexedIndirectCountKHR) \
+    X(CmdDispatch) \
+    X(CmdDispatchBase) \
+    X(CmdDispatchIndirect) \
+    X(CmdBindPipeline) \
+    X(CmdBindDescriptorSets) \
+    X(CmdPushDescriptorSetKHR) \
+    X(CmdPushDescriptorSetWithTemplateKHR) \
+    X(CmdBindVertexBuffers) \
+    X(CmdBindVertexBuffers2) \
+    X(CmdBindVertexBuffers2EXT) \
+    X(CmdPushConstants) \
+    X(CmdBeginRenderPass) \
+    X(CmdBeginRenderPass2) \
+    X(CmdBeginRenderPass2KHR) \
+    X(CmdBeginRendering) \
+    X(CmdBeginRenderingKHR) \
+    X(CmdEndRenderPass) \
+    X(CmdEndRenderPass2) \
+    X(CmdEndRenderPass2KHR) \
+    X(CmdEndRendering) \
+    X(CmdEndRenderingKHR) \
+    X(CreatePipelineCache) \
+    X(DestroyPipelineCache) \
+    X(CreateGraphicsPipelines) \
+    X(CreateComputePipelines) \
+    X(CreateShaderModule) \
+    X(DestroyShaderModule) \
+    X(EndCommandBuffer) \
+    X(CmdNextSubpass) \
+    X(CmdNextSubpass2) \
+    X(CmdNextSubpass2KHR) \
+    X(CmdBindIndexBuffer) \
+    X(CmdSetViewport) \
+    X(CmdSetScissor) \
+    X(CmdSetLineWidth) \
+    X(CmdSetBlendConstants) \
+    X(CmdSetDepthBounds) \
+    X(CmdSetStencilCompareMask) \
+    X(CmdSetStencilWriteMask) \
+    X(CmdSetStencilReference) \
+    X(CmdSetCullMode) \
+    X(CmdSetCullModeEXT) \
+    X(CmdSetFrontFace) \
+    X(CmdSetFrontFaceEXT) \
+    X(CmdSetPrimitiveTopology) \
+    X(CmdSetPrimitiveTopologyEXT) \
+    X(CmdSetDepthTestEnable) \
+    X(CmdSetDepthTestEnableEXT) \
+    X(CmdSetDepthWriteEnable) \
+    X(CmdSetDepthWriteEnableEXT) \
+    X(CmdSetDepthCompareOp) \
+    X(CmdSetDepthCompareOpEXT) \
+    X(CmdSetViewportWithCount) \
+    X(CmdSetViewportWithCountEXT) \
+    X(CmdSetScissorWithCount) \
+    X(CmdSetScissorWithCountEXT) \
+    X(AllocateMemory) \
+    X(FreeMemory) \
+    X(MapMemory) \
+    X(UnmapMemory) \
+    X(MapMemory2KHR) \
+    X(UnmapMemory2KHR) \
+    X(FlushMappedMemoryRanges) \
+    X(InvalidateMappedMemoryRanges) \
+    X(BindBufferMemory) \
+    X(BindImageMemory) \
+    X(BindBufferMemory2) \
+    X(BindBufferMemory2KHR) \
+    X(BindImageMemory2) \
+    X(BindImageMemory2KHR) \
+    X(SetDebugUtilsObjectNameEXT) \
+    X(SetDebugUtilsObjectTagEXT)
+
+// PFN 타입으로 선언하므로 구현의 시그니처가 다르면 컴파일 에러가 납니다.
+#define MY_LAYER_DECLARE_HOOK(name) std::remove_pointer_t<PFN_vk##name> Hook_vk##name;
+MY_LAYER_HOOKED_COMMANDS(MY_LAYER_DECLARE_HOOK)
+#undef MY_LAYER_DECLARE_HOOK
+
+// kProcInfos 인덱스 -> 훅 함수 (my_layer.cpp). 훅하지 않는 명령은 nullptr.
+PFN_vkVoidFunction get_layer_hook(int proc_index);
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "command_stats.h"
+#include "device_memory.h"
+#include "dispatch_table.h"
+#include "frame_pacer.h"
+#include "frame_profiler.h"
+#include "handle_map.h"
+#include "pipeline_cache.h"
+#include "shader_module_cache.h"
+#include "state_filter.h"
+
+// --- 데이터 관리 및 스레드 안전성 ---
+
+struct LayerInstanceData {
+    VkInstance instance;
+    uint32_t api_version;  // VkApplicationInfo::apiVersion (없으면 1.0)
+    InstanceDispatchTable dispatch;
+};
+
+struct LayerQueueData;
+
+struct LayerDeviceData {
+    VkDevice device;
+    VkPhysicalDevice physical_device;
+    LayerInstanceData* instance_data;
+    DeviceDispatchTable dispatch;
+    VkPhysicalDeviceProperties properties;
+    uint32_t api_version;  // 인스턴스와 물리 디바이스 버전 중 낮은 쪽
+
+    // vkGetDeviceQueue(2) 로 얻은 큐. 추가는 queue_mutex 아래에서, 읽기는 lock-free.
+    // LayerQueueData 는 g_queue_data_map 이 소유합니다.
+    static constexpr uint32_t kMaxQueues = 64;
+    std::mutex queue_mutex;
+    std::atomic<uint32_t> queue_count{0};
+    LayerQueueData* queues[kMaxQueues] = {};
+
+    DeviceProfile profile;
+    bool display_timing = false;  // 앱이 VK_GOOGLE_display_timing 을 켰는지 (프레임 페이싱)
+
+    bool command_stats_enabled;
+    // cmd_stats 나 상태 필터가 켜져 있을 때만 LayerCommandBufferData 를 만들고 vkCmd* 를 훅합니다.
+    bool track_command_buffers = false;
+    // 해제된 LayerCommandBufferData 를 재사용하는 풀. 할당/해제 시에만 잡습니다.
+    std::mutex command_buffer_mutex;
+    std::vector<std::unique_ptr<LayerCommandBufferData>> free_command_buffers;
+
+    StateFilterConfig state_filter;
+    StateFilterTotals state_filter_totals;
+
+    // 레이어 파이프라인 캐시. 꺼져 있으면 nullptr.
+    std::unique_ptr<PipelineCacheStore> pipeline_cache;
+
+    // SPIR-V 중복 제거. 꺼져 있으면 nullptr.
+    std::unique_ptr<ShaderModuleCache> shader_modules;
+
+    // 메모리 census / suballocation. 꺼져 있으면 nullptr.
+    std::unique_ptr<DeviceMemoryTracker> memory;
+};
+
+struct LayerQueueData {
+    VkQueue queue;
+    LayerDeviceData* device_data;
+    uint32_t family_index;
+    uint32_t queue_index;
+    QueueProfile profile;
+    QueuePacer pacer;
+    SubmittedCommandStats submitted_commands;
+};
+
+// Dispatch key -> LayerData. 조회는 lock-free, 생성/파괴 시에만 writer lock 을 잡습니다.
+extern HandleMap<LayerInstanceData> g_instance_data_map;
+extern HandleMap<LayerDeviceData> g_device_data_map;
+// VkQueue 는 디바이스와 dispatch key 를 공유하므로 핸들 값 자체를 키로 씁니다.
+extern HandleMap<LayerQueueData> g_queue_data_map;
+// VkCommandBuffer 도 마찬가지로 핸들 값이 키입니다.
+extern HandleMap<LayerCommandBufferData> g_command_buffer_data_map;
+
+static inline void* get_dispatch_key(const void* dispatchable_handle) {
+    return *(void**)dispatchable_handle;
+}
+
+// 큐/커맨드 버퍼 등 디바이스에 속한 dispatchable handle 도 받을 수 있습니다.
+static inline LayerDeviceData* get_device_data(const void* dispatchable_handle) {
+    return g_device_data_map.find(get_dispatch_key(dispatchable_handle));
+}
+
+LayerQueueData* register_queue(LayerDeviceData* device_data, VkQueue queue,
+                               uint32_t family_index, uint32_t queue_index);
+
+// command_pool 의 커맨드 버퍼 데이터를 맵에서 빼서 디바이스 풀로 돌려줍니다.
+// VK_NULL_HANDLE 이면 디바이스의 모든 커맨드 버퍼가 대상입니다.
+void erase_command_buffers(LayerDeviceData* device_data, VkCommandPool command_pool);
+
+// vkGetDeviceQueue 로 등록되지 않은 큐 (ex. 레이어보다 먼저 얻은 큐) 는 여기서 등록합니다.
+static inline LayerQueueData* get_queue_data(VkQueue queue) {
+    LayerQueueData* queue_data = g_queue_data_map.find(queue);
+    if (queue_data) return queue_data;
+    LayerDeviceData* device_data = get_device_data(queue);
+    if (!device_data) return nullptr;
+    return register_queue(device_data, queue, UINT32_MAX, UINT32_MAX);
+}
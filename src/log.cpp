@@ -0,0 +1,439 @@
+#include "log.h"
+
+#include "clock.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+#include <sys/syscall.h>
+
+namespace {
+
+LogPriority get_initial_min_priority() {
+    std::string level = platform_get_property("debug.my_layer.log_level");
+    if (level == "debug") return LogPriority::Debug;
+    if (level == "warn") return LogPriority::Warn;
+    if (level == "error") return LogPriority::Error;
+    return LogPriority::Info;
+}
+
+}  // namespace
+
+std::atomic<int> g_log_min_priority{(int)get_initial_min_priority()};
+
+// ring 이 가득 차서 버려진 레코드 수 (전체 스레드). drain 스레드가 ring 별 카운터를 합해서 쓰고,
+// present 마다 텔레메트리가 relaxed load 로 읽습니다.
+static std::atomic<uint64_t> g_log_dropped{0};
+
+namespace {
+
+constexpr uint32_t kRingSize = 256;  // 2의 거듭제곱
+constexpr uint32_t kMaxFormats = 1024;
+constexpr auto kDrainInterval = std::chrono::milliseconds(5);
+constexpr uint64_t kRateLimitWindowNs = 1000000000ull;
+
+struct LogFormat {
+    LogPriority priority;
+    const char* fmt;
+};
+
+// 스레드 하나가 쓰고 drain 스레드 하나가 읽는 SPSC ring.
+struct LogRing {
+    std::atomic<uint32_t> head{0};     // producer 만 씀
+    std::atomic<uint32_t> tail{0};     // consumer 만 씀
+    std::atomic<uint64_t> dropped{0};  // producer 만 씀
+    std::atomic<bool> retired{false};  // 스레드 종료 후 drain 이 끝나면 해제
+    uint32_t thread_id = 0;
+    LogRecord records[kRingSize];
+};
+
+struct RateLimitState {
+    uint64_t window_start_ns = 0;
+    uint32_t count = 0;
+    uint32_t suppressed = 0;
+};
+
+// %d, %s 등 변환 하나를 저장된 인자로 출력합니다. 길이 수식어는 인자 타입에 맞게 다시 붙입니다.
+size_t format_arg(char* out, size_t size, const char* spec_begin, size_t spec_length, char conversion,
+                  const LogRecord& record, size_t arg_index) {
+    if (arg_index >= record.arg_count) return (size_t)snprintf(out, size, "<?>");
+
+    char spec[32];
+    size_t n = 0;
+    for (size_t i = 0; i < spec_length && n < sizeof(spec) - 4; ++i) {
+        char c = spec_begin[i];
+        if (c == 'h' || c == 'l' || c == 'z' || c == 'j' || c == 't' || c == 'L' || c == 'q') continue;
+        spec[n++] = c;
+    }
+
+    uint64_t raw = record.args[arg_index];
+    LogArgType type = record.arg_types[arg_index];
+    switch (conversion) {
+        case 'd': case 'i': {
+            spec[n++] = 'l'; spec[n++] = 'l'; spec[n++] = conversion; spec[n] = '\0';
+            return (size_t)snprintf(out, size, spec, (long long)raw);
+        }
+        case 'u': case 'x': case 'X': case 'o': {
+            spec[n++] = 'l'; spec[n++] = 'l'; spec[n++] = conversion; spec[n] = '\0';
+            return (size_t)snprintf(out, size, spec, (unsigned long long)raw);
+        }
+        case 'c': {
+            spec[n++] = 'c'; spec[n] = '\0';
+            return (size_t)snprintf(out, size, spec, (int)raw);
+        }
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+            double value = 0.0;
+            if (type == LogArgType::Double) memcpy(&value, &raw, sizeof(value));
+            else value = (double)(int64_t)raw;
+            spec[n++] = conversion; spec[n] = '\0';
+            return (size_t)snprintf(out, size, spec, value);
+        }
+        case 's': {
+            const char* value = type == LogArgType::String ? record.strings + raw : "<?>";
+            spec[n++] = 's'; spec[n] = '\0';
+            return (size_t)snprintf(out, size, spec, value);
+        }
+        case 'p': {
+            spec[n++] = 'p'; spec[n] = '\0';
+            return (size_t)snprintf(out, size, spec, (void*)(uintptr_t)raw);
+        }
+    }
+    return (size_t)snprintf(out, size, "<?>");
+}
+
+void format_record(const LogFormat& format, const LogRecord& record, char* out, size_t size) {
+    size_t pos = 0;
+    size_t arg_index = 0;
+    for (const char* p = format.fmt; *p && pos + 1 < size;) {
+        if (*p != '%') {
+            out[pos++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[pos++] = '%';
+            p += 2;
+            continue;
+        }
+
+        const char* spec_begin = p++;
+        while (*p && strchr("-+ #0123456789.hlzjtLq", *p)) ++p;
+        if (!*p) break;
+        char conversion = *p++;
+
+        size_t written = format_arg(out + pos, size - pos, spec_begin, (size_t)(p - 1 - spec_begin),
+                                    conversion, record, arg_index++);
+        pos = std::min(pos + written, size - 1);
+    }
+    out[pos] = '\0';
+}
+
+class SystemLogSink : public LogSink {
+public:
+    void write(LogPriority priority, const char* tag, const char* message) override {
+        platform_log_write(priority, tag, message);
+    }
+};
+
+class StreamLogSink : public LogSink {
+public:
+    StreamLogSink(FILE* file, bool owned) : m_file(file), m_owned(owned) {}
+    ~StreamLogSink() override {
+        if (m_owned) fclose(m_file);
+    }
+
+    void write(LogPriority priority, const char* tag, const char* message) override {
+        static const char kPriorityNames[] = {'D', 'I', 'W', 'E'};
+        fprintf(m_file, "%c/%s: %s\n", kPriorityNames[(int)priority], tag, message);
+    }
+
+    void flush() override { fflush(m_file); }
+
+private:
+    FILE* m_file;
+    bool m_owned;
+};
+
+class Logger {
+public:
+    ~Logger() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wakeup.notify_all();
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+    uint32_t register_format(LogPriority priority, const char* fmt) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_format_count >= kMaxFormats) return kMaxFormats;
+        m_formats[m_format_count] = {priority, fmt};
+        return m_format_count++;
+    }
+
+    LogRing* register_ring() {
+        auto ring = std::make_unique<LogRing>();
+        ring->thread_id = (uint32_t)syscall(SYS_gettid);
+        LogRing* raw = ring.get();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rings.push_back(std::move(ring));
+        if (!m_thread.joinable()) m_thread = std::thread(&Logger::drain_loop, this);
+        return raw;
+    }
+
+    void add_sink(std::unique_ptr<LogSink> sink) {
+        std::lock_guard<std::mutex> lock(m_sink_mutex);
+        m_sinks.push_back(std::move(sink));
+        m_sinks_configured = true;
+    }
+
+    void clear_sinks() {
+        std::lock_guard<std::mutex> lock(m_sink_mutex);
+        m_sinks.clear();
+        m_sinks_configured = true;
+    }
+
+    void flush(uint32_t timeout_ms) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_thread.joinable()) return;
+        uint64_t target = ++m_flush_requested;
+        m_wakeup.notify_all();
+        m_flushed.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                           [&] { return m_flush_completed >= target; });
+    }
+
+private:
+    void configure_default_sinks() {
+        std::string sinks = platform_get_property("debug.my_layer.log_sinks");
+        if (sinks.empty()) sinks = "system";
+
+        if (sinks.find("system") != std::string::npos) m_sinks.push_back(make_system_log_sink());
+        if (sinks.find("stderr") != std::string::npos) m_sinks.push_back(make_stderr_log_sink());
+        if (sinks.find("file") != std::string::npos) {
+            std::string path = platform_get_property("debug.my_layer.log_file");
+            if (!path.empty()) {
+                std::unique_ptr<LogSink> sink = make_file_log_sink(path.c_str());
+                if (sink) m_sinks.push_back(std::move(sink));
+            }
+        }
+        m_sinks_configured = true;
+    }
+
+    void emit(LogPriority priority, const char* message) {
+        for (const auto& sink : m_sinks) sink->write(priority, LOG_TAG, message);
+    }
+
+    void emit_suppressed(const LogFormat& format, RateLimitState& state) {
+        if (state.suppressed == 0) return;
+        char message[256];
+        snprintf(message, sizeof(message), "(suppressed %u repeats of \"%s\")", state.suppressed, format.fmt);
+        emit(format.priority, message);
+        state.suppressed = 0;
+    }
+
+    // 레코드를 포맷팅해서 sink 로 보냅니다. rate limit 을 넘은 메시지는 개수만 셉니다.
+    void emit_record(const LogRecord& record) {
+        if (record.format_id >= m_format_count_snapshot) return;
+        const LogFormat& format = m_formats[record.format_id];
+
+        if (m_rate_limit > 0) {
+            RateLimitState& state = m_rate_limits[record.format_id];
+            if (record.timestamp_ns - state.window_start_ns >= kRateLimitWindowNs) {
+                emit_suppressed(format, state);
+                state.window_start_ns = record.timestamp_ns;
+                state.count = 0;
+            }
+            if (++state.count > m_rate_limit) {
+                state.suppressed++;
+                return;
+            }
+        }
+
+        char message[1024];
+        format_record(format, record, message, sizeof(message));
+        emit(format.priority, message);
+    }
+
+    void drain_loop() {
+        std::string rate_limit = platform_get_property("debug.my_layer.log_rate_limit");
+        m_rate_limit = rate_limit.empty() ? 20 : (uint32_t)strtoul(rate_limit.c_str(), nullptr, 10);
+
+        std::vector<LogRecord> batch;
+        std::vector<LogRing*> rings;
+        uint64_t reported_dropped = 0;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_wakeup.wait_for(lock, kDrainInterval, [&] {
+                return m_stopping || m_flush_requested > m_flush_completed;
+            });
+            bool stopping = m_stopping;
+            uint64_t flush_target = m_flush_requested;
+
+            rings.clear();
+            for (const auto& ring : m_rings) rings.push_back(ring.get());
+            m_format_count_snapshot = m_format_count;
+            lock.unlock();
+
+            // 각 ring 에서 지금까지 commit 된 레코드를 모두 꺼냅니다.
+            batch.clear();
+            uint64_t dropped = m_retired_dropped;
+            for (LogRing* ring : rings) {
+                uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+                uint32_t head = ring->head.load(std::memory_order_acquire);
+                for (; tail != head; ++tail) batch.push_back(ring->records[tail & (kRingSize - 1)]);
+                ring->tail.store(tail, std::memory_order_release);
+                dropped += ring->dropped.load(std::memory_order_relaxed);
+            }
+            g_log_dropped.store(dropped, std::memory_order_relaxed);
+            std::stable_sort(batch.begin(), batch.end(), [](const LogRecord& a, const LogRecord& b) {
+                return a.timestamp_ns < b.timestamp_ns;
+            });
+
+            {
+                std::lock_guard<std::mutex> sink_lock(m_sink_mutex);
+                if (!m_sinks_configured) configure_default_sinks();
+                for (const LogRecord& record : batch) emit_record(record);
+
+                if (dropped > reported_dropped) {
+                    char message[128];
+                    snprintf(message, sizeof(message), "log: dropped %llu records (ring full)",
+                             (unsigned long long)(dropped - reported_dropped));
+                    emit(LogPriority::Warn, message);
+                    reported_dropped = dropped;
+                }
+                if (stopping) {
+                    for (uint32_t i = 0; i < m_format_count_snapshot; ++i) {
+                        emit_suppressed(m_formats[i], m_rate_limits[i]);
+                    }
+                }
+                if (flush_target > m_flush_completed || stopping) {
+                    for (const auto& sink : m_sinks) sink->flush();
+                }
+            }
+
+            lock.lock();
+            // 종료된 스레드의 ring 은 비워진 뒤 해제합니다.
+            m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), [&](const std::unique_ptr<LogRing>& ring) {
+                bool done = ring->retired.load(std::memory_order_acquire) &&
+                            ring->tail.load(std::memory_order_relaxed) == ring->head.load(std::memory_order_acquire);
+                if (done) m_retired_dropped += ring->dropped.load(std::memory_order_relaxed);
+                return done;
+            }), m_rings.end());
+
+            if (flush_target > m_flush_completed) {
+                m_flush_completed = flush_target;
+                m_flushed.notify_all();
+            }
+            if (stopping) break;
+        }
+    }
+
+    std::mutex m_mutex;  // formats, rings, flush 상태
+    std::condition_variable m_wakeup;
+    std::condition_variable m_flushed;
+    std::thread m_thread;
+    bool m_stopping = false;
+    uint64_t m_flush_requested = 0;
+    uint64_t m_flush_completed = 0;
+    uint64_t m_retired_dropped = 0;  // drain 스레드만 씀
+
+    LogFormat m_formats[kMaxFormats] = {};
+    uint32_t m_format_count = 0;
+    std::vector<std::unique_ptr<LogRing>> m_rings;
+
+    // drain 스레드 전용
+    std::mutex m_sink_mutex;
+    std::vector<std::unique_ptr<LogSink>> m_sinks;
+    bool m_sinks_configured = false;
+    uint32_t m_format_count_snapshot = 0;
+    uint32_t m_rate_limit = 0;
+    RateLimitState m_rate_limits[kMaxFormats] = {};
+};
+
+Logger& get_logger() {
+    static Logger logger;
+    return logger;
+}
+
+// 스레드가 처음 로그를 남길 때 ring 을 등록하고, 스레드가 끝나면 retired 로 표시합니다.
+struct ThreadLogRing {
+    LogRing* ring = nullptr;
+    ~ThreadLogRing() {
+        if (ring) ring->retired.store(true, std::memory_order_release);
+    }
+};
+
+thread_local ThreadLogRing t_log_ring;
+
+}  // namespace
+
+std::unique_ptr<LogSink> make_system_log_sink() {
+    return std::make_unique<SystemLogSink>();
+}
+
+std::unique_ptr<LogSink> make_stderr_log_sink() {
+    return std::make_unique<StreamLogSink>(stderr, false);
+}
+
+std::unique_ptr<LogSink> make_file_log_sink(const char* path) {
+    FILE* file = fopen(path, "a");
+    if (!file) return nullptr;
+    return std::make_unique<StreamLogSink>(file, true);
+}
+
+void log_add_sink(std::unique_ptr<LogSink> sink) {
+    get_logger().add_sink(std::move(sink));
+}
+
+void log_clear_sinks() {
+    get_logger().clear_sinks();
+}
+
+void log_set_min_priority(LogPriority priority) {
+    g_log_min_priority.store((int)priority, std::memory_order_relaxed);
+}
+
+uint32_t log_register_format(LogPriority priority, const char* fmt) {
+    return get_logger().register_format(priority, fmt);
+}
+
+void log_flush(uint32_t timeout_ms) {
+    get_logger().flush(timeout_ms);
+}
+
+uint64_t log_dropped_count() {
+    return g_log_dropped.load(std::memory_order_relaxed);
+}
+
+LogRecord* log_begin_record(uint32_t format_id) {
+    LogRing* ring = t_log_ring.ring;
+    if (!ring) ring = t_log_ring.ring = get_logger().register_ring();
+
+    uint32_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) >= kRingSize) {
+        ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    LogRecord* record = &ring->records[head & (kRingSize - 1)];
+    record->timestamp_ns = monotonic_now_ns();
+    record->format_id = format_id;
+    record->arg_count = 0;
+    record->string_bytes = 0;
+    return record;
+}
+
+void log_commit_record() {
+    LogRing* ring = t_log_ring.ring;
+    ring->head.store(ring->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "platform.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+// 비동기 로깅.
+//
+// 호출한 스레드에서는 포맷팅을 하지 않습니다. 호출 지점마다 한 번 등록한 포맷 ID 와 인자 원본
+// (정수/실수/포인터, 문자열은 복사본) 만 스레드별 lock-free ring buffer 에 넣고,
+// 백그라운드 drain 스레드가 printf 포맷팅 후 sink (logcat, stderr, 파일) 로 보냅니다.
+//
+// - 레벨 필터: log_set_min_priority(), 필터된 호출은 atomic load 1회로 끝납니다.
+// - rate limit: 같은 호출 지점의 메시지가 초당 한도를 넘으면 drain 스레드가 생략하고 개수만 알립니다.
+// - backpressure: ring 이 가득 차면 기다리지 않고 버리며 log_dropped_count() 로 집계합니다.
+
+constexpr size_t kLogMaxArgs = 8;
+constexpr size_t kLogStringBytes = 96;
+
+enum class LogArgType : uint8_t {
+    Int,
+    Uint,
+    Double,
+    Pointer,
+    String,  // LogRecord::strings 안의 오프셋
+};
+
+struct LogRecord {
+    uint64_t timestamp_ns;
+    uint32_t format_id;
+    uint8_t arg_count;
+    uint8_t string_bytes;
+    LogArgType arg_types[kLogMaxArgs];
+    uint64_t args[kLogMaxArgs];
+    char strings[kLogStringBytes];
+};
+
+class LogSink {
+public:
+    virtual ~LogSink() = default;
+    virtual void write(LogPriority priority, const char* tag, const char* message) = 0;
+    virtual void flush() {}
+};
+
+// 플랫폼 기본 로그 (Android: logcat, Linux: stderr)
+std::unique_ptr<LogSink> make_system_log_sink();
+std::unique_ptr<LogSink> make_stderr_log_sink();
+std::unique_ptr<LogSink> make_file_log_sink(const char* path);
+
+// drain 스레드가 사용하는 sink 를 추가합니다. sink 를 하나도 추가하지 않으면
+// debug.my_layer.log_sinks (system,stderr,file) 와 debug.my_layer.log_file 설정을 따릅니다.
+void log_add_sink(std::unique_ptr<LogSink> sink);
+void log_clear_sinks();
+
+extern std::atomic<int> g_log_min_priority;
+
+inline bool log_is_enabled(LogPriority priority) {
+    return (int)priority >= g_log_min_priority.load(std::memory_order_relaxed);
+}
+
+void log_set_min_priority(LogPriority priority);
+
+// 호출 지점 (ALOGx) 당 한 번 호출됩니다.
+uint32_t log_register_format(LogPriority priority, const char* fmt);
+
+// 지금까지 기록된 메시지가 sink 까지 전달될 때까지 기다립니다. (최대 timeout_ms)
+void log_flush(uint32_t timeout_ms = 100);
+
+// ring 이 가득 차서 버려진 레코드 수 (전체 스레드 합계, drain 주기마다 갱신)
+uint64_t log_dropped_count();
+
+// 현재 스레드의 ring 에 예약된 레코드를 돌려줍니다. 가득 찼으면 nullptr.
+LogRecord* log_begin_record(uint32_t format_id);
+void log_commit_record();
+
+inline void log_encode_string(LogRecord* record, const char* value) {
+    record->arg_types[record->arg_count] = LogArgType::String;
+    record->args[record->arg_count] = record->string_bytes;
+    if (!value) value = "(null)";
+    size_t offset = record->string_bytes;
+    while (*value && offset < kLogStringBytes - 1) record->strings[offset++] = *value++;
+    record->strings[offset++] = '\0';
+    record->string_bytes = (uint8_t)(offset < kLogStringBytes ? offset : kLogStringBytes - 1);
+}
+
+template <typename T>
+inline void log_encode_arg(LogRecord* record, T value) {
+    if (record->arg_count >= kLogMaxArgs) return;
+
+    if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>) {
+        log_encode_string(record, value);
+    } else if constexpr (std::is_pointer_v<T>) {
+        record->arg_types[record->arg_count] = LogArgType::Pointer;
+        record->args[record->arg_count] = (uint64_t)(uintptr_t)value;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        double d = (double)value;
+        record->arg_types[record->arg_count] = LogArgType::Double;
+        __builtin_memcpy(&record->args[record->arg_count], &d, sizeof(d));
+    } else if constexpr (std::is_enum_v<T> || std::is_signed_v<T>) {
+        record->arg_types[record->arg_count] = LogArgType::Int;
+        record->args[record->arg_count] = (uint64_t)(int64_t)value;
+    } else {
+        static_assert(std::is_integral_v<T>, "unsupported log argument type");
+        record->arg_types[record->arg_count] = LogArgType::Uint;
+        record->args[record->arg_count] = (uint64_t)value;
+    }
+    record->arg_count++;
+}
+
+template <typename... Args>
+inline void log_write(uint32_t format_id, Args... args) {
+    LogRecord* record = log_begin_record(format_id);
+    if (!record) return;
+    (log_encode_arg(record, args), ...);
+    log_commit_record();
+}
+
+// -Wformat 검사용. 실제로 호출되지는 않습니다.
+inline void log_check_format(const char*, ...) __attribute__((format(printf, 1, 2)));
+inline void log_check_format(const char*, ...) {}
+
+#define MY_LAYER_LOG(priority, fmt, ...)                                                  \
+    do {                                                                                  \
+        if (log_is_enabled(priority)) {                                                   \
+            static const uint32_t my_layer_log_format_id = log_register_format(priority, fmt); \
+            log_write(my_layer_log_format_id __VA_OPT__(,) __VA_ARGS__);                  \
+        }                                                                                 \
+        if (false) log_check_format(fmt __VA_OPT__(,) __VA_ARGS__);                       \
+    } while (0)
+
+#define LOG_TAG "MyLayer"
+#define ALOGD(...) MY_LAYER_LOG(LogPriority::Debug, __VA_ARGS__)
+#define ALOGI(...) MY_LAYER_LOG(LogPriority::Info, __VA_ARGS__)
+#define ALOGW(...) MY_LAYER_LOG(LogPriority::Warn, __VA_ARGS__)
+#define ALOGE(...) MY_LAYER_LOG(LogPriority::Error, __VA_ARGS__)
@@ -0,0 +1,283 @@
+#include <vulkan/vulkan.h>
+
+#include <vector>
+
+#include "device_memory.h"
+#include "hooks.h"
+#include "layer_data.h"
+#include "utils.h"
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkAllocateMemory(
+    VkDevice device,
+    const VkMemoryAllocateInfo* pAllocateInfo,
+    const VkAllocationCallbacks* pAllocator,
+    VkDeviceMemory* pMemory)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    if (!device_data->memory) return device_data->dispatch.AllocateMemory(device, pAllocateInfo, pAllocator, pMemory);
+    return device_data->memory->allocate(pAllocateInfo, pAllocator, pMemory);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkFreeMemory(
+    VkDevice device,
+    VkDeviceMemory memory,
+    const VkAllocationCallbacks* pAllocator)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    if (!device_data->memory) {
+        device_data->dispatch.FreeMemory(device, memory, pAllocator);
+        return;
+    }
+    device_data->memory->free(memory, pAllocator);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkMapMemory(
+    VkDevice device,
+    VkDeviceMemory memory,
+    VkDeviceSize offset,
+    VkDeviceSize size,
+    VkMemoryMapFlags flags,
+    void** ppData)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    const DeviceMemoryTracker::SubAllocation* sub = device_data->memory ? device_data->memory->find(memory) : nullptr;
+    if (sub) return device_data->memory->map(sub, offset, ppData);
+    return device_data->dispatch.MapMemory(device, memory, offset, size, flags, ppData);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkUnmapMemory(
+    VkDevice device,
+    VkDeviceMemory memory)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    // suballocation 은 블록을 계속 map 해 둡니다.
+    if (device_data->memory && device_data->memory->find(memory)) return;
+    device_data->dispatch.UnmapMemory(device, memory);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkMapMemory2KHR(
+    VkDevice device,
+    const VkMemoryMapInfoKHR* pMemoryMapInfo,
+    void** ppData)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    const DeviceMemoryTracker::SubAllocation* sub =
+        device_data->memory ? device_data->memory->find(pMemoryMapInfo->memory) : nullptr;
+    if (sub) return device_data->memory->map(sub, pMemoryMapInfo->offset, ppData);
+    return device_data->dispatch.MapMemory2KHR(device, pMemoryMapInfo, ppData);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkUnmapMemory2KHR(
+    VkDevice device,
+    const VkMemoryUnmapInfoKHR* pMemoryUnmapInfo)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    if (device_data->memory && device_data->memory->find(pMemoryUnmapInfo->memory)) return VK_SUCCESS;
+    return device_data->dispatch.UnmapMemory2KHR(device, pMemoryUnmapInfo);
+}
+
+// suballocation 이 하나라도 있으면 복사본의 memory / offset / size 를 블록 기준으로 바꿉니다.
+static const VkMappedMemoryRange* translate_ranges(
+    const DeviceMemoryTracker* tracker,
+    uint32_t count,
+    const VkMappedMemoryRange* ranges,
+    std::vector<VkMappedMemoryRange>* copies)
+{
+    if (!tracker) return ranges;
+    for (uint32_t i = 0; i < count; ++i) {
+        const DeviceMemoryTracker::SubAllocation* sub = tracker->find(ranges[i].memory);
+        if (!sub) continue;
+        if (copies->empty()) copies->assign(ranges, ranges + count);
+        VkMappedMemoryRange& range = (*copies)[i];
+        // 노드 크기는 nonCoherentAtomSize 의 배수이므로 VK_WHOLE_SIZE 를 노드 끝까지로 바꿔도 이웃과 겹치지 않습니다.
+        if (range.size == VK_WHOLE_SIZE) range.size = sub->node_size - range.offset;
+        range.memory = sub->memory;
+        range.offset += sub->offset;
+    }
+    return copies->empty() ? ranges : copies->data();
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkFlushMappedMemoryRanges(
+    VkDevice device,
+    uint32_t memoryRangeCount,
+    const VkMappedMemoryRange* pMemoryRanges)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    std::vector<VkMappedMemoryRange> copies;
+    return device_data->dispatch.FlushMappedMemoryRanges(
+        device, memoryRangeCount, translate_ranges(device_data->memory.get(), memoryRangeCount, pMemoryRanges, &copies));
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkInvalidateMappedMemoryRanges(
+    VkDevice device,
+    uint32_t memoryRangeCount,
+    const VkMappedMemoryRange* pMemoryRanges)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    std::vector<VkMappedMemoryRange> copies;
+    return device_data->dispatch.InvalidateMappedMemoryRanges(
+        device, memoryRangeCount, translate_ranges(device_data->memory.get(), memoryRangeCount, pMemoryRanges, &copies));
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkBindBufferMemory(
+    VkDevice device,
+    VkBuffer buffer,
+    VkDeviceMemory memory,
+    VkDeviceSize memoryOffset)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    if (!device_data->memory || !device_data->memory->find(memory)) {
+        return device_data->dispatch.BindBufferMemory(device, buffer, memory, memoryOffset);
+    }
+
+    VkMemoryRequirements requirements;
+    device_data->dispatch.GetBufferMemoryRequirements(device, buffer, &requirements);
+    VkResult result = device_data->memory->translate_bind(&memory, &memoryOffset, requirements.alignment);
+    if (result != VK_SUCCESS) return result;
+    return device_data->dispatch.BindBufferMemory(device, buffer, memory, memoryOffset);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkBindImageMemory(
+    VkDevice device,
+    VkImage image,
+    VkDeviceMemory memory,
+    VkDeviceSize memoryOffset)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    if (!device_data->memory || !device_data->memory->find(memory)) {
+        return device_data->dispatch.BindImageMemory(device, image, memory, memoryOffset);
+    }
+
+    VkMemoryRequirements requirements;
+    device_data->dispatch.GetImageMemoryRequirements(device, image, &requirements);
+    VkResult result = device_data->memory->translate_bind(&memory, &memoryOffset, requirements.alignment);
+    if (result != VK_SUCCESS) return result;
+    return device_data->dispatch.BindImageMemory(device, image, memory, memoryOffset);
+}
+
+static VkDeviceSize bind_alignment(const LayerDeviceData* device_data, VkDevice device,
+                                   const VkBindBufferMemoryInfo& info)
+{
+    VkMemoryRequirements requirements;
+    device_data->dispatch.GetBufferMemoryRequirements(device, info.buffer, &requirements);
+    return requirements.alignment;
+}
+
+// disjoint 이미지의 plane bind 는 그 plane 의 요구 사항으로 봅니다.
+static VkDeviceSize bind_alignment(const LayerDeviceData* device_data, VkDevice device,
+                                   const VkBindImageMemoryInfo& info)
+{
+    const VkBindImagePlaneMemoryInfo* plane = nullptr;
+    for (const VkBaseInStructure* next = static_cast<const VkBaseInStructure*>(info.pNext); next; next = next->pNext) {
+        if (next->sType == VK_STRUCTURE_TYPE_BIND_IMAGE_PLANE_MEMORY_INFO) {
+            plane = reinterpret_cast<const VkBindImagePlaneMemoryInfo*>(next);
+        }
+    }
+    PFN_vkGetImageMemoryRequirements2 get_requirements2 = device_data->dispatch.GetImageMemoryRequirements2
+                                                              ? device_data->dispatch.GetImageMemoryRequirements2
+                                                              : device_data->dispatch.GetImageMemoryRequirements2KHR;
+    if (!plane || !get_requirements2) {
+        VkMemoryRequirements requirements;
+        device_data->dispatch.GetImageMemoryRequirements(device, info.image, &requirements);
+        return requirements.alignment;
+    }
+    VkImagePlaneMemoryRequirementsInfo plane_info = {VK_STRUCTURE_TYPE_IMAGE_PLANE_MEMORY_REQUIREMENTS_INFO};
+    plane_info.planeAspect = plane->planeAspect;
+    VkImageMemoryRequirementsInfo2 requirements_info = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2};
+    requirements_info.pNext = &plane_info;
+    requirements_info.image = info.image;
+    VkMemoryRequirements2 requirements = {VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2};
+    get_requirements2(device, &requirements_info, &requirements);
+    return requirements.memoryRequirements.alignment;
+}
+
+// vkBind*Memory2 (+KHR) 공통. suballocation 이 있을 때만 복사본을 만듭니다.
+// 하나라도 alignment 를 맞출 수 없으면 어떤 suballocation 도 옮기거나 bound 로 표시하지 않고,
+// 드라이버를 부르지 않고 실패합니다.
+template <typename BindInfo, typename Bind>
+static VkResult bind_memory2(LayerDeviceData* device_data, VkDevice device, uint32_t count, const BindInfo* infos,
+                             Bind&& bind)
+{
+    DeviceMemoryTracker* tracker = device_data->memory.get();
+    if (!tracker) return bind(infos);
+    std::vector<BindInfo> copies;
+    std::vector<DeviceMemoryTracker::BindTranslation> binds;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!tracker->find(infos[i].memory)) continue;
+        if (copies.empty()) copies.assign(infos, infos + count);
+        binds.push_back({&copies[i].memory, &copies[i].memoryOffset, bind_alignment(device_data, device, infos[i])});
+    }
+    if (binds.empty()) return bind(infos);
+    VkResult result = tracker->translate_binds(binds.data(), (uint32_t)binds.size());
+    if (result != VK_SUCCESS) return result;
+    return bind(copies.data());
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkBindBufferMemory2(
+    VkDevice device,
+    uint32_t bindInfoCount,
+    const VkBindBufferMemoryInfo* pBindInfos)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    return bind_memory2(device_data, device, bindInfoCount, pBindInfos, [&](const VkBindBufferMemoryInfo* infos) {
+        return device_data->dispatch.BindBufferMemory2(device, bindInfoCount, infos);
+    });
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkBindBufferMemory2KHR(
+    VkDevice device,
+    uint32_t bindInfoCount,
+    const VkBindBufferMemoryInfo* pBindInfos)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    return bind_memory2(device_data, device, bindInfoCount, pBindInfos, [&](const VkBindBufferMemoryInfo* infos) {
+        return device_data->dispatch.BindBufferMemory2KHR(device, bindInfoCount, infos);
+    });
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkBindImageMemory2(
+    VkDevice device,
+    uint32_t bindInfoCount,
+    const VkBindImageMemoryInfo* pBindInfos)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    return bind_memory2(device_data, device, bindInfoCount, pBindInfos, [&](const VkBindImageMemoryInfo* infos) {
+        return device_data->dispatch.BindImageMemory2(device, bindInfoCount, infos);
+    });
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkBindImageMemory2KHR(
+    VkDevice device,
+    uint32_t bindInfoCount,
+    const VkBindImageMemoryInfo* pBindInfos)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    return bind_memory2(device_data, device, bindInfoCount, pBindInfos, [&](const VkBindImageMemoryInfo* infos) {
+        return device_data->dispatch.BindImageMemory2KHR(device, bindInfoCount, infos);
+    });
+}
+
+// 레이어가 만든 메모리 핸들은 드라이버가 모르므로 이름 / 태그를 넘기지 않습니다.
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkSetDebugUtilsObjectNameEXT(
+    VkDevice device,
+    const VkDebugUtilsObjectNameInfoEXT* pNameInfo)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    if (pNameInfo->objectType == VK_OBJECT_TYPE_DEVICE_MEMORY && device_data->memory &&
+        device_data->memory->find((VkDeviceMemory)pNameInfo->objectHandle)) {
+        return VK_SUCCESS;
+    }
+    return device_data->dispatch.SetDebugUtilsObjectNameEXT(device, pNameInfo);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkSetDebugUtilsObjectTagEXT(
+    VkDevice device,
+    const VkDebugUtilsObjectTagInfoEXT* pTagInfo)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    if (pTagInfo->objectType == VK_OBJECT_TYPE_DEVICE_MEMORY && device_data->memory &&
+        device_data->memory->find((VkDeviceMemory)pTagInfo->objectHandle)) {
+        return VK_SUCCESS;
+    }
+    return device_data->dispatch.SetDebugUtilsObjectTagEXT(device, pTagInfo);
+}
@@ -1,35 +1,22 @@
 #include <vulkan/vulkan.h>
 #include <vulkan/vk_layer.h>
-#include <android/log.h>
 
 #include <string.h>
-#include <unordered_map>
-#include <mutex>
+#include <algorithm>
+#include <array>
 #include <memory>
 
-// Android 로깅 매크로 정의
-#define LOG_TAG "MyLayer"
-#define ALOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
-#define ALOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+#include "api_trace.h"
+#include "hooks.h"
+#include "layer_data.h"
+#include "proc_table.h"
+#include "settings.h"
+#include "utils.h"
 
-// --- 데이터 관리 및 스레드 안전성 ---
-
-struct LayerInstanceData {
-    VkInstance instance;
-    PFN_vkGetInstanceProcAddr next_pfnGetInstanceProcAddr;
-    PFN_vkDestroyInstance next_pfnDestroyInstance;
-};
-
-struct LayerDeviceData {
-    VkDevice device;
-    PFN_vkGetDeviceProcAddr next_pfnGetDeviceProcAddr; 
-};
-
-static std::mutex g_device_mutex;
-static std::unordered_map<void*, std::unique_ptr<LayerDeviceData>> g_device_data_map;
-
-static std::mutex g_instance_mutex;
-static std::unordered_map<void*, std::unique_ptr<LayerInstanceData>> g_instance_data_map;
+HandleMap<LayerInstanceData> g_instance_data_map;
+HandleMap<LayerDeviceData> g_device_data_map;
+HandleMap<LayerQueueData> g_queue_data_map;
+HandleMap<LayerCommandBufferData> g_command_buffer_data_map;
 
 
 // --- 훅된 Vulkan 함수 구현 ---
@@ -38,23 +25,17 @@ VKAPI_ATTR void VKAPI_CALL Hook_vkDestroyInstance(
     VkInstance instance,
     const VkAllocationCallbacks* pAllocator)
 {
-    void* dispatch_key = *(void**)instance;
-    std::unique_ptr<LayerInstanceData> layer_data;
-    {
-        std::lock_guard<std::mutex> lock(g_instance_mutex);
-        auto it = g_instance_data_map.find(dispatch_key);
-        if (it != g_instance_data_map.end()) {
-            layer_data = std::move(it->second);
-            g_instance_data_map.erase(it);
-        }
-    }
+    std::unique_ptr<LayerInstanceData> layer_data = g_instance_data_map.erase(get_dispatch_key(instance));
 
     if (layer_data) {
         ALOGI("Hook_vkDestroyInstance! handle: %p", (void*)instance);
-        layer_data->next_pfnDestroyInstance(instance, pAllocator);
+        layer_data->dispatch.DestroyInstance(instance, pAllocator);
     } else {
         ALOGE("Hook_vkDestroyInstance: unknown instance.");
     }
+
+    // 앱이 곧 종료될 수 있으므로 남은 로그를 내보냅니다.
+    log_flush();
 }
 
 
@@ -96,16 +77,13 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkCreateInstance(
 
     auto layer_data = std::make_unique<LayerInstanceData>();
     layer_data->instance = *pInstance;
-    layer_data->next_pfnGetInstanceProcAddr = next_pfnGetInstanceProcAddr;
-    
-    // 다음 레이어의 다른 함수 포인터들은 next_pfnGetInstanceProcAddr를 통해 가져옵니다.
-    layer_data->next_pfnDestroyInstance = (PFN_vkDestroyInstance)next_pfnGetInstanceProcAddr(*pInstance, "vkDestroyInstance");
-    
-    void* dispatch_key = *(void**)*pInstance;
-    {
-        std::lock_guard<std::mutex> lock(g_instance_mutex);
-        g_instance_data_map[dispatch_key] = std::move(layer_data);
-    }
+    layer_data->api_version = (pCreateInfo->pApplicationInfo && pCreateInfo->pApplicationInfo->apiVersion)
+        ? pCreateInfo->pApplicationInfo->apiVersion : VK_API_VERSION_1_0;
+
+    // 다음 레이어의 함수 포인터들을 한 번에 가져와 디스패치 테이블을 채웁니다.
+    init_instance_dispatch_table(&layer_data->dispatch, *pInstance, next_pfnGetInstanceProcAddr);
+
+    g_instance_data_map.insert(get_dispatch_key(*pInstance), std::move(layer_data));
 
     ALOGI("vkCreateInstance called successfully. handle: %p", (void*)*pInstance);
     if (pCreateInfo && pCreateInfo->pApplicationInfo) {
@@ -122,27 +100,35 @@ VKAPI_ATTR void VKAPI_CALL Hook_vkDestroyDevice(
     VkDevice device,
     const VkAllocationCallbacks* pAllocator)
 {
-    void* dispatch_key = *(void**)device;
-    std::unique_ptr<LayerDeviceData> device_data;
-    
     // 1. 디바이스 데이터 맵에서 데이터 검색 및 제거
-    {
-        std::lock_guard<std::mutex> lock(g_device_mutex);
-        auto it = g_device_data_map.find(dispatch_key);
-        if (it != g_device_data_map.end()) {
-            device_data = std::move(it->second);
-            g_device_data_map.erase(it);
+    std::unique_ptr<LayerDeviceData> device_data = g_device_data_map.erase(get_dispatch_key(device));
+
+    if (device_data) {
+        // 디바이스에 속한 큐 / 커맨드 버퍼 데이터도 함께 정리합니다.
+        uint32_t queue_count = device_data->queue_count.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < queue_count; ++i) {
+            // 페이싱은 도중에 켜고 끌 수 있으므로 기록이 있으면 남깁니다.
+            log_frame_pacer_stats("frame_pacer (device destroyed)", device_data->queues[i], false);
+            if (device_data->queues[i]->profile.telemetry_ring) {
+                telemetry_release_ring(device_data->queues[i]->profile.telemetry_ring);
+            }
+            g_queue_data_map.erase(device_data->queues[i]->queue);
+        }
+        erase_command_buffers(device_data.get(), VK_NULL_HANDLE);
+        if (device_data->state_filter.enabled) {
+            log_state_filter_stats("state_filter (device destroyed)", device_data->state_filter_totals.load());
         }
-    }
 
-    if (device_data && device_data->next_pfnGetDeviceProcAddr) {
-        // 2. 다음 체인의 vkDestroyDevice를 얻어 호출
-        PFN_vkDestroyDevice next_pfnDestroyDevice = (PFN_vkDestroyDevice)
-            device_data->next_pfnGetDeviceProcAddr(device, "vkDestroyDevice");
+        // 파이프라인 캐시를 마지막으로 저장하고 파괴합니다. 공유 셰이더 모듈과 메모리 블록도 디바이스보다
+        // 먼저 정리합니다.
+        device_data->pipeline_cache.reset();
+        device_data->shader_modules.reset();
+        device_data->memory.reset();
 
-        if (next_pfnDestroyDevice) {
+        // 2. 다음 체인의 vkDestroyDevice 호출
+        if (device_data->dispatch.DestroyDevice) {
             ALOGI("Hook_vkDestroyDevice! Device: %p", (void*)device);
-            next_pfnDestroyDevice(device, pAllocator);
+            device_data->dispatch.DestroyDevice(device, pAllocator);
         } else {
             // 다음 체인의 vkDestroyDevice를 찾지 못해도 메모리 정리를 위해 경고 후 종료
             ALOGE("Hook_vkDestroyDevice: Not found next vkDestroyDevice");
@@ -158,22 +144,15 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkCreateDevice(
     const VkAllocationCallbacks* pAllocator,
     VkDevice* pDevice)
 {
-    // 1. 다음 레이어의 vkGetInstanceProcAddr를 찾아 다음 vkCreateDevice를 얻습니다.
-    void* instance_dispatch_key = *(void**)physicalDevice;
-    std::lock_guard<std::mutex> lock(g_instance_mutex);
-    auto it = g_instance_data_map.find(instance_dispatch_key);
-
-    if (it == g_instance_data_map.end()) {
+    // 1. 인스턴스 디스패치 테이블에서 다음 vkCreateDevice를 얻습니다.
+    //    조회는 lock-free 이므로 다른 스레드의 디바이스 생성과 직렬화되지 않습니다.
+    LayerInstanceData* instance_data = g_instance_data_map.find(get_dispatch_key(physicalDevice));
+    if (!instance_data) {
         ALOGE("Hook_vkCreateDevice: Not found LayerInstanceData");
         return VK_ERROR_INITIALIZATION_FAILED;
     }
 
-    LayerInstanceData* instance_data = it->second.get();
-    
-    // next_pfnGetInstanceProcAddr를 통해 다음 체인의 vkCreateDevice 포인터를 얻습니다.
-    PFN_vkCreateDevice next_pfnCreateDevice = (PFN_vkCreateDevice)
-        instance_data->next_pfnGetInstanceProcAddr(instance_data->instance, "vkCreateDevice");
-
+    PFN_vkCreateDevice next_pfnCreateDevice = instance_data->dispatch.CreateDevice;
     if (!next_pfnCreateDevice) {
         ALOGE("Hook_vkCreateDevice: Not found next vkCreateDevice.");
         return VK_ERROR_INITIALIZATION_FAILED;
@@ -190,6 +169,9 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkCreateDevice(
         return VK_ERROR_INITIALIZATION_FAILED;
     }
 
+    // 체인을 넘기기 전에 다음 레이어의 vkGetDeviceProcAddr를 저장해 둡니다.
+    PFN_vkGetDeviceProcAddr next_pfnGetDeviceProcAddr = layerCreateInfo->u.pLayerInfo->pfnNextGetDeviceProcAddr;
+
     // 다음 Layer의 정보를 가리키도록 체인 갱신
     layerCreateInfo->u.pLayerInfo = layerCreateInfo->u.pLayerInfo->pNext;
     
@@ -200,20 +182,51 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkCreateDevice(
         return result;
     }
     
-    // 4. LayerDeviceData 초기화 및 연결
+    // 4. LayerDeviceData 초기화 및 디스패치 테이블 채우기
     auto device_data = std::make_unique<LayerDeviceData>();
     device_data->device = *pDevice;
+    device_data->physical_device = physicalDevice;
+    device_data->instance_data = instance_data;
+    init_device_dispatch_table(&device_data->dispatch, *pDevice, next_pfnGetDeviceProcAddr);
+
+    if (!layer_settings().targeted) {
+        // pass-through: vkGetDeviceProcAddr 가 다음 체인의 포인터를 돌려주므로 기능은 모두 끕니다.
+        device_data->profile.config.enabled = false;
+        device_data->command_stats_enabled = false;
+        g_device_data_map.insert(get_dispatch_key(*pDevice), std::move(device_data));
+        return VK_SUCCESS;
+    }
 
-    // next_pfnGetDeviceProcAddr를 얻어 저장합니다.
-    PFN_vkGetDeviceProcAddr next_pfnGetDeviceProcAddr = layerCreateInfo->u.pLayerInfo->pfnNextGetDeviceProcAddr;
-    device_data->next_pfnGetDeviceProcAddr = next_pfnGetDeviceProcAddr;
-    
-    // VkDevice 핸들에서 디스패치 키를 가져와 맵에 저장합니다.
-    void* device_dispatch_key = *(void**)*pDevice;
-    {
-        std::lock_guard<std::mutex> lock(g_device_mutex);
-        g_device_data_map[device_dispatch_key] = std::move(device_data);
+    // 여기서 읽는 설정은 디바이스가 살아 있는 동안 유지됩니다. (프레임 페이싱만 present 마다 읽음)
+    device_data->profile.config = load_frame_profiler_config();
+    device_data->display_timing = display_timing_enabled(pCreateInfo);
+    telemetry_init();
+    api_trace_init();
+    device_data->command_stats_enabled = load_command_stats_enabled();
+
+    instance_data->dispatch.GetPhysicalDeviceProperties(physicalDevice, &device_data->properties);
+    device_data->api_version = std::min(instance_data->api_version, device_data->properties.apiVersion);
+    device_data->state_filter = load_state_filter_config(pCreateInfo, device_data->api_version);
+    device_data->track_command_buffers = device_data->command_stats_enabled || device_data->state_filter.enabled;
+
+    // VkPipelineCreationFeedbackCreateInfo 는 1.3 core 이거나 확장이 켜져 있어야 쓸 수 있습니다.
+    bool creation_feedback_supported = device_data->api_version >= VK_API_VERSION_1_3;
+    for (uint32_t i = 0; i < pCreateInfo->enabledExtensionCount; ++i) {
+        if (strcmp(pCreateInfo->ppEnabledExtensionNames[i], VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME) == 0) {
+            creation_feedback_supported = true;
+        }
     }
+    device_data->pipeline_cache = PipelineCacheStore::create(
+        *pDevice, &device_data->dispatch, device_data->properties, creation_feedback_supported);
+    device_data->shader_modules = ShaderModuleCache::create(*pDevice, &device_data->dispatch, pCreateInfo);
+
+    VkPhysicalDeviceMemoryProperties memory_properties;
+    instance_data->dispatch.GetPhysicalDeviceMemoryProperties(physicalDevice, &memory_properties);
+    device_data->memory = DeviceMemoryTracker::create(
+        *pDevice, &device_data->dispatch, device_data->properties, memory_properties, pCreateInfo);
+
+    // VkDevice 핸들에서 디스패치 키를 가져와 맵에 저장합니다.
+    g_device_data_map.insert(get_dispatch_key(*pDevice), std::move(device_data));
 
     ALOGI("Hook_vkCreateDevice Success, Device: %p", (void*)*pDevice);
     return VK_SUCCESS;
@@ -222,30 +235,82 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkCreateDevice(
 
 // --- 로더 인터페이스 함수 ---
 
+// kProcInfos 인덱스 -> 훅 함수. 훅하지 않는 명령은 nullptr.
+static const std::array<PFN_vkVoidFunction, kProcCount> g_proc_hooks = [] {
+    std::array<PFN_vkVoidFunction, kProcCount> hooks{};
+#define MY_LAYER_REGISTER_HOOK(name) { \
+        constexpr int index = find_proc_index(std::string_view("vk" #name)); \
+        static_assert(index >= 0, "vk" #name " is not in kProcInfos"); \
+        hooks[index] = (PFN_vkVoidFunction)Hook_vk##name; \
+    }
+    MY_LAYER_HOOKED_COMMANDS(MY_LAYER_REGISTER_HOOK)
+#undef MY_LAYER_REGISTER_HOOK
+    hooks[find_proc_index("vkGetInstanceProcAddr")] = (PFN_vkVoidFunction)vkGetInstanceProcAddr;
+    hooks[find_proc_index("vkGetDeviceProcAddr")] = (PFN_vkVoidFunction)vkGetDeviceProcAddr;
+    return hooks;
+}();
+
+// 대상 프로세스가 아닐 때의 훅. 디스패치 테이블을 만들고 정리하는 명령만 훅하고, 나머지는 다음 체인의
+// 포인터를 그대로 돌려줘서 레이어를 거치지 않게 합니다.
+static const std::array<PFN_vkVoidFunction, kProcCount> g_pass_through_hooks = [] {
+    std::array<PFN_vkVoidFunction, kProcCount> hooks{};
+    for (const char* name : {"vkCreateInstance", "vkDestroyInstance", "vkCreateDevice", "vkDestroyDevice",
+                             "vkGetInstanceProcAddr", "vkGetDeviceProcAddr"}) {
+        int index = find_proc_index(name);
+        hooks[index] = g_proc_hooks[index];
+    }
+    return hooks;
+}();
+
+// 커맨드 버퍼를 추적할 때만 필요한 훅 (할당 / 기록 / vkCmd*). cmd_stats 와 상태 필터가 모두 꺼진
+// 디바이스에는 다음 체인의 포인터를 돌려줘서 기록 경로에 레이어를 넣지 않습니다.
+static const std::array<bool, kProcCount> g_command_buffer_hooks = [] {
+    std::array<bool, kProcCount> hooks{};
+    for (size_t index = 0; index < kProcCount; ++index) {
+        std::string_view name = kProcInfos[index].name;
+        hooks[index] = g_proc_hooks[index] &&
+                       (name.substr(0, 5) == "vkCmd" || name == "vkAllocateCommandBuffers" ||
+                        name == "vkBeginCommandBuffer" || name == "vkEndCommandBuffer");
+    }
+    return hooks;
+}();
+
+static const std::array<PFN_vkVoidFunction, kProcCount>& layer_hooks() {
+    return layer_settings().targeted ? g_proc_hooks : g_pass_through_hooks;
+}
+
+PFN_vkVoidFunction get_layer_hook(int proc_index) {
+    return g_proc_hooks[proc_index];
+}
+
 // Find a function pointer of device level functions (ex. vkCmdDraw, vkQueueSubmit)
 VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vkGetDeviceProcAddr(
     VkDevice device,
     const char* pName)
 {
-    if (strcmp(pName, "vkGetDeviceProcAddr") == 0) return (PFN_vkVoidFunction)vkGetDeviceProcAddr;
-    
-    // (선택 사항) 훅킹할 디바이스 레벨 함수 목록을 여기에 추가합니다.
-    // if (strcmp(pName, "vkQueueSubmit") == 0) return (PFN_vkVoidFunction)Hook_vkQueueSubmit;
-
-    if (device != VK_NULL_HANDLE) {
-        void* dispatch_key = *(void**)device;
-        std::lock_guard<std::mutex> lock(g_device_mutex);
-        auto it = g_device_data_map.find(dispatch_key);
-        
-        if (it != g_device_data_map.end()) {
-            LayerDeviceData* device_data = it->second.get();
-            if (device_data && device_data->next_pfnGetDeviceProcAddr) {
-                return device_data->next_pfnGetDeviceProcAddr(device, pName);
-            }
-        }
+    int index = find_proc_index(pName);
+    if (index >= 0 && kProcInfos[index].level != ProcLevel::Device) {
+        // instance 레벨 명령은 vkGetDeviceProcAddr로 얻을 수 없습니다.
+        return nullptr;
     }
-    
-    return nullptr;
+
+    if (device == VK_NULL_HANDLE) return nullptr;
+    LayerDeviceData* device_data = g_device_data_map.find(get_dispatch_key(device));
+    if (!device_data) return nullptr;
+
+    if (index < 0) {
+        // 레이어가 모르는 (확장) 명령은 다음 체인에 그대로 물어봅니다.
+        return device_data->dispatch.GetDeviceProcAddr(device, pName);
+    }
+
+    // 다음 체인이 지원하지 않는 명령 (활성화되지 않은 확장 등) 은 훅하지 않고 nullptr 을 돌려줍니다.
+    PFN_vkVoidFunction next = read_dispatch_slot(device_data->dispatch, kProcInfos[index].dispatch_offset);
+    if (next && api_trace_enabled()) {
+        if (PFN_vkVoidFunction thunk = api_trace_thunk(index)) return thunk;
+    }
+    if (!device_data->track_command_buffers && g_command_buffer_hooks[index]) return next;
+    PFN_vkVoidFunction hook = layer_hooks()[index];
+    return next && hook ? hook : next;
 }
 
 // Find a function pointer of instance level functions. (ex. vkCreateInstance, vkCreateDevice)
@@ -253,23 +318,19 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vkGetInstanceProcAddr(
     VkInstance instance,
     const char* pName)
 {
-    if (strcmp(pName, "vkCreateInstance") == 0) return (PFN_vkVoidFunction)Hook_vkCreateInstance;
-    if (strcmp(pName, "vkDestroyInstance") == 0) return (PFN_vkVoidFunction)Hook_vkDestroyInstance;
-    if (strcmp(pName, "vkCreateDevice") == 0) return (PFN_vkVoidFunction)Hook_vkCreateDevice;
-    if (strcmp(pName, "vkDestroyDevice") == 0) return (PFN_vkVoidFunction)Hook_vkDestroyDevice;
-    if (strcmp(pName, "vkGetInstanceProcAddr") == 0) return (PFN_vkVoidFunction)vkGetInstanceProcAddr;
-    if (strcmp(pName, "vkGetDeviceProcAddr") == 0) return (PFN_vkVoidFunction)vkGetDeviceProcAddr;
-
-    if (instance != VK_NULL_HANDLE) {
-        void* dispatch_key = *(void**)instance;
-        std::lock_guard<std::mutex> lock(g_instance_mutex);
-        auto it = g_instance_data_map.find(dispatch_key);
-        if (it != g_instance_data_map.end()) {
-            return it->second->next_pfnGetInstanceProcAddr(instance, pName);
-        }
+    int index = find_proc_index(pName);
+    if (index >= 0 && layer_hooks()[index]) return layer_hooks()[index];
+
+    if (instance == VK_NULL_HANDLE) return NULL;
+    LayerInstanceData* instance_data = g_instance_data_map.find(get_dispatch_key(instance));
+    if (!instance_data) return NULL;
+
+    if (index >= 0 && kProcInfos[index].level == ProcLevel::Instance) {
+        return read_dispatch_slot(instance_data->dispatch, kProcInfos[index].dispatch_offset);
     }
 
-    return NULL;
+    // global / device 레벨 명령과 레이어가 모르는 명령은 다음 체인에 물어봅니다.
+    return instance_data->dispatch.GetInstanceProcAddr(instance, pName);
 }
 
  VKAPI_ATTR VkResult VKAPI_CALL vkNegotiateLoaderLayerInterfaceVersion(
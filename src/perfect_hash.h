@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// 컴파일 타임에 만드는 문자열 perfect hash 테이블 (hash-and-displace).
+//
+// 1. 각 키의 64bit FNV-1a 해시를 상위 비트로 버킷에 나눕니다.
+// 2. 큰 버킷부터 displacement 값 d 를 0 부터 올려가며, 버킷의 모든 키가
+//    빈 슬롯에 충돌 없이 들어가는 d 를 찾습니다.
+// 조회는 해시 1회 + displacement 1회 + 문자열 비교 1회로 끝나며 동적 할당이 없습니다.
+// 빌드에 실패하면 (중복 키 등) 상수 평가가 실패하므로 컴파일 에러가 납니다.
+
+namespace perfect_hash_detail {
+
+inline void build_failed() {}  // constexpr 가 아니므로 상수 평가 중 호출되면 컴파일 에러
+
+constexpr uint64_t kFnvOffset = 0xcbf29ce484222325ull;
+constexpr uint64_t kFnvPrime = 0x100000001b3ull;
+
+constexpr uint64_t mix(uint64_t h, uint32_t displacement) {
+    h ^= displacement * 0x9E3779B97F4A7C15ull;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h;
+}
+
+constexpr size_t ceil_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+}  // namespace perfect_hash_detail
+
+constexpr uint64_t perfect_hash_string(std::string_view s) {
+    uint64_t h = perfect_hash_detail::kFnvOffset;
+    for (char c : s) {
+        h ^= static_cast<uint8_t>(c);
+        h *= perfect_hash_detail::kFnvPrime;
+    }
+    return h;
+}
+
+template <size_t N>
+class PerfectHashTable {
+public:
+    static constexpr size_t kSlotCount = perfect_hash_detail::ceil_pow2(N * 2);
+    static constexpr size_t kBucketCount = perfect_hash_detail::ceil_pow2((N + 3) / 4);
+
+    constexpr explicit PerfectHashTable(const std::array<std::string_view, N>& keys)
+        : m_keys(keys)
+    {
+        using namespace perfect_hash_detail;
+
+        std::array<uint64_t, N> hashes{};
+        std::array<uint16_t, kBucketCount> bucket_sizes{};
+        for (size_t i = 0; i < N; ++i) {
+            hashes[i] = perfect_hash_string(keys[i]);
+            bucket_sizes[bucket_of(hashes[i])]++;
+        }
+
+        // 큰 버킷부터 배치합니다. 같은 버킷의 키는 order 에서 연속으로 놓입니다.
+        std::array<uint16_t, N> order{};
+        for (size_t i = 0; i < N; ++i) order[i] = static_cast<uint16_t>(i);
+        std::sort(order.begin(), order.end(), [&](uint16_t a, uint16_t b) {
+            size_t bucket_a = bucket_of(hashes[a]);
+            size_t bucket_b = bucket_of(hashes[b]);
+            if (bucket_sizes[bucket_a] != bucket_sizes[bucket_b]) {
+                return bucket_sizes[bucket_a] > bucket_sizes[bucket_b];
+            }
+            if (bucket_a != bucket_b) return bucket_a < bucket_b;
+            return hashes[a] < hashes[b];
+        });
+
+        m_slots.fill(-1);
+        for (size_t begin = 0; begin < N;) {
+            size_t bucket = bucket_of(hashes[order[begin]]);
+            size_t end = begin + bucket_sizes[bucket];
+
+            // 같은 버킷 안에서 해시가 같으면 중복 키(또는 64bit 충돌)이므로 배치할 수 없습니다.
+            for (size_t m = begin + 1; m < end; ++m) {
+                if (hashes[order[m]] == hashes[order[m - 1]]) build_failed();
+            }
+
+            bool placed = false;
+            for (uint32_t d = 0; d < 0x10000 && !placed; ++d) {
+                placed = true;
+                for (size_t m = begin; m < end && placed; ++m) {
+                    size_t slot = mix(hashes[order[m]], d) & (kSlotCount - 1);
+                    if (m_slots[slot] != -1) placed = false;
+                    for (size_t k = begin; k < m && placed; ++k) {
+                        if ((mix(hashes[order[k]], d) & (kSlotCount - 1)) == slot) placed = false;
+                    }
+                }
+                if (placed) {
+                    m_displacements[bucket] = static_cast<uint16_t>(d);
+                    for (size_t m = begin; m < end; ++m) {
+                        m_slots[mix(hashes[order[m]], d) & (kSlotCount - 1)] = static_cast<int16_t>(order[m]);
+                    }
+                }
+            }
+            if (!placed) build_failed();
+            begin = end;
+        }
+    }
+
+    static constexpr size_t size() { return N; }
+
+    constexpr std::string_view key(size_t index) const { return m_keys[index]; }
+
+    // 키의 인덱스 (생성자에 넘긴 배열 기준) 를 돌려주고, 없으면 -1.
+    constexpr int find(std::string_view name) const {
+        return find_hashed(name, perfect_hash_string(name));
+    }
+
+    // ProcAddr 용 런타임 경로. strlen 과 해시를 한 번의 순회로 계산합니다.
+    int find(const char* name) const {
+        uint64_t h = perfect_hash_detail::kFnvOffset;
+        const char* p = name;
+        for (; *p; ++p) {
+            h ^= static_cast<uint8_t>(*p);
+            h *= perfect_hash_detail::kFnvPrime;
+        }
+        return find_hashed(std::string_view(name, static_cast<size_t>(p - name)), h);
+    }
+
+private:
+    static constexpr size_t bucket_of(uint64_t h) {
+        return static_cast<size_t>(h >> 40) & (kBucketCount - 1);
+    }
+
+    constexpr int find_hashed(std::string_view name, uint64_t h) const {
+        size_t slot = perfect_hash_detail::mix(h, m_displacements[bucket_of(h)]) & (kSlotCount - 1);
+        int index = m_slots[slot];
+        if (index < 0 || m_keys[index] != name) return -1;
+        return index;
+    }
+
+    std::array<std::string_view, N> m_keys;
+    std::array<uint16_t, kBucketCount> m_displacements{};
+    std::array<int16_t, kSlotCount> m_slots{};
+};
@@ -0,0 +1,398 @@
+#include "pipeline_cache.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+
+#include <unistd.h>
+
+#include "hash.h"
+#include "settings.h"
+#include "utils.h"
+
+namespace {
+
+constexpr uint32_t kFileMagic = 0x43504c4d;  // "MLPC"
+constexpr uint32_t kFileVersion = 1;
+
+// 파일 앞에 붙는 레이어 헤더. 뒤에 vkGetPipelineCacheData 결과가 data_size 만큼 이어집니다.
+struct PipelineCacheFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vendor_id;
+    uint32_t device_id;
+    uint32_t driver_version;
+    uint8_t pipeline_cache_uuid[VK_UUID_SIZE];
+    uint32_t reserved;
+    uint64_t data_size;
+    uint64_t data_hash;
+};
+
+bool matches_device(const PipelineCacheFileHeader& header, const VkPhysicalDeviceProperties& properties) {
+    return header.magic == kFileMagic &&
+           header.version == kFileVersion &&
+           header.vendor_id == properties.vendorID &&
+           header.device_id == properties.deviceID &&
+           header.driver_version == properties.driverVersion &&
+           memcmp(header.pipeline_cache_uuid, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+// 드라이버가 만든 캐시 데이터의 Vulkan 헤더 (VkPipelineCacheHeaderVersionOne) 도 확인합니다.
+bool matches_device(const std::vector<uint8_t>& data, const VkPhysicalDeviceProperties& properties) {
+    VkPipelineCacheHeaderVersionOne header;
+    if (data.size() < sizeof(header)) return false;
+    memcpy(&header, data.data(), sizeof(header));
+    return header.headerSize >= sizeof(header) &&
+           header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == properties.vendorID &&
+           header.deviceID == properties.deviceID &&
+           memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+std::string make_cache_path(const std::string& dir, const VkPhysicalDeviceProperties& properties) {
+    char key[2 * VK_UUID_SIZE + 16];
+    size_t n = 0;
+    for (uint32_t i = 0; i < VK_UUID_SIZE; ++i) {
+        n += (size_t)snprintf(key + n, sizeof(key) - n, "%02x", properties.pipelineCacheUUID[i]);
+    }
+    snprintf(key + n, sizeof(key) - n, "_%08x", properties.driverVersion);
+    return dir + "/pipeline_cache_" + to_file_name_part(get_app_package_name()) + "_" + key + ".bin";
+}
+
+double ns_to_ms(uint64_t ns) {
+    return (double)ns / 1e6;
+}
+
+// vkDestroyDevice 가 마지막 저장 (파일 쓰기 + fsync) 을 기다리는 최대 시간
+constexpr uint32_t kFinalSaveTimeoutMs = 100;
+
+// 임시 파일에 다 쓴 뒤 rename 해서, 읽는 쪽은 항상 완전한 파일만 봅니다.
+bool write_file(const std::string& path, const std::vector<uint8_t>& contents) {
+    std::string tmp_path = path + ".tmp";
+    FILE* file = fopen(tmp_path.c_str(), "wb");
+    if (!file) {
+        ALOGW("pipeline cache: can't write %s", tmp_path.c_str());
+        return false;
+    }
+    bool written = fwrite(contents.data(), 1, contents.size(), file) == contents.size() &&
+                   fflush(file) == 0 &&
+                   fsync(fileno(file)) == 0;
+    written = (fclose(file) == 0) && written;
+    if (!written || rename(tmp_path.c_str(), path.c_str()) != 0) {
+        ALOGW("pipeline cache: failed to save %s", path.c_str());
+        unlink(tmp_path.c_str());
+        return false;
+    }
+    ALOGI("pipeline cache: saved %zu bytes to %s", contents.size(), path.c_str());
+    return true;
+}
+
+// 캐시 파일을 쓰는 프로세스 전역 스레드. 디바이스가 먼저 파괴되어도 맡은 파일은 끝까지 씁니다.
+// (디바이스 핸들은 쓰지 않습니다)
+class CacheFileWriter {
+public:
+    ~CacheFileWriter() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wakeup.notify_all();
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+    // path 에 쓸 내용을 맡기고 ticket 을 돌려줍니다. 같은 path 에 아직 쓰지 않은 내용이 있으면 버립니다.
+    uint64_t submit(const std::string& path, std::vector<uint8_t> contents) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_pending.begin(); it != m_pending.end(); ++it) {
+            if (it->path == path) {
+                m_pending.erase(it);
+                break;
+            }
+        }
+        uint64_t ticket = ++m_submitted;
+        m_pending.push_back({path, std::move(contents), ticket});
+        if (!m_thread.joinable()) m_thread = std::thread(&CacheFileWriter::write_loop, this);
+        m_wakeup.notify_all();
+        return ticket;
+    }
+
+    // ticket 까지 다 쓸 때까지 최대 timeout_ms 기다립니다. 시간 안에 끝났으면 true.
+    bool wait(uint64_t ticket, uint32_t timeout_ms) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_flushed.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                                  [&] { return m_completed >= ticket; });
+    }
+
+private:
+    struct Pending {
+        std::string path;
+        std::vector<uint8_t> contents;
+        uint64_t ticket;
+    };
+
+    void write_loop() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_wakeup.wait(lock, [&] { return m_stopping || !m_pending.empty(); });
+            if (m_pending.empty()) break;  // 멈출 때도 남은 파일은 다 씁니다.
+            Pending pending = std::move(m_pending.front());
+            m_pending.pop_front();
+
+            lock.unlock();
+            write_file(pending.path, pending.contents);
+            lock.lock();
+            // 큐는 ticket 순서이므로 이 ticket 이하는 모두 끝났습니다.
+            m_completed = pending.ticket;
+            m_flushed.notify_all();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_flushed;
+    std::deque<Pending> m_pending;
+    uint64_t m_submitted = 0;
+    uint64_t m_completed = 0;
+    bool m_stopping = false;
+    std::thread m_thread;
+};
+
+CacheFileWriter& cache_file_writer() {
+    static CacheFileWriter writer;
+    return writer;
+}
+
+}  // namespace
+
+std::unique_ptr<PipelineCacheStore> PipelineCacheStore::create(
+    VkDevice device,
+    const DeviceDispatchTable* dispatch,
+    const VkPhysicalDeviceProperties& properties,
+    bool creation_feedback_supported)
+{
+    const LayerSettings& settings = layer_settings();
+    if (!settings.pipeline_cache) return nullptr;
+    if (!dispatch->CreatePipelineCache || !dispatch->GetPipelineCacheData || !dispatch->MergePipelineCaches) {
+        return nullptr;
+    }
+
+    std::string dir = settings.pipeline_cache_dir;
+    if (dir.empty()) dir = platform_get_cache_dir(get_app_package_name());
+    if (dir.empty()) {
+        ALOGW("pipeline cache: no cache directory, disabled");
+        return nullptr;
+    }
+
+    uint64_t save_interval_ms = settings.pipeline_cache_save_interval_s * 1000;
+    std::unique_ptr<PipelineCacheStore> store(new PipelineCacheStore(
+        device, dispatch, make_cache_path(dir, properties), save_interval_ms, creation_feedback_supported));
+    store->m_properties = properties;
+
+    VkPipelineCacheCreateInfo create_info = {VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+    VkResult result = dispatch->CreatePipelineCache(device, &create_info, nullptr, &store->m_store_cache);
+    if (result != VK_SUCCESS) {
+        ALOGE("pipeline cache: vkCreatePipelineCache failed: VkResult %d", result);
+        store->m_store_cache = VK_NULL_HANDLE;
+        return nullptr;
+    }
+
+    std::vector<uint8_t> initial_data = store->read_file(properties);
+    create_info.initialDataSize = initial_data.size();
+    create_info.pInitialData = initial_data.empty() ? nullptr : initial_data.data();
+    result = dispatch->CreatePipelineCache(device, &create_info, nullptr, &store->m_cache);
+    if (result != VK_SUCCESS && !initial_data.empty()) {
+        // 드라이버가 데이터를 거부하면 빈 캐시로 다시 시도합니다.
+        ALOGW("pipeline cache: driver rejected %s (VkResult %d)", store->m_path.c_str(), result);
+        create_info.initialDataSize = 0;
+        create_info.pInitialData = nullptr;
+        result = dispatch->CreatePipelineCache(device, &create_info, nullptr, &store->m_cache);
+    }
+    if (result != VK_SUCCESS) {
+        ALOGE("pipeline cache: vkCreatePipelineCache failed: VkResult %d", result);
+        store->m_cache = VK_NULL_HANDLE;
+        return nullptr;
+    }
+
+    ALOGI("pipeline cache: %s, %zu bytes loaded", store->m_path.c_str(), initial_data.size());
+    store->m_saved_size = initial_data.size();
+    store->m_saved_hash = fnv1a_64(initial_data.data(), initial_data.size());
+    store->m_snapshot_thread = std::thread([s = store.get()] { s->snapshot_loop(); });
+    return store;
+}
+
+PipelineCacheStore::PipelineCacheStore(VkDevice device, const DeviceDispatchTable* dispatch, std::string path,
+                                       uint64_t save_interval_ms, bool creation_feedback_supported)
+    : m_device(device),
+      m_dispatch(dispatch),
+      m_path(std::move(path)),
+      m_save_interval_ms(save_interval_ms),
+      m_creation_feedback_supported(creation_feedback_supported)
+{
+}
+
+PipelineCacheStore::~PipelineCacheStore() {
+    if (m_snapshot_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_snapshot_mutex);
+            m_stop = true;
+        }
+        m_snapshot_cv.notify_one();
+        m_snapshot_thread.join();
+
+        // 디바이스가 살아 있을 때 내용을 모으고, 파일은 writer 가 씁니다.
+        uint64_t ticket = save();
+        if (ticket != 0 && !cache_file_writer().wait(ticket, kFinalSaveTimeoutMs)) {
+            ALOGW("pipeline cache: final save still in progress after %u ms, continuing in the background",
+                  kFinalSaveTimeoutMs);
+        }
+    }
+    if (m_cache != VK_NULL_HANDLE) {
+        log_stats("device destroyed");
+        m_dispatch->DestroyPipelineCache(m_device, m_cache, nullptr);
+    }
+    if (m_store_cache != VK_NULL_HANDLE) m_dispatch->DestroyPipelineCache(m_device, m_store_cache, nullptr);
+}
+
+void PipelineCacheStore::on_app_cache_created(VkPipelineCache app_cache, const VkPipelineCacheCreateInfo* create_info) {
+    // 앱이 자기 데이터를 넘기지 않은 빈 캐시만 채워 줍니다.
+    // (m_store_cache 는 save / on_app_cache_destroyed 가 dst 로 쓰므로 lock 아래에서 읽습니다)
+    if (create_info->initialDataSize == 0) {
+        VkPipelineCache sources[] = {m_cache, m_store_cache};
+        std::lock_guard<std::mutex> lock(m_store_mutex);
+        m_dispatch->MergePipelineCaches(m_device, app_cache, 2, sources);
+    }
+    // 외부 동기화 캐시는 앱이 쓰는 도중에 읽을 수 없으므로 파괴 시에만 merge 합니다.
+    if (!(create_info->flags & VK_PIPELINE_CACHE_CREATE_EXTERNALLY_SYNCHRONIZED_BIT)) {
+        std::lock_guard<std::mutex> lock(m_app_caches_mutex);
+        m_app_caches.push_back(app_cache);
+    }
+}
+
+void PipelineCacheStore::on_app_cache_destroyed(VkPipelineCache app_cache) {
+    {
+        std::lock_guard<std::mutex> lock(m_app_caches_mutex);
+        for (size_t i = 0; i < m_app_caches.size(); ++i) {
+            if (m_app_caches[i] == app_cache) {
+                m_app_caches[i] = m_app_caches.back();
+                m_app_caches.pop_back();
+                break;
+            }
+        }
+    }
+    std::lock_guard<std::mutex> lock(m_store_mutex);
+    m_dispatch->MergePipelineCaches(m_device, m_store_cache, 1, &app_cache);
+}
+
+void PipelineCacheStore::record_feedback(const VkPipelineCreationFeedback& feedback) {
+    if (!(feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT)) {
+        m_untracked_pipelines.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    m_pipelines.fetch_add(1, std::memory_order_relaxed);
+    if (feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT) {
+        m_cache_hits.fetch_add(1, std::memory_order_relaxed);
+        m_hit_ns.fetch_add(feedback.duration, std::memory_order_relaxed);
+    } else {
+        m_compile_ns.fetch_add(feedback.duration, std::memory_order_relaxed);
+    }
+}
+
+void PipelineCacheStore::log_stats(const char* when) {
+    uint64_t pipelines = m_pipelines.load(std::memory_order_relaxed);
+    uint64_t hits = m_cache_hits.load(std::memory_order_relaxed);
+    ALOGI("pipeline cache (%s): %" PRIu64 " pipelines, %" PRIu64 " cache hits (%.1f ms), "
+          "%" PRIu64 " compiled (%.1f ms), %" PRIu64 " without feedback (%.1f ms)",
+          when, pipelines, hits, ns_to_ms(m_hit_ns.load(std::memory_order_relaxed)),
+          pipelines - hits, ns_to_ms(m_compile_ns.load(std::memory_order_relaxed)),
+          m_untracked_pipelines.load(std::memory_order_relaxed),
+          ns_to_ms(m_untracked_ns.load(std::memory_order_relaxed)));
+}
+
+std::vector<uint8_t> PipelineCacheStore::read_file(const VkPhysicalDeviceProperties& properties) {
+    std::vector<uint8_t> data;
+    FILE* file = fopen(m_path.c_str(), "rb");
+    if (!file) return data;
+
+    PipelineCacheFileHeader header;
+    bool valid = fread(&header, sizeof(header), 1, file) == 1 && matches_device(header, properties);
+    if (valid) {
+        fseek(file, 0, SEEK_END);
+        long file_size = ftell(file);
+        valid = file_size >= 0 && (uint64_t)file_size == sizeof(header) + header.data_size;
+    }
+    if (valid) {
+        data.resize(header.data_size);
+        fseek(file, sizeof(header), SEEK_SET);
+        valid = fread(data.data(), 1, data.size(), file) == data.size() &&
+                fnv1a_64(data.data(), data.size()) == header.data_hash &&
+                matches_device(data, properties);
+    }
+    fclose(file);
+
+    if (!valid) {
+        // 드라이버 업데이트나 깨진 파일. 다음 저장 때 새로 씁니다.
+        ALOGW("pipeline cache: discarding stale or corrupt %s", m_path.c_str());
+        unlink(m_path.c_str());
+        data.clear();
+    }
+    return data;
+}
+
+uint64_t PipelineCacheStore::save() {
+    std::vector<uint8_t> data;
+    {
+        // 생성용 캐시와 앱 캐시에서 새로 만들어진 파이프라인을 저장용 캐시로 모읍니다.
+        // src 캐시는 외부 동기화 대상이 아니므로 파이프라인 생성과 동시에 읽어도 됩니다.
+        std::lock_guard<std::mutex> app_lock(m_app_caches_mutex);
+        std::lock_guard<std::mutex> lock(m_store_mutex);
+        std::vector<VkPipelineCache> sources(1, m_cache);
+        sources.insert(sources.end(), m_app_caches.begin(), m_app_caches.end());
+        m_dispatch->MergePipelineCaches(m_device, m_store_cache, (uint32_t)sources.size(), sources.data());
+
+        size_t size = 0;
+        if (m_dispatch->GetPipelineCacheData(m_device, m_store_cache, &size, nullptr) != VK_SUCCESS) return 0;
+        data.resize(size);
+        VkResult result = m_dispatch->GetPipelineCacheData(m_device, m_store_cache, &size, data.data());
+        if (result != VK_SUCCESS && result != VK_INCOMPLETE) return 0;
+        data.resize(size);
+    }
+
+    uint64_t hash = fnv1a_64(data.data(), data.size());
+    if (data.size() == m_saved_size && hash == m_saved_hash) return 0;
+
+    PipelineCacheFileHeader header = {};
+    header.magic = kFileMagic;
+    header.version = kFileVersion;
+    header.vendor_id = m_properties.vendorID;
+    header.device_id = m_properties.deviceID;
+    header.driver_version = m_properties.driverVersion;
+    memcpy(header.pipeline_cache_uuid, m_properties.pipelineCacheUUID, VK_UUID_SIZE);
+    header.data_size = data.size();
+    header.data_hash = hash;
+
+    std::vector<uint8_t> contents(sizeof(header) + data.size());
+    memcpy(contents.data(), &header, sizeof(header));
+    memcpy(contents.data() + sizeof(header), data.data(), data.size());
+
+    m_saved_size = data.size();
+    m_saved_hash = hash;
+    return cache_file_writer().submit(m_path, std::move(contents));
+}
+
+void PipelineCacheStore::snapshot_loop() {
+    std::unique_lock<std::mutex> lock(m_snapshot_mutex);
+    for (;;) {
+        if (m_save_interval_ms == 0) {
+            m_snapshot_cv.wait(lock, [this] { return m_stop; });
+        } else {
+            m_snapshot_cv.wait_for(lock, std::chrono::milliseconds(m_save_interval_ms), [this] { return m_stop; });
+        }
+        // 마지막 저장은 소멸자가 합니다.
+        if (m_stop) break;
+
+        lock.unlock();
+        save();
+        lock.lock();
+    }
+}
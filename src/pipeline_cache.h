@@ -0,0 +1,142 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "clock.h"
+#include "dispatch_table.h"
+
+// 레이어가 소유하는 디바이스별 VkPipelineCache 와 디스크 저장.
+//
+// - vkCreateDevice 에서 <캐시 디렉터리>/pipeline_cache_<패키지>_<UUID>_<드라이버 버전>.bin 을 읽어
+//   캐시를 만듭니다. 파일 헤더 (매직, 버전, vendor/device ID, 드라이버 버전, UUID, 크기, 해시) 와
+//   Vulkan 캐시 헤더가 현재 디바이스와 맞지 않으면 파일을 버립니다.
+// - 앱이 VK_NULL_HANDLE 로 파이프라인을 만들면 레이어 캐시를 대신 넘깁니다.
+//   앱이 만든 캐시는 생성 직후 레이어 캐시를 merge 해 주고, 파괴 (와 주기적 저장) 시 레이어 캐시로
+//   다시 merge 합니다.
+// - merge 대상 (dstCache 는 외부 동기화 대상) 은 파이프라인 생성에 넘기는 캐시와 따로 둡니다.
+//   생성 경로는 lock 을 잡지 않으므로 merge / 저장이 긴 컴파일을 기다리거나 막지 않습니다.
+// - 저장은 snapshot 스레드가 주기적으로, 그리고 vkDestroyDevice 에서 마지막으로 합니다. 파일 쓰기와
+//   fsync 는 프로세스 전역 writer 스레드가 하고, vkDestroyDevice 는 마지막 저장을 최대 100 ms 만
+//   기다립니다. (넘으면 writer 가 이어서 씁니다)
+//   임시 파일에 쓴 뒤 rename 하므로 중간에 죽어도 이전 파일이 남습니다.
+// - VK_EXT_pipeline_creation_feedback (Vulkan 1.3 core) 을 쓸 수 있으면 파이프라인마다 캐시 hit
+//   여부와 생성 시간을 집계합니다.
+//
+// 설정:
+//   debug.my_layer.pipeline_cache                  0 이면 끔 (기본 1)
+//   debug.my_layer.pipeline_cache_dir              저장 디렉터리 (기본 platform_get_cache_dir())
+//   debug.my_layer.pipeline_cache_save_interval_s  주기적 저장 간격 (기본 30, 0 이면 종료 시에만)
+
+class PipelineCacheStore {
+public:
+    // 설정이 꺼져 있거나 캐시를 만들 수 없으면 nullptr.
+    static std::unique_ptr<PipelineCacheStore> create(
+        VkDevice device,
+        const DeviceDispatchTable* dispatch,
+        const VkPhysicalDeviceProperties& properties,
+        bool creation_feedback_supported);
+
+    // snapshot 스레드를 멈추고 마지막으로 저장한 뒤 캐시를 파괴합니다. 디바이스 파괴 전에 호출해야 합니다.
+    ~PipelineCacheStore();
+
+    PipelineCacheStore(const PipelineCacheStore&) = delete;
+    PipelineCacheStore& operator=(const PipelineCacheStore&) = delete;
+
+    // 앱이 만든 캐시에 레이어 캐시 내용을 넣어 주고, 이후 저장 시 merge 대상으로 등록합니다.
+    void on_app_cache_created(VkPipelineCache app_cache, const VkPipelineCacheCreateInfo* create_info);
+    // 앱 캐시를 레이어 캐시로 merge 하고 등록을 해제합니다.
+    void on_app_cache_destroyed(VkPipelineCache app_cache);
+
+    // pipelineCache 대체와 creation feedback 을 붙여서 create(cache, create_infos) 를 호출합니다.
+    template <typename CreateInfo, typename Create>
+    VkResult create_pipelines(VkPipelineCache app_cache, uint32_t count, const CreateInfo* create_infos,
+                              Create&& create);
+
+private:
+    PipelineCacheStore(VkDevice device, const DeviceDispatchTable* dispatch, std::string path,
+                       uint64_t save_interval_ms, bool creation_feedback_supported);
+
+    void snapshot_loop();
+    // 레이어 캐시 내용을 모아 writer 에 넘깁니다. 넘긴 것이 없으면 0, 있으면 writer 의 ticket.
+    uint64_t save();
+    std::vector<uint8_t> read_file(const VkPhysicalDeviceProperties& properties);
+    void record_feedback(const VkPipelineCreationFeedback& feedback);
+    void log_stats(const char* when);
+
+    VkDevice m_device;
+    const DeviceDispatchTable* m_dispatch;
+    VkPipelineCache m_cache = VK_NULL_HANDLE;        // 파이프라인 생성에 넘기는 캐시. lock 없이 씁니다.
+    VkPipelineCache m_store_cache = VK_NULL_HANDLE;  // merge 대상이자 저장할 캐시 (m_store_mutex)
+    VkPhysicalDeviceProperties m_properties = {};
+    std::string m_path;
+    uint64_t m_save_interval_ms;
+    bool m_creation_feedback_supported;
+
+    std::mutex m_store_mutex;
+
+    std::mutex m_app_caches_mutex;
+    std::vector<VkPipelineCache> m_app_caches;  // 주기적 저장 때 merge 할 앱 캐시
+
+    std::mutex m_snapshot_mutex;
+    std::condition_variable m_snapshot_cv;
+    bool m_stop = false;
+    std::thread m_snapshot_thread;
+    uint64_t m_saved_hash = 0;  // snapshot 스레드 / 소멸자에서만 사용 (writer 에 넘긴 마지막 내용)
+    size_t m_saved_size = 0;
+
+    std::atomic<uint64_t> m_pipelines{0};
+    std::atomic<uint64_t> m_cache_hits{0};
+    std::atomic<uint64_t> m_hit_ns{0};
+    std::atomic<uint64_t> m_compile_ns{0};
+    std::atomic<uint64_t> m_untracked_pipelines{0};  // feedback 없이 만든 파이프라인
+    std::atomic<uint64_t> m_untracked_ns{0};
+};
+
+template <typename CreateInfo, typename Create>
+VkResult PipelineCacheStore::create_pipelines(VkPipelineCache app_cache, uint32_t count,
+                                              const CreateInfo* create_infos, Create&& create)
+{
+    VkPipelineCache cache = app_cache != VK_NULL_HANDLE ? app_cache : m_cache;
+
+    if (!m_creation_feedback_supported) {
+        uint64_t begin_ns = monotonic_now_ns();
+        VkResult result = create(cache, create_infos);
+        m_untracked_pipelines.fetch_add(count, std::memory_order_relaxed);
+        m_untracked_ns.fetch_add(monotonic_now_ns() - begin_ns, std::memory_order_relaxed);
+        return result;
+    }
+
+    // 앱이 이미 feedback 구조체를 붙였으면 그것을 읽고, 아니면 복사본에 레이어 것을 붙입니다.
+    std::vector<CreateInfo> copies(create_infos, create_infos + count);
+    std::vector<VkPipelineCreationFeedback> feedbacks(count);
+    std::vector<VkPipelineCreationFeedbackCreateInfo> feedback_infos(count);
+    std::vector<const VkPipelineCreationFeedback*> results(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const VkBaseInStructure* next = static_cast<const VkBaseInStructure*>(create_infos[i].pNext);
+        while (next && next->sType != VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO) next = next->pNext;
+        if (next) {
+            results[i] = reinterpret_cast<const VkPipelineCreationFeedbackCreateInfo*>(next)->pPipelineCreationFeedback;
+            continue;
+        }
+        feedback_infos[i] = {VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO};
+        feedback_infos[i].pNext = create_infos[i].pNext;
+        feedback_infos[i].pPipelineCreationFeedback = &feedbacks[i];
+        copies[i].pNext = &feedback_infos[i];
+        results[i] = &feedbacks[i];
+    }
+
+    VkResult result = create(cache, copies.data());
+    if (result == VK_SUCCESS) {
+        for (uint32_t i = 0; i < count; ++i) record_feedback(*results[i]);
+    }
+    return result;
+}
@@ -0,0 +1,72 @@
+#include <vulkan/vulkan.h>
+
+#include "hooks.h"
+#include "layer_data.h"
+#include "pipeline_cache.h"
+#include "utils.h"
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkCreatePipelineCache(
+    VkDevice device,
+    const VkPipelineCacheCreateInfo* pCreateInfo,
+    const VkAllocationCallbacks* pAllocator,
+    VkPipelineCache* pPipelineCache)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    VkResult result = device_data->dispatch.CreatePipelineCache(device, pCreateInfo, pAllocator, pPipelineCache);
+    if (result == VK_SUCCESS && device_data->pipeline_cache) {
+        device_data->pipeline_cache->on_app_cache_created(*pPipelineCache, pCreateInfo);
+    }
+    return result;
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkDestroyPipelineCache(
+    VkDevice device,
+    VkPipelineCache pipelineCache,
+    const VkAllocationCallbacks* pAllocator)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    if (pipelineCache != VK_NULL_HANDLE && device_data->pipeline_cache) {
+        device_data->pipeline_cache->on_app_cache_destroyed(pipelineCache);
+    }
+    device_data->dispatch.DestroyPipelineCache(device, pipelineCache, pAllocator);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkCreateGraphicsPipelines(
+    VkDevice device,
+    VkPipelineCache pipelineCache,
+    uint32_t createInfoCount,
+    const VkGraphicsPipelineCreateInfo* pCreateInfos,
+    const VkAllocationCallbacks* pAllocator,
+    VkPipeline* pPipelines)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    if (!device_data->pipeline_cache) {
+        return device_data->dispatch.CreateGraphicsPipelines(device, pipelineCache, createInfoCount, pCreateInfos,
+                                                             pAllocator, pPipelines);
+    }
+    return device_data->pipeline_cache->create_pipelines(pipelineCache, createInfoCount, pCreateInfos,
+        [&](VkPipelineCache cache, const VkGraphicsPipelineCreateInfo* create_infos) {
+            return device_data->dispatch.CreateGraphicsPipelines(device, cache, createInfoCount, create_infos,
+                                                                 pAllocator, pPipelines);
+        });
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkCreateComputePipelines(
+    VkDevice device,
+    VkPipelineCache pipelineCache,
+    uint32_t createInfoCount,
+    const VkComputePipelineCreateInfo* pCreateInfos,
+    const VkAllocationCallbacks* pAllocator,
+    VkPipeline* pPipelines)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    if (!device_data->pipeline_cache) {
+        return device_data->dispatch.CreateComputePipelines(device, pipelineCache, createInfoCount, pCreateInfos,
+                                                            pAllocator, pPipelines);
+    }
+    return device_data->pipeline_cache->create_pipelines(pipelineCache, createInfoCount, pCreateInfos,
+        [&](VkPipelineCache cache, const VkComputePipelineCreateInfo* create_infos) {
+            return device_data->dispatch.CreateComputePipelines(device, cache, createInfoCount, create_infos,
+                                                                pAllocator, pPipelines);
+        });
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// 플랫폼 의존 기능 (로그 출력, 시스템 프로퍼티, 캐시 디렉터리) 의 얇은 추상화.
+// Android 는 platform_android.cpp (logcat, __system_property_get),
+// 호스트 Linux 는 platform_linux.cpp (stderr, 환경 변수) 로 구현합니다.
+
+enum class LogPriority {
+    Debug,
+    Info,
+    Warn,
+    Error,
+};
+
+// 이미 포맷팅된 메시지를 출력합니다. 로그 drain 스레드에서만 호출합니다. (log.h 참고)
+void platform_log_write(LogPriority priority, const char* tag, const char* message);
+
+// 프로퍼티가 없으면 빈 문자열을 돌려줍니다.
+// Linux 에서는 이름을 대문자로 바꾸고 '.' 을 '_' 로 바꾼 환경 변수를 읽습니다.
+// (ex. debug.my_layer_package -> DEBUG_MY_LAYER_PACKAGE)
+std::string platform_get_property(const char* name);
+
+// 프로퍼티가 바뀔 때마다 달라지는 값. 설정을 다시 읽어야 하는지 볼 때 씁니다. (settings.h 참고)
+// 알 수 없으면 0 을 돌려주고, 이 경우 호출하는 쪽은 항상 다시 읽습니다.
+// Linux 의 환경 변수는 프로세스 안에서 바뀌지 않으므로 항상 같은 값입니다.
+uint32_t platform_property_serial();
+
+// 레이어가 파일 (ex. 파이프라인 캐시) 을 저장할 디렉터리. 없으면 만들고, 실패하면 빈 문자열.
+// Android 는 앱의 캐시 디렉터리, Linux 는 $XDG_CACHE_HOME/my_layer (기본 ~/.cache/my_layer) 입니다.
+std::string platform_get_cache_dir(const std::string& package);
@@ -0,0 +1,40 @@
+#include "platform.h"
+
+#include <android/log.h>
+#include <sys/system_properties.h>
+
+static int to_android_priority(LogPriority priority) {
+    switch (priority) {
+        case LogPriority::Debug: return ANDROID_LOG_DEBUG;
+        case LogPriority::Info: return ANDROID_LOG_INFO;
+        case LogPriority::Warn: return ANDROID_LOG_WARN;
+        case LogPriority::Error: return ANDROID_LOG_ERROR;
+    }
+    return ANDROID_LOG_INFO;
+}
+
+void platform_log_write(LogPriority priority, const char* tag, const char* message) {
+    __android_log_write(to_android_priority(priority), tag, message);
+}
+
+std::string platform_get_property(const char* name) {
+    char value[PROP_VALUE_MAX] = {};
+    __system_property_get(name, value);
+    return value;
+}
+
+uint32_t platform_property_serial() {
+#if __ANDROID_API__ >= 26
+    return __system_property_area_serial();
+#else
+    return 0;
+#endif
+}
+
+std::string platform_get_cache_dir(const std::string& package) {
+    // 레이어는 앱 프로세스 안에서 돌기 때문에 앱의 캐시 디렉터리에 쓸 수 있습니다.
+    // ("com.example.app:remote" 처럼 프로세스 이름이 붙은 경우 패키지 이름만 씁니다.)
+    std::string name = package.substr(0, package.find(':'));
+    if (name.empty()) return "";
+    return "/data/data/" + name + "/cache";
+}
@@ -0,0 +1,51 @@
+#include "platform.h"
+
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+#include <sys/stat.h>
+
+static const char* to_priority_name(LogPriority priority) {
+    switch (priority) {
+        case LogPriority::Debug: return "D";
+        case LogPriority::Info: return "I";
+        case LogPriority::Warn: return "W";
+        case LogPriority::Error: return "E";
+    }
+    return "I";
+}
+
+void platform_log_write(LogPriority priority, const char* tag, const char* message) {
+    fprintf(stderr, "%s/%s: %s\n", to_priority_name(priority), tag, message);
+}
+
+std::string platform_get_property(const char* name) {
+    std::string env_name(name);
+    for (char& c : env_name) {
+        c = (c == '.') ? '_' : (char)toupper((unsigned char)c);
+    }
+    const char* value = getenv(env_name.c_str());
+    return value ? value : "";
+}
+
+uint32_t platform_property_serial() {
+    return 1;
+}
+
+std::string platform_get_cache_dir(const std::string&) {
+    std::string base;
+    if (const char* xdg = getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+        base = xdg;
+    } else if (const char* home = getenv("HOME"); home && *home) {
+        base = std::string(home) + "/.cache";
+    } else {
+        base = "/tmp";
+    }
+    mkdir(base.c_str(), 0755);
+
+    std::string dir = base + "/my_layer";
+    if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) return "";
+    return dir;
+}
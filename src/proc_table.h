@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "dispatch_table.h"
+#include "perfect_hash.h"
+
+// vkGetInstanceProcAddr / vkGetDeviceProcAddr 가 해석하는 모든 명령의 정적 테이블.
+// 이름 -> 인덱스는 컴파일 타임 perfect hash 로 O(1) 에 찾고,
+// pass-through 명령은 dispatch_offset 으로 디스패치 테이블의 포인터를 바로 읽습니다.
+
+enum class ProcLevel : uint8_t {
+    Global,    // instance 없이 호출 가능 (vkCreateInstance, vkEnumerateInstance*)
+    Instance,  // dispatch_offset 은 InstanceDispatchTable 기준
+    Device,    // dispatch_offset 은 DeviceDispatchTable 기준
+};
+
+struct ProcInfo {
+    std::string_view name;
+    ProcLevel level;
+    uint16_t dispatch_offset;
+};
+
+inline constexpr ProcInfo kProcInfos[] = {
+    {"vkCreateInstance", ProcLevel::Global, 0},
+    {"vkEnumerateInstanceVersion", ProcLevel::Global, 0},
+    {"vkEnumerateInstanceExtensionProperties", ProcLevel::Global, 0},
+    {"vkEnumerateInstanceLayerProperties", ProcLevel::Global, 0},
+    {"vkGetInstanceProcAddr", ProcLevel::Instance, offsetof(InstanceDispatchTable, GetInstanceProcAddr)},
+    {"vkGetDeviceProcAddr", ProcLevel::Device, offsetof(DeviceDispatchTable, GetDeviceProcAddr)},
+#define MY_LAYER_PROC_INFO(name) {"vk" #name, ProcLevel::Instance, offsetof(InstanceDispatchTable, name)},
+    MY_LAYER_INSTANCE_COMMANDS(MY_LAYER_PROC_INFO)
+#undef MY_LAYER_PROC_INFO
+#define MY_LAYER_PROC_INFO(name) {"vk" #name, ProcLevel::Device, offsetof(DeviceDispatchTable, name)},
+    MY_LAYER_DEVICE_COMMANDS(MY_LAYER_PROC_INFO)
+#undef MY_LAYER_PROC_INFO
+};
+
+inline constexpr size_t kProcCount = sizeof(kProcInfos) / sizeof(kProcInfos[0]);
+
+inline constexpr PerfectHashTable<kProcCount> kProcHashTable = [] {
+    std::array<std::string_view, kProcCount> names{};
+    for (size_t i = 0; i < kProcCount; ++i) names[i] = kProcInfos[i].name;
+    return PerfectHashTable<kProcCount>(names);
+}();
+
+// 이름에 해당하는 kProcInfos 인덱스. 레이어가 모르는 명령이면 -1.
+constexpr int find_proc_index(std::string_view name) {
+    return kProcHashTable.find(name);
+}
+
+inline int find_proc_index(const char* name) {
+    return kProcHashTable.find(name);
+}
+
+template <typename Table>
+inline PFN_vkVoidFunction read_dispatch_slot(const Table& table, uint16_t dispatch_offset) {
+    return *reinterpret_cast<const PFN_vkVoidFunction*>(
+        reinterpret_cast<const char*>(&table) + dispatch_offset);
+}
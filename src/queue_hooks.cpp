@@ -0,0 +1,153 @@
+#include <vulkan/vulkan.h>
+
+#include <memory>
+
+#include "clock.h"
+#include "hooks.h"
+#include "layer_data.h"
+#include "utils.h"
+
+LayerQueueData* register_queue(LayerDeviceData* device_data, VkQueue queue,
+                               uint32_t family_index, uint32_t queue_index)
+{
+    std::lock_guard<std::mutex> lock(device_data->queue_mutex);
+
+    // 같은 큐를 여러 번 얻는 경우 (다른 스레드가 먼저 등록한 경우 포함)
+    LayerQueueData* existing = g_queue_data_map.find(queue);
+    if (existing) return existing;
+
+    uint32_t count = device_data->queue_count.load(std::memory_order_relaxed);
+    if (count >= LayerDeviceData::kMaxQueues) {
+        ALOGE("register_queue: too many queues on device %p", (void*)device_data->device);
+        return nullptr;
+    }
+
+    auto queue_data = std::make_unique<LayerQueueData>();
+    queue_data->queue = queue;
+    queue_data->device_data = device_data;
+    queue_data->family_index = family_index;
+    queue_data->queue_index = queue_index;
+
+    LayerQueueData* raw = queue_data.get();
+    g_queue_data_map.insert(queue, std::move(queue_data));
+    device_data->queues[count] = raw;
+    device_data->queue_count.store(count + 1, std::memory_order_release);
+    return raw;
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkGetDeviceQueue(
+    VkDevice device,
+    uint32_t queueFamilyIndex,
+    uint32_t queueIndex,
+    VkQueue* pQueue)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    device_data->dispatch.GetDeviceQueue(device, queueFamilyIndex, queueIndex, pQueue);
+    if (*pQueue != VK_NULL_HANDLE) register_queue(device_data, *pQueue, queueFamilyIndex, queueIndex);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkGetDeviceQueue2(
+    VkDevice device,
+    const VkDeviceQueueInfo2* pQueueInfo,
+    VkQueue* pQueue)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    device_data->dispatch.GetDeviceQueue2(device, pQueueInfo, pQueue);
+    if (*pQueue != VK_NULL_HANDLE) {
+        register_queue(device_data, *pQueue, pQueueInfo->queueFamilyIndex, pQueueInfo->queueIndex);
+    }
+}
+
+// vkQueueSubmit2 와 vkQueueSubmit2KHR 는 다음 체인의 포인터만 다릅니다.
+static VkResult queue_submit2(
+    PFN_vkQueueSubmit2 next_pfnQueueSubmit2,
+    LayerQueueData* queue_data,
+    uint32_t submitCount,
+    const VkSubmitInfo2* pSubmits,
+    VkFence fence)
+{
+    LayerDeviceData* device_data = queue_data->device_data;
+    if (device_data->command_stats_enabled) command_stats_on_submit2(queue_data, submitCount, pSubmits);
+
+    if (!device_data->profile.config.enabled) {
+        return next_pfnQueueSubmit2(queue_data->queue, submitCount, pSubmits, fence);
+    }
+
+    uint64_t begin_ns = monotonic_now_ns();
+    VkResult result = next_pfnQueueSubmit2(queue_data->queue, submitCount, pSubmits, fence);
+    frame_profiler_on_submit(queue_data, monotonic_now_ns() - begin_ns);
+    return result;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit(
+    VkQueue queue,
+    uint32_t submitCount,
+    const VkSubmitInfo* pSubmits,
+    VkFence fence)
+{
+    LayerQueueData* queue_data = get_queue_data(queue);
+    if (!queue_data) return get_device_data(queue)->dispatch.QueueSubmit(queue, submitCount, pSubmits, fence);
+
+    LayerDeviceData* device_data = queue_data->device_data;
+    if (device_data->command_stats_enabled) command_stats_on_submit(queue_data, submitCount, pSubmits);
+
+    const DeviceDispatchTable& dispatch = device_data->dispatch;
+    if (!device_data->profile.config.enabled) {
+        return dispatch.QueueSubmit(queue, submitCount, pSubmits, fence);
+    }
+
+    uint64_t begin_ns = monotonic_now_ns();
+    VkResult result = dispatch.QueueSubmit(queue, submitCount, pSubmits, fence);
+    frame_profiler_on_submit(queue_data, monotonic_now_ns() - begin_ns);
+    return result;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit2(
+    VkQueue queue,
+    uint32_t submitCount,
+    const VkSubmitInfo2* pSubmits,
+    VkFence fence)
+{
+    LayerQueueData* queue_data = get_queue_data(queue);
+    if (!queue_data) return get_device_data(queue)->dispatch.QueueSubmit2(queue, submitCount, pSubmits, fence);
+    return queue_submit2(queue_data->device_data->dispatch.QueueSubmit2, queue_data, submitCount, pSubmits, fence);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit2KHR(
+    VkQueue queue,
+    uint32_t submitCount,
+    const VkSubmitInfo2* pSubmits,
+    VkFence fence)
+{
+    LayerQueueData* queue_data = get_queue_data(queue);
+    if (!queue_data) return get_device_data(queue)->dispatch.QueueSubmit2KHR(queue, submitCount, pSubmits, fence);
+    return queue_submit2(queue_data->device_data->dispatch.QueueSubmit2KHR, queue_data, submitCount, pSubmits, fence);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueuePresentKHR(
+    VkQueue queue,
+    const VkPresentInfoKHR* pPresentInfo)
+{
+    LayerQueueData* queue_data = get_queue_data(queue);
+    if (!queue_data) return get_device_data(queue)->dispatch.QueuePresentKHR(queue, pPresentInfo);
+
+    // 프레임 경계에서 설정이 바뀌었는지 확인합니다. 페이싱 설정은 바로 다음 present 부터 적용됩니다.
+    layer_settings_poll();
+    const LayerSettings& settings = layer_settings();
+    LayerDeviceData* device_data = queue_data->device_data;
+    bool profile = device_data->profile.config.enabled;
+    bool pacing = frame_pacer_enabled(settings);
+    if (!profile && !pacing) return device_data->dispatch.QueuePresentKHR(queue, pPresentInfo);
+
+    // 페이싱 대기는 present CPU 시간에 넣지 않습니다. (모드 0 의 대기는 프레임 간격에는 반영됨)
+    FramePacerConfig pacer_config;
+    if (pacing) {
+        pacer_config = frame_pacer_config(settings, device_data->display_timing);
+        frame_pacer_before_present(queue_data, pacer_config, pPresentInfo);
+    }
+    uint64_t begin_ns = monotonic_now_ns();
+    VkResult result = device_data->dispatch.QueuePresentKHR(queue, pPresentInfo);
+    if (profile) frame_profiler_on_present(queue_data, begin_ns, monotonic_now_ns());
+    if (pacing) frame_pacer_after_present(queue_data, pacer_config);
+    return result;
+}
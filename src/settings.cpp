@@ -0,0 +1,296 @@
+#include "settings.h"
+
+#include "log.h"
+#include "platform.h"
+#include "utils.h"
+
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <sys/stat.h>
+
+std::atomic<const LayerSettings*> g_layer_settings{nullptr};
+std::atomic<const LayerSettings*> g_layer_settings_pending{nullptr};
+
+namespace {
+
+constexpr const char* kPropertyPrefix = "debug.my_layer.";
+
+// 설정 파일 내용 (key -> value). 패키지별 키 ("pace_fps.com.example.app") 도 그대로 들어 있습니다.
+using ConfigFileValues = std::map<std::string, std::string>;
+
+struct SettingsSource {
+    std::string package;
+    ConfigFileValues file_values;
+};
+
+std::string trim(const std::string& value) {
+    size_t begin = value.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    size_t end = value.find_last_not_of(" \t\r");
+    return value.substr(begin, end - begin + 1);
+}
+
+ConfigFileValues read_config_file(const std::string& path) {
+    ConfigFileValues values;
+    if (path.empty()) return values;
+
+    std::ifstream file(path);
+    if (!file) {
+        ALOGW("settings: can't open config file %s", path.c_str());
+        return values;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        size_t equal = line.find('=');
+        if (equal == std::string::npos) continue;
+        std::string key = trim(line.substr(0, equal));
+        if (!key.empty()) values[key] = trim(line.substr(equal + 1));
+    }
+    return values;
+}
+
+// 값을 찾는 순서는 settings.h 참고. 없으면 false.
+bool find_value(const SettingsSource& source, const char* key, std::string* value) {
+    if (!source.package.empty()) {
+        std::string package_key = std::string(key) + "." + source.package;
+        *value = platform_get_property((kPropertyPrefix + package_key).c_str());
+        if (!value->empty()) return true;
+        *value = platform_get_property((std::string(kPropertyPrefix) + key).c_str());
+        if (!value->empty()) return true;
+        auto it = source.file_values.find(package_key);
+        if (it != source.file_values.end()) {
+            *value = it->second;
+            return true;
+        }
+    } else {
+        *value = platform_get_property((std::string(kPropertyPrefix) + key).c_str());
+        if (!value->empty()) return true;
+    }
+    auto it = source.file_values.find(key);
+    if (it == source.file_values.end()) return false;
+    *value = it->second;
+    return true;
+}
+
+void read_setting(const SettingsSource& source, const char* key, bool* out) {
+    std::string value;
+    if (!find_value(source, key, &value)) return;
+    if (value == "true" || value == "on" || value == "yes") {
+        *out = true;
+    } else if (value == "false" || value == "off" || value == "no") {
+        *out = false;
+    } else {
+        *out = strtoull(value.c_str(), nullptr, 10) != 0;
+    }
+}
+
+void read_setting(const SettingsSource& source, const char* key, uint64_t* out) {
+    std::string value;
+    if (find_value(source, key, &value)) *out = strtoull(value.c_str(), nullptr, 10);
+}
+
+void read_setting(const SettingsSource& source, const char* key, std::string* out) {
+    std::string value;
+    if (find_value(source, key, &value)) *out = value;
+}
+
+// debug.my_layer_package: 비어 있으면 대상 없음 (처음부터 그랬듯이), "*" 이면 모든 프로세스,
+// 아니면 쉼표로 구분한 목록.
+bool is_targeted(const std::string& package) {
+    std::string targets = platform_get_property("debug.my_layer_package");
+    if (targets.empty()) return false;
+    if (trim(targets) == "*") return true;
+
+    std::string base_name = package.substr(0, package.find(':'));
+    std::string file_name = base_name.substr(base_name.rfind('/') + 1);
+    size_t begin = 0;
+    while (begin <= targets.size()) {
+        size_t end = targets.find(',', begin);
+        if (end == std::string::npos) end = targets.size();
+        std::string target = trim(targets.substr(begin, end - begin));
+        if (!target.empty() && (target == package || target == base_name || target == file_name)) return true;
+        begin = end + 1;
+    }
+    return false;
+}
+
+std::string config_file_path() {
+    return platform_get_property((std::string(kPropertyPrefix) + "config_file").c_str());
+}
+
+// 설정 파일이 바뀌었는지 보기 위한 값. 파일이 없으면 0.
+uint64_t config_file_stamp(const std::string& path) {
+    struct stat st;
+    if (path.empty() || stat(path.c_str(), &st) != 0) return 0;
+    return (uint64_t)st.st_mtim.tv_sec * 1000000000ull + (uint64_t)st.st_mtim.tv_nsec + (uint64_t)st.st_size;
+}
+
+LayerSettings read_settings(const SettingsSource& source) {
+    LayerSettings settings;
+#define MY_LAYER_READ_SETTING(name, ...) read_setting(source, #name, &settings.name);
+    MY_LAYER_BOOL_SETTINGS(MY_LAYER_READ_SETTING)
+    MY_LAYER_UINT_SETTINGS(MY_LAYER_READ_SETTING)
+    MY_LAYER_STRING_SETTINGS(MY_LAYER_READ_SETTING)
+#undef MY_LAYER_READ_SETTING
+    return settings;
+}
+
+std::string to_string(bool value) { return value ? "1" : "0"; }
+std::string to_string(uint64_t value) { return std::to_string(value); }
+const std::string& to_string(const std::string& value) { return value; }
+
+// 바뀐 값이 언제 반영되는지. (settings.h 의 MY_LAYER_LIVE_SETTINGS / MY_LAYER_PROCESS_SETTINGS)
+const char* applies_from(const char* name) {
+#define MY_LAYER_MATCH_SETTING(setting) if (strcmp(name, #setting) == 0) return "next frame";
+    MY_LAYER_LIVE_SETTINGS(MY_LAYER_MATCH_SETTING)
+#undef MY_LAYER_MATCH_SETTING
+#define MY_LAYER_MATCH_SETTING(setting) if (strcmp(name, #setting) == 0) return "app restart";
+    MY_LAYER_PROCESS_SETTINGS(MY_LAYER_MATCH_SETTING)
+#undef MY_LAYER_MATCH_SETTING
+    return "next vkCreateDevice";
+}
+
+// previous 와 다른 값을 로그로 남기고, 하나라도 다르면 true. 처음 읽을 때가 아니면 언제 반영되는지도 남깁니다.
+bool log_changes(const LayerSettings& previous, const LayerSettings& current, bool initial) {
+    bool changed = false;
+#define MY_LAYER_LOG_SETTING(name, ...) \
+    if (current.name != previous.name) { \
+        if (initial) { \
+            ALOGI("settings: set %s = %s", #name, to_string(current.name).c_str()); \
+        } else { \
+            ALOGI("settings: changed %s = %s (applies from the %s)", #name, to_string(current.name).c_str(), \
+                  applies_from(#name)); \
+        } \
+        changed = true; \
+    }
+    MY_LAYER_BOOL_SETTINGS(MY_LAYER_LOG_SETTING)
+    MY_LAYER_UINT_SETTINGS(MY_LAYER_LOG_SETTING)
+    MY_LAYER_STRING_SETTINGS(MY_LAYER_LOG_SETTING)
+#undef MY_LAYER_LOG_SETTING
+    return changed;
+}
+
+class SettingsStore {
+public:
+    const LayerSettings& load() {
+        std::call_once(m_once, [this] {
+            m_package = get_app_package_name();
+            m_targeted = is_targeted(m_package);
+            m_config_path = config_file_path();
+            m_config_stamp = config_file_stamp(m_config_path);
+            m_property_serial = platform_property_serial();
+
+            LayerSettings* settings = new LayerSettings(read_settings({m_package, read_config_file(m_config_path)}));
+            settings->targeted = m_targeted;
+            if (m_targeted) {
+                log_changes(LayerSettings{}, *settings, true);
+            } else {
+                ALOGI("settings: %s is not a target process, passing through", m_package.c_str());
+            }
+            m_latest = settings;
+            g_layer_settings.store(settings, std::memory_order_release);
+        });
+        return *g_layer_settings.load(std::memory_order_acquire);
+    }
+
+    // 감시 스레드에서 부릅니다. 바뀐 것이 있으면 새 스냅샷을 대기시킵니다. 다음 주기까지 기다릴 ms 를 돌려주고,
+    // 0 이면 감시를 멈춥니다.
+    uint64_t reload() {
+        const LayerSettings& current = *m_latest;
+        if (!current.targeted || current.settings_watch_ms == 0) return 0;
+
+        // 프로퍼티 영역의 serial 은 어떤 프로퍼티가 바뀌어도 올라가므로 여기서는 다시 읽을지만 정합니다.
+        std::string config_path = config_file_path();
+        uint64_t config_stamp = config_file_stamp(config_path);
+        uint32_t property_serial = platform_property_serial();
+        if (property_serial != 0 && property_serial == m_property_serial &&
+            config_path == m_config_path && config_stamp == m_config_stamp) {
+            return current.settings_watch_ms;
+        }
+        m_property_serial = property_serial;
+        m_config_path = config_path;
+        m_config_stamp = config_stamp;
+
+        LayerSettings settings = read_settings({m_package, read_config_file(config_path)});
+        settings.targeted = true;
+        if (!log_changes(current, settings, false)) return current.settings_watch_ms;
+
+        settings.generation = current.generation + 1;
+        // 이전 스냅샷은 다른 스레드가 읽고 있을 수 있으므로 해제하지 않습니다. (설정 변경은 드뭅니다)
+        // 아직 공개되지 않은 이전 대기 스냅샷은 아무도 보지 않았으므로 해제합니다.
+        m_latest = new LayerSettings(std::move(settings));
+        delete g_layer_settings_pending.exchange(m_latest, std::memory_order_acq_rel);
+        return m_latest->settings_watch_ms;
+    }
+
+    bool watching() const { return m_targeted && m_latest->settings_watch_ms != 0; }
+
+private:
+    std::once_flag m_once;
+    std::string m_package;
+    bool m_targeted = true;
+    // 아래는 load() 이후 감시 스레드만 씁니다.
+    const LayerSettings* m_latest = nullptr;  // 가장 최근에 읽은 스냅샷 (공개 대기 중일 수 있음)
+    std::string m_config_path;
+    uint64_t m_config_stamp = 0;
+    uint32_t m_property_serial = 0;
+};
+
+SettingsStore& settings_store() {
+    static SettingsStore* store = new SettingsStore();
+    return *store;
+}
+
+// settings_watch_ms 마다 SettingsStore::reload() 를 부르는 스레드. 라이브러리가 내려갈 때 멈춥니다.
+class SettingsWatcher {
+public:
+    SettingsWatcher() : m_thread(&SettingsWatcher::watch_loop, this) {}
+
+    ~SettingsWatcher() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wakeup.notify_all();
+        m_thread.join();
+    }
+
+private:
+    void watch_loop() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        uint64_t wait_ms = settings_store().load().settings_watch_ms;
+        while (wait_ms != 0) {
+            if (m_wakeup.wait_for(lock, std::chrono::milliseconds(wait_ms), [this] { return m_stopping; })) break;
+            lock.unlock();
+            wait_ms = settings_store().reload();
+            lock.lock();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    bool m_stopping = false;
+    std::thread m_thread;  // 마지막에 초기화합니다.
+};
+
+}  // namespace
+
+const LayerSettings& layer_settings_load() {
+    const LayerSettings& settings = settings_store().load();
+    if (settings_store().watching()) {
+        static SettingsWatcher watcher;
+    }
+    return settings;
+}
+
+void layer_settings_publish_pending() {
+    const LayerSettings* pending = g_layer_settings_pending.exchange(nullptr, std::memory_order_acq_rel);
+    if (pending) g_layer_settings.store(pending, std::memory_order_release);
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// 레이어 설정.
+//
+// 모든 설정을 타입이 있는 LayerSettings 하나로 모아서 처음 쓸 때 한 번 읽고, 바뀌지 않는 스냅샷을
+// atomic 포인터로 공개합니다. hot path 는 layer_settings() 의 load 한 번으로 값을 읽습니다.
+// 스냅샷은 프로세스가 끝날 때까지 해제하지 않으므로 받은 참조를 계속 써도 됩니다.
+//
+// 값을 찾는 순서 (앞이 우선):
+//   1. debug.my_layer.<key>.<패키지>   패키지별 프로퍼티 (Linux: DEBUG_MY_LAYER_<KEY>_<패키지> 환경 변수)
+//   2. debug.my_layer.<key>            프로퍼티 (Linux: DEBUG_MY_LAYER_<KEY>)
+//   3. 설정 파일의 "<key>.<패키지> = 값", "<key> = 값" 줄
+//   4. 기본값
+// 설정 파일은 debug.my_layer.config_file 로 지정하고, 앱 프로세스가 읽을 수 있어야 합니다.
+// 한 줄에 하나씩 "key = value", '#' 뒤는 주석입니다.
+//
+// 변경 감시: 감시 스레드가 settings_watch_ms 마다 프로퍼티 영역의 serial 과 설정 파일 수정 시각을
+// 확인하고, 바뀌었으면 다시 읽어서 새 스냅샷을 대기시킵니다. (프로퍼티 serial 은 어떤 프로퍼티가
+// 바뀌어도 올라가므로 다시 읽는 일이 잦을 수 있어서 present 스레드에서 하지 않습니다)
+// 대기 중인 스냅샷은 프레임 경계 (vkQueuePresentKHR 의 layer_settings_poll()) 에서 공개합니다.
+// MY_LAYER_LIVE_SETTINGS 는 다음 프레임부터, MY_LAYER_PROCESS_SETTINGS 는 프로세스를 다시 시작해야,
+// 나머지는 다음 vkCreateDevice 부터 적용됩니다.
+//
+// 대상 프로세스: debug.my_layer_package 에 쉼표로 구분한 목록에 있는 프로세스 (전체 이름, ':' 앞의
+// 패키지 이름, 또는 실행 파일 이름) 만 대상이고, "*" 이면 모든 프로세스, 비어 있으면 대상이 없습니다.
+// 대상이 아니면 레이어는 생성 / 파괴만 처리하고 나머지 명령은 다음 체인의 포인터를 그대로 돌려줍니다
+// (pass-through).
+// 이 판단은 처음 읽을 때 한 번만 합니다.
+
+// X(name, default): debug.my_layer.<name>
+#define MY_LAYER_BOOL_SETTINGS(X) \
+    X(profile, true) \
+    X(cmd_stats, true) \
+    X(shader_dedup, true) \
+    X(pipeline_cache, true) \
+    X(state_filter, false) \
+    X(telemetry, false) \
+    X(trace, false)
+
+#define MY_LAYER_UINT_SETTINGS(X) \
+    X(profile_interval_ms, 5000) \
+    X(stutter_percent, 200) \
+    X(memory, 1) \
+    X(suballoc_max_kb, 256) \
+    X(suballoc_block_mb, 16) \
+    X(pipeline_cache_save_interval_s, 30) \
+    X(pace_fps, 0) \
+    X(pace_refresh_divisor, 0) \
+    X(refresh_hz, 60) \
+    X(pace_mode, 1) \
+    X(pace_spin_us, 500) \
+    X(trace_max_mb, 1024) \
+    X(settings_watch_ms, 1000)
+
+#define MY_LAYER_STRING_SETTINGS(X) \
+    X(pipeline_cache_dir) \
+    X(telemetry_dir) \
+    X(trace_dir) \
+    X(trace_frames)
+
+// 프레임마다 스냅샷에서 읽는 설정
+#define MY_LAYER_LIVE_SETTINGS(X) \
+    X(pace_fps) \
+    X(pace_refresh_divisor) \
+    X(refresh_hz) \
+    X(pace_mode) \
+    X(pace_spin_us) \
+    X(settings_watch_ms)
+
+// 처음 vkCreateDevice 에서 한 번만 읽는 설정
+#define MY_LAYER_PROCESS_SETTINGS(X) \
+    X(telemetry) \
+    X(telemetry_dir) \
+    X(trace) \
+    X(trace_dir) \
+    X(trace_frames) \
+    X(trace_max_mb)
+
+struct LayerSettings {
+#define MY_LAYER_SETTING_FIELD(name, default_value) decltype(default_value) name = default_value;
+    MY_LAYER_BOOL_SETTINGS(MY_LAYER_SETTING_FIELD)
+#undef MY_LAYER_SETTING_FIELD
+#define MY_LAYER_SETTING_FIELD(name, default_value) uint64_t name = default_value;
+    MY_LAYER_UINT_SETTINGS(MY_LAYER_SETTING_FIELD)
+#undef MY_LAYER_SETTING_FIELD
+#define MY_LAYER_SETTING_FIELD(name) std::string name;
+    MY_LAYER_STRING_SETTINGS(MY_LAYER_SETTING_FIELD)
+#undef MY_LAYER_SETTING_FIELD
+
+    bool targeted = true;     // 이 프로세스가 대상인지 (처음 읽을 때 정해짐)
+    uint64_t generation = 0;  // 스냅샷을 새로 공개할 때마다 1 씩 증가
+};
+
+extern std::atomic<const LayerSettings*> g_layer_settings;
+
+// 처음 호출될 때 읽습니다. (vkCreateInstance 등)
+const LayerSettings& layer_settings_load();
+
+inline const LayerSettings& layer_settings() {
+    const LayerSettings* settings = g_layer_settings.load(std::memory_order_acquire);
+    return settings ? *settings : layer_settings_load();
+}
+
+// 감시 스레드가 다시 읽어서 공개를 기다리는 스냅샷. 없으면 nullptr.
+extern std::atomic<const LayerSettings*> g_layer_settings_pending;
+
+void layer_settings_publish_pending();
+
+// 프레임 경계 (vkQueuePresentKHR) 에서 부릅니다. 바뀐 설정이 없으면 load 한 번으로 끝납니다.
+inline void layer_settings_poll() {
+    if (g_layer_settings_pending.load(std::memory_order_relaxed)) layer_settings_publish_pending();
+}
@@ -0,0 +1,31 @@
+#include <vulkan/vulkan.h>
+
+#include "hooks.h"
+#include "layer_data.h"
+#include "shader_module_cache.h"
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkCreateShaderModule(
+    VkDevice device,
+    const VkShaderModuleCreateInfo* pCreateInfo,
+    const VkAllocationCallbacks* pAllocator,
+    VkShaderModule* pShaderModule)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    if (!device_data->shader_modules) {
+        return device_data->dispatch.CreateShaderModule(device, pCreateInfo, pAllocator, pShaderModule);
+    }
+    return device_data->shader_modules->create_module(pCreateInfo, pAllocator, pShaderModule);
+}
+
+VKAPI_ATTR void VKAPI_CALL Hook_vkDestroyShaderModule(
+    VkDevice device,
+    VkShaderModule shaderModule,
+    const VkAllocationCallbacks* pAllocator)
+{
+    LayerDeviceData* device_data = get_device_data(device);
+    if (!device_data->shader_modules) {
+        device_data->dispatch.DestroyShaderModule(device, shaderModule, pAllocator);
+        return;
+    }
+    device_data->shader_modules->destroy_module(shaderModule, pAllocator);
+}
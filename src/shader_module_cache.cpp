@@ -0,0 +1,123 @@
+#include "shader_module_cache.h"
+
+#include <cinttypes>
+#include <cstring>
+
+#include "hash.h"
+#include "settings.h"
+#include "utils.h"
+
+std::unique_ptr<ShaderModuleCache> ShaderModuleCache::create(VkDevice device, const DeviceDispatchTable* dispatch,
+                                                             const VkDeviceCreateInfo* create_info) {
+    if (!layer_settings().shader_dedup) return nullptr;
+    if (!dispatch->CreateShaderModule || !dispatch->DestroyShaderModule) return nullptr;
+    if (private_data_enabled(create_info)) {
+        ALOGI("shader_dedup: disabled, privateData is enabled");
+        return nullptr;
+    }
+    return std::unique_ptr<ShaderModuleCache>(new ShaderModuleCache(device, dispatch));
+}
+
+ShaderModuleCache::ShaderModuleCache(VkDevice device, const DeviceDispatchTable* dispatch)
+    : m_device(device), m_dispatch(dispatch) {}
+
+ShaderModuleCache::~ShaderModuleCache() {
+    log_stats("device destroyed");
+    // 앱이 파괴하지 않은 모듈. 드라이버가 디바이스와 함께 정리하지만 명시적으로 돌려줍니다.
+    for (auto& [module, entry] : m_by_module) {
+        m_dispatch->DestroyShaderModule(m_device, module, nullptr);
+    }
+}
+
+ShaderModuleCache::Entry* ShaderModuleCache::find_locked(uint64_t hash, const uint32_t* code, size_t word_count) {
+    auto range = m_by_hash.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        Entry* entry = it->second;
+        if (entry->code.size() == word_count &&
+            memcmp(entry->code.data(), code, word_count * sizeof(uint32_t)) == 0) {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+VkResult ShaderModuleCache::create_module(const VkShaderModuleCreateInfo* create_info,
+                                          const VkAllocationCallbacks* allocator, VkShaderModule* module)
+{
+    m_create_calls.fetch_add(1, std::memory_order_relaxed);
+    m_bytes_seen.fetch_add(create_info->codeSize, std::memory_order_relaxed);
+
+    if (create_info->pNext || create_info->flags || allocator || !create_info->pCode) {
+        m_bypassed.fetch_add(1, std::memory_order_relaxed);
+        return m_dispatch->CreateShaderModule(m_device, create_info, allocator, module);
+    }
+
+    const uint32_t* code = create_info->pCode;
+    size_t word_count = create_info->codeSize / sizeof(uint32_t);
+    uint64_t hash = hash_words(code, word_count);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (Entry* entry = find_locked(hash, code, word_count)) {
+            ++entry->ref_count;
+            *module = entry->module;
+            m_driver_calls_avoided.fetch_add(1, std::memory_order_relaxed);
+            return VK_SUCCESS;
+        }
+    }
+
+    VkResult result = m_dispatch->CreateShaderModule(m_device, create_info, nullptr, module);
+    if (result != VK_SUCCESS) return result;
+
+    auto entry = std::make_unique<Entry>();
+    entry->module = *module;
+    entry->hash = hash;
+    entry->ref_count = 1;
+    entry->code.assign(code, code + word_count);
+
+    // 그 사이 다른 스레드가 같은 내용을 등록했어도 별도 항목으로 둡니다. (이후 조회는 둘 중 하나로 갑니다)
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_by_hash.emplace(hash, entry.get());
+    m_by_module[*module] = std::move(entry);
+    return VK_SUCCESS;
+}
+
+void ShaderModuleCache::destroy_module(VkShaderModule module, const VkAllocationCallbacks* allocator) {
+    if (module == VK_NULL_HANDLE) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_by_module.find(module);
+        if (it != m_by_module.end()) {
+            Entry* entry = it->second.get();
+            if (--entry->ref_count > 0) return;
+
+            auto range = m_by_hash.equal_range(entry->hash);
+            for (auto hash_it = range.first; hash_it != range.second; ++hash_it) {
+                if (hash_it->second == entry) {
+                    m_by_hash.erase(hash_it);
+                    break;
+                }
+            }
+            m_by_module.erase(it);
+        }
+    }
+    m_dispatch->DestroyShaderModule(m_device, module, allocator);
+}
+
+void ShaderModuleCache::log_stats(const char* when) {
+    size_t live_modules;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        live_modules = m_by_module.size();
+    }
+    uint64_t create_calls = m_create_calls.load(std::memory_order_relaxed);
+    uint64_t avoided = m_driver_calls_avoided.load(std::memory_order_relaxed);
+    ALOGI("shader_dedup (%s): %" PRIu64 " creates, %.1f KiB SPIR-V, %" PRIu64 " driver calls avoided (%.1f%%), "
+          "%" PRIu64 " bypassed, %zu shared modules alive",
+          when,
+          create_calls,
+          m_bytes_seen.load(std::memory_order_relaxed) / 1024.0,
+          avoided,
+          create_calls ? 100.0 * avoided / create_calls : 0.0,
+          m_bypassed.load(std::memory_order_relaxed),
+          live_modules);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "dispatch_table.h"
+
+// SPIR-V 내용 기준 VkShaderModule 중복 제거.
+//
+// - vkCreateShaderModule 의 SPIR-V 를 hash_words() 로 해시하고, 같은 해시의 모듈이 있으면 내용까지
+//   비교해서 같을 때 기존 핸들을 그대로 돌려줍니다. (드라이버 호출 없음)
+// - 핸들마다 참조 수를 두고, vkDestroyShaderModule 은 마지막 참조일 때만 드라이버로 넘깁니다.
+// - pNext / flags / pAllocator 가 있는 생성은 공유하면 의미가 달라질 수 있으므로 그대로 넘깁니다.
+// - 공유 범위는 디바이스 하나입니다. 디바이스를 다시 만들 때의 컴파일 비용은 파이프라인 캐시가 맡습니다.
+// - privateData 기능이 켜진 디바이스에서는 끕니다. 모듈마다 핸들이 달라야 vkSetPrivateData 가
+//   모듈별로 동작합니다.
+//
+// 설정:
+//   debug.my_layer.shader_dedup  0 이면 끔 (기본 1)
+
+class ShaderModuleCache {
+public:
+    // 설정이 꺼져 있거나 privateData 기능이 켜져 있으면 nullptr.
+    static std::unique_ptr<ShaderModuleCache> create(VkDevice device, const DeviceDispatchTable* dispatch,
+                                                     const VkDeviceCreateInfo* create_info);
+
+    // 남은 공유 모듈을 파괴하고 통계를 남깁니다. 디바이스 파괴 전에 호출해야 합니다.
+    ~ShaderModuleCache();
+
+    ShaderModuleCache(const ShaderModuleCache&) = delete;
+    ShaderModuleCache& operator=(const ShaderModuleCache&) = delete;
+
+    VkResult create_module(const VkShaderModuleCreateInfo* create_info, const VkAllocationCallbacks* allocator,
+                           VkShaderModule* module);
+    void destroy_module(VkShaderModule module, const VkAllocationCallbacks* allocator);
+
+private:
+    struct Entry {
+        VkShaderModule module;
+        uint64_t hash;
+        uint32_t ref_count;
+        std::vector<uint32_t> code;  // 해시 충돌 시 비교용
+    };
+
+    ShaderModuleCache(VkDevice device, const DeviceDispatchTable* dispatch);
+
+    Entry* find_locked(uint64_t hash, const uint32_t* code, size_t word_count);
+    void log_stats(const char* when);
+
+    VkDevice m_device;
+    const DeviceDispatchTable* m_dispatch;
+
+    // 모듈 생성/파괴는 hot path 가 아니므로 mutex 하나로 보호합니다. 드라이버 호출은 lock 밖에서 합니다.
+    std::mutex m_mutex;
+    std::unordered_multimap<uint64_t, Entry*> m_by_hash;
+    std::unordered_map<VkShaderModule, std::unique_ptr<Entry>> m_by_module;
+
+    std::atomic<uint64_t> m_bytes_seen{0};
+    std::atomic<uint64_t> m_create_calls{0};
+    std::atomic<uint64_t> m_driver_calls_avoided{0};
+    std::atomic<uint64_t> m_bypassed{0};  // 조건이 맞지 않아 그대로 넘긴 생성
+};
@@ -0,0 +1,223 @@
+#include "state_filter.h"
+
+#include <cinttypes>
+#include <cstring>
+
+#include "settings.h"
+#include "utils.h"
+
+StateFilterConfig load_state_filter_config(const VkDeviceCreateInfo* create_info, uint32_t api_version) {
+    StateFilterConfig config;
+    config.enabled = layer_settings().state_filter;
+    if (!config.enabled) return config;
+
+    // vkCmdBindIndexBuffer2 / vkCmdBindDescriptorSets2 는 1.4 core 입니다.
+    if (api_version >= VK_MAKE_API_VERSION(0, 1, 4, 0)) {
+        config.index_buffer = false;
+        config.descriptor_sets = false;
+    }
+    for (uint32_t i = 0; i < create_info->enabledExtensionCount; ++i) {
+        const char* name = create_info->ppEnabledExtensionNames[i];
+        if (strcmp(name, VK_EXT_SHADER_OBJECT_EXTENSION_NAME) == 0) {
+            // vkCmdBindShadersEXT 가 파이프라인과 동적 상태를 모두 바꿉니다.
+            ALOGI("state_filter: disabled, %s is enabled", name);
+            config.enabled = false;
+        } else if (strcmp(name, VK_KHR_MAINTENANCE_5_EXTENSION_NAME) == 0) {
+            config.index_buffer = false;
+        } else if (strcmp(name, VK_KHR_MAINTENANCE_6_EXTENSION_NAME) == 0 ||
+                   strcmp(name, VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME) == 0) {
+            config.descriptor_sets = false;
+        }
+    }
+    return config;
+}
+
+void log_state_filter_stats(const char* prefix, const StateFilterStats& stats) {
+    ALOGI("%s: dropped %" PRIu64 " calls (pipelines %" PRIu64 ", descriptor sets %" PRIu64 ", vertex buffers %" PRIu64
+          ", index buffers %" PRIu64 ", dynamic state %" PRIu64 ")",
+          prefix, stats.total(), stats.pipelines, stats.descriptor_sets, stats.vertex_buffers, stats.index_buffers,
+          stats.dynamic_state);
+}
+
+void StateShadow::begin(const StateFilterConfig& config) {
+    m_filter_descriptor_sets = config.descriptor_sets;
+    m_filter_index_buffer = config.index_buffer;
+    filtered = StateFilterStats();
+    reset();
+}
+
+void StateShadow::reset() {
+    m_pipelines[0] = m_pipelines[1] = VK_NULL_HANDLE;
+    m_descriptor_set_valid[0] = m_descriptor_set_valid[1] = 0;
+    m_vertex_buffer_valid = 0;
+    m_index_buffer = VK_NULL_HANDLE;
+    m_viewport_valid = 0;
+    m_scissor_valid = 0;
+    m_dynamic_valid = 0;
+}
+
+bool StateShadow::filter_bind_pipeline(VkPipelineBindPoint bind_point, VkPipeline pipeline) {
+    int index = bind_point_index(bind_point);
+    if (index < 0) return false;
+    if (m_pipelines[index] == pipeline && pipeline != VK_NULL_HANDLE) {
+        ++filtered.pipelines;
+        return true;
+    }
+    m_pipelines[index] = pipeline;
+    if (bind_point == VK_PIPELINE_BIND_POINT_GRAPHICS) {
+        // 새 파이프라인의 정적 상태가 이전에 설정한 동적 상태를 덮었을 수 있습니다.
+        m_viewport_valid = 0;
+        m_scissor_valid = 0;
+        m_dynamic_valid = 0;
+    }
+    return false;
+}
+
+// [first, first + count) 는 모르는 상태가 되고, 다른 layout 으로 묶인 나머지 셋은 호환되지 않으면
+// 드라이버가 disturb 하므로 함께 버립니다. (layout 핸들이 같을 때만 호환으로 봅니다)
+void StateShadow::invalidate_descriptor_sets(int bind_point, VkPipelineLayout layout, uint32_t first, uint32_t count) {
+    uint32_t& valid = m_descriptor_set_valid[bind_point];
+    for (uint32_t i = 0; i < kMaxDescriptorSets; ++i) {
+        if (!(valid & (1u << i))) continue;
+        if ((i >= first && i - first < count) || m_descriptor_sets[bind_point][i].layout != layout) {
+            valid &= ~(1u << i);
+        }
+    }
+}
+
+bool StateShadow::filter_bind_descriptor_sets(VkPipelineBindPoint bind_point, VkPipelineLayout layout,
+                                              uint32_t first_set, uint32_t set_count, const VkDescriptorSet* sets,
+                                              uint32_t dynamic_offset_count, const uint32_t* dynamic_offsets)
+{
+    int index = bind_point_index(bind_point);
+    if (index < 0 || !m_filter_descriptor_sets) return false;
+
+    // dynamic offset 이 어느 셋의 것인지는 layout 을 알아야 나눌 수 있으므로,
+    // offset 이 있으면 셋이 하나일 때만 추적합니다.
+    bool trackable = first_set + set_count <= kMaxDescriptorSets &&
+                     (dynamic_offset_count == 0 || (set_count == 1 && dynamic_offset_count <= kMaxDynamicOffsets));
+    if (!trackable) {
+        invalidate_descriptor_sets(index, layout, first_set, set_count);
+        return false;
+    }
+
+    uint32_t& valid = m_descriptor_set_valid[index];
+    BoundDescriptorSet* bound = m_descriptor_sets[index];
+    bool redundant = set_count > 0;
+    for (uint32_t i = 0; i < set_count && redundant; ++i) {
+        const BoundDescriptorSet& shadow = bound[first_set + i];
+        redundant = (valid & (1u << (first_set + i))) && shadow.layout == layout && shadow.set == sets[i] &&
+                    shadow.dynamic_offset_count == dynamic_offset_count &&
+                    (dynamic_offset_count == 0 ||
+                     memcmp(shadow.dynamic_offsets, dynamic_offsets, dynamic_offset_count * sizeof(uint32_t)) == 0);
+    }
+    if (redundant) {
+        ++filtered.descriptor_sets;
+        return true;
+    }
+
+    invalidate_descriptor_sets(index, layout, first_set, set_count);
+    for (uint32_t i = 0; i < set_count; ++i) {
+        BoundDescriptorSet& shadow = bound[first_set + i];
+        shadow.layout = layout;
+        shadow.set = sets[i];
+        shadow.dynamic_offset_count = dynamic_offset_count;
+        if (dynamic_offset_count) memcpy(shadow.dynamic_offsets, dynamic_offsets, dynamic_offset_count * sizeof(uint32_t));
+        valid |= 1u << (first_set + i);
+    }
+    return false;
+}
+
+void StateShadow::on_push_descriptor_set(VkPipelineBindPoint bind_point, VkPipelineLayout layout, uint32_t set) {
+    int index = bind_point_index(bind_point);
+    if (index >= 0) invalidate_descriptor_sets(index, layout, set, 1);
+}
+
+bool StateShadow::filter_bind_vertex_buffers(uint32_t first_binding, uint32_t binding_count, const VkBuffer* buffers,
+                                             const VkDeviceSize* offsets, const VkDeviceSize* sizes,
+                                             const VkDeviceSize* strides)
+{
+    if (first_binding + binding_count > kMaxVertexBuffers) return false;
+    uint32_t mask = (binding_count >= 32 ? ~0u : (1u << binding_count) - 1) << first_binding;
+
+    // stride 는 파이프라인 / vkCmdSetVertexInputEXT 와 얽힌 동적 상태라 추적하지 않습니다.
+    if (strides) {
+        m_vertex_buffer_valid &= ~mask;
+        return false;
+    }
+
+    bool redundant = binding_count > 0 && (m_vertex_buffer_valid & mask) == mask;
+    for (uint32_t i = 0; i < binding_count && redundant; ++i) {
+        const BoundVertexBuffer& shadow = m_vertex_buffers[first_binding + i];
+        redundant = shadow.buffer == buffers[i] && shadow.offset == offsets[i] &&
+                    shadow.size == (sizes ? sizes[i] : VK_WHOLE_SIZE);
+    }
+    if (redundant) {
+        ++filtered.vertex_buffers;
+        return true;
+    }
+
+    for (uint32_t i = 0; i < binding_count; ++i) {
+        BoundVertexBuffer& shadow = m_vertex_buffers[first_binding + i];
+        shadow.buffer = buffers[i];
+        shadow.offset = offsets[i];
+        shadow.size = sizes ? sizes[i] : VK_WHOLE_SIZE;
+    }
+    m_vertex_buffer_valid |= mask;
+    return false;
+}
+
+bool StateShadow::filter_bind_index_buffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType index_type) {
+    if (!m_filter_index_buffer) return false;
+    if (m_index_buffer == buffer && buffer != VK_NULL_HANDLE && m_index_offset == offset &&
+        m_index_type == index_type) {
+        ++filtered.index_buffers;
+        return true;
+    }
+    m_index_buffer = buffer;
+    m_index_offset = offset;
+    m_index_type = index_type;
+    return false;
+}
+
+// viewport / scissor 는 index 별로 비교합니다. 범위 밖은 추적하지 않고 넘깁니다.
+template <typename T>
+static bool filter_indexed(uint32_t first, uint32_t count, const T* values, T* shadow, uint32_t* valid,
+                           uint32_t max_count)
+{
+    if (count == 0 || first + count > max_count) return false;
+    uint32_t mask = (count >= 32 ? ~0u : (1u << count) - 1) << first;
+    if ((*valid & mask) == mask && memcmp(shadow + first, values, count * sizeof(T)) == 0) return true;
+    memcpy(shadow + first, values, count * sizeof(T));
+    *valid |= mask;
+    return false;
+}
+
+bool StateShadow::filter_set_viewport(uint32_t first, uint32_t count, const VkViewport* viewports) {
+    if (!filter_indexed(first, count, viewports, m_viewports, &m_viewport_valid, kMaxViewports)) return false;
+    ++filtered.dynamic_state;
+    return true;
+}
+
+bool StateShadow::filter_set_scissor(uint32_t first, uint32_t count, const VkRect2D* scissors) {
+    if (!filter_indexed(first, count, scissors, m_scissors, &m_scissor_valid, kMaxViewports)) return false;
+    ++filtered.dynamic_state;
+    return true;
+}
+
+bool StateShadow::filter_set_stencil(VkStencilFaceFlags face_mask, uint32_t value, uint32_t (&shadow)[2],
+                                     uint32_t valid_bit)
+{
+    // valid_bit 은 front, 그 다음 bit 은 back 입니다.
+    uint32_t faces = face_mask & VK_STENCIL_FACE_FRONT_AND_BACK;
+    if (faces == 0) return false;
+    bool redundant = true;
+    for (uint32_t face = 0; face < 2; ++face) {
+        if (!(faces & (1u << face))) continue;
+        redundant = redundant && (m_dynamic_valid & (valid_bit << face)) && shadow[face] == value;
+        shadow[face] = value;
+        m_dynamic_valid |= valid_bit << face;
+    }
+    if (redundant) ++filtered.dynamic_state;
+    return redundant;
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+// 중복 상태 변경 필터 (opt-in).
+//
+// 커맨드 버퍼마다 마지막으로 드라이버에 넘긴 바인딩 / 동적 상태의 사본 (StateShadow) 을 두고,
+// 같은 값을 다시 설정하는 vkCmd* 는 드라이버에 넘기지 않습니다.
+// - 파이프라인, 디스크립터 셋 (dynamic offset 포함), 버텍스 / 인덱스 버퍼
+// - viewport, scissor, line width, blend constants, depth bounds, stencil, 1.3 extended dynamic state
+//
+// 사본은 상태가 정의되지 않거나 레이어가 모르는 방식으로 바뀔 수 있는 지점에서 모두 버립니다.
+// - vkBeginCommandBuffer (secondary 포함), vkCmdExecuteCommands 직후
+// - render pass / dynamic rendering 시작, next subpass
+// 그래픽스 파이프라인이 실제로 바뀌면 동적 상태 사본도 버립니다. (정적 상태로 덮였을 수 있음)
+// 레이어가 훅하지 않는 명령으로 같은 상태를 바꿀 수 있는 확장이 켜져 있으면 해당 범주는 필터하지 않습니다.
+//
+// 걸러낸 호출 수는 vkEndCommandBuffer 에서 디바이스 누적값으로 합산하고, 프레임 프로파일러 리포트와
+// vkDestroyDevice 에서 로그로 남깁니다.
+//
+// 설정:
+//   debug.my_layer.state_filter  1 이면 켬 (기본 0)
+
+#define MY_LAYER_STATE_FILTER_STATS(X) \
+    X(pipelines) \
+    X(descriptor_sets) \
+    X(vertex_buffers) \
+    X(index_buffers) \
+    X(dynamic_state)
+
+struct StateFilterConfig {
+    bool enabled = false;
+    bool descriptor_sets = true;  // VK_KHR_maintenance6 / VK_EXT_descriptor_buffer 가 없을 때만
+    bool index_buffer = true;     // VK_KHR_maintenance5 (vkCmdBindIndexBuffer2) 가 없을 때만
+};
+
+StateFilterConfig load_state_filter_config(const VkDeviceCreateInfo* create_info, uint32_t api_version);
+
+struct StateFilterStats {
+#define MY_LAYER_STATE_FILTER_FIELD(name) uint64_t name = 0;
+    MY_LAYER_STATE_FILTER_STATS(MY_LAYER_STATE_FILTER_FIELD)
+#undef MY_LAYER_STATE_FILTER_FIELD
+
+    uint64_t total() const {
+        uint64_t sum = 0;
+#define MY_LAYER_STATE_FILTER_SUM(name) sum += name;
+        MY_LAYER_STATE_FILTER_STATS(MY_LAYER_STATE_FILTER_SUM)
+#undef MY_LAYER_STATE_FILTER_SUM
+        return sum;
+    }
+
+    void subtract(const StateFilterStats& other) {
+#define MY_LAYER_STATE_FILTER_SUBTRACT(name) name -= other.name;
+        MY_LAYER_STATE_FILTER_STATS(MY_LAYER_STATE_FILTER_SUBTRACT)
+#undef MY_LAYER_STATE_FILTER_SUBTRACT
+    }
+};
+
+// "<prefix>: dropped N calls (범주별 수)" 를 로그로 남깁니다.
+void log_state_filter_stats(const char* prefix, const StateFilterStats& stats);
+
+// 디바이스 전체 누적값. 여러 스레드가 vkEndCommandBuffer 에서 더하므로 fetch_add 를 씁니다.
+struct StateFilterTotals {
+#define MY_LAYER_STATE_FILTER_FIELD(name) std::atomic<uint64_t> name{0};
+    MY_LAYER_STATE_FILTER_STATS(MY_LAYER_STATE_FILTER_FIELD)
+#undef MY_LAYER_STATE_FILTER_FIELD
+
+    // 리포트하는 스레드만 사용 (직전 리포트 시점의 누적값)
+    StateFilterStats last_reported;
+
+    void add(const StateFilterStats& stats) {
+#define MY_LAYER_STATE_FILTER_ADD(name) \
+        if (stats.name) name.fetch_add(stats.name, std::memory_order_relaxed);
+        MY_LAYER_STATE_FILTER_STATS(MY_LAYER_STATE_FILTER_ADD)
+#undef MY_LAYER_STATE_FILTER_ADD
+    }
+
+    StateFilterStats load() const {
+        StateFilterStats stats;
+#define MY_LAYER_STATE_FILTER_LOAD(name) stats.name = name.load(std::memory_order_relaxed);
+        MY_LAYER_STATE_FILTER_STATS(MY_LAYER_STATE_FILTER_LOAD)
+#undef MY_LAYER_STATE_FILTER_LOAD
+        return stats;
+    }
+};
+
+// 커맨드 버퍼 하나의 사본. 커맨드 버퍼는 외부 동기화 대상이므로 lock 없이 씁니다.
+// filter_* 는 드라이버에 넘길 필요가 없는 (중복) 호출이면 true 를 돌려주고, 아니면 사본을 갱신합니다.
+class StateShadow {
+public:
+    static constexpr uint32_t kMaxDescriptorSets = 8;
+    static constexpr uint32_t kMaxVertexBuffers = 32;
+    static constexpr uint32_t kMaxViewports = 16;
+    static constexpr uint32_t kMaxDynamicOffsets = 8;  // 셋 하나당. 넘으면 추적하지 않습니다.
+
+    // vkBeginCommandBuffer 에서 호출합니다. 꺼진 범주는 이후 filter_* 가 항상 false 입니다.
+    void begin(const StateFilterConfig& config);
+    void reset();
+
+    bool filter_bind_pipeline(VkPipelineBindPoint bind_point, VkPipeline pipeline);
+    bool filter_bind_descriptor_sets(VkPipelineBindPoint bind_point, VkPipelineLayout layout, uint32_t first_set,
+                                     uint32_t set_count, const VkDescriptorSet* sets,
+                                     uint32_t dynamic_offset_count, const uint32_t* dynamic_offsets);
+    void on_push_descriptor_set(VkPipelineBindPoint bind_point, VkPipelineLayout layout, uint32_t set);
+    bool filter_bind_vertex_buffers(uint32_t first_binding, uint32_t binding_count, const VkBuffer* buffers,
+                                    const VkDeviceSize* offsets, const VkDeviceSize* sizes,
+                                    const VkDeviceSize* strides);
+    bool filter_bind_index_buffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType index_type);
+
+    bool filter_set_viewport(uint32_t first, uint32_t count, const VkViewport* viewports);
+    bool filter_set_scissor(uint32_t first, uint32_t count, const VkRect2D* scissors);
+    // vkCmdSetViewportWithCount / vkCmdSetScissorWithCount 는 개수까지 바꾸므로 사본만 버립니다.
+    void on_set_viewport_with_count() { m_viewport_valid = 0; }
+    void on_set_scissor_with_count() { m_scissor_valid = 0; }
+    bool filter_set_stencil(VkStencilFaceFlags face_mask, uint32_t value, uint32_t (&shadow)[2], uint32_t valid_bit);
+
+    // 값 하나짜리 동적 상태. valid_bit 은 DynamicState 중 하나입니다.
+    template <typename T>
+    bool filter_dynamic_state(uint32_t valid_bit, T& shadow, const T& value);
+
+    enum DynamicState : uint32_t {
+        kLineWidth = 1u << 0,
+        kBlendConstants = 1u << 1,
+        kDepthBounds = 1u << 2,
+        kStencilCompareMask = 1u << 3,  // front, back 순서로 2 bit 씩
+        kStencilWriteMask = 1u << 5,
+        kStencilReference = 1u << 7,
+        kCullMode = 1u << 9,
+        kFrontFace = 1u << 10,
+        kPrimitiveTopology = 1u << 11,
+        kDepthTestEnable = 1u << 12,
+        kDepthWriteEnable = 1u << 13,
+        kDepthCompareOp = 1u << 14,
+    };
+
+    // 동적 상태 사본
+    struct {
+        float line_width;
+        float blend_constants[4];
+        float depth_bounds[2];
+        uint32_t stencil_compare_mask[2];
+        uint32_t stencil_write_mask[2];
+        uint32_t stencil_reference[2];
+        VkCullModeFlags cull_mode;
+        VkFrontFace front_face;
+        VkPrimitiveTopology primitive_topology;
+        VkBool32 depth_test_enable;
+        VkBool32 depth_write_enable;
+        VkCompareOp depth_compare_op;
+    } dynamic;
+
+    StateFilterStats filtered;  // vkEndCommandBuffer 에서 디바이스 누적값으로 옮깁니다.
+
+private:
+    struct BoundDescriptorSet {
+        VkPipelineLayout layout;
+        VkDescriptorSet set;
+        uint32_t dynamic_offset_count;
+        uint32_t dynamic_offsets[kMaxDynamicOffsets];
+    };
+    struct BoundVertexBuffer {
+        VkBuffer buffer;
+        VkDeviceSize offset;
+        VkDeviceSize size;
+    };
+
+    // VK_PIPELINE_BIND_POINT_GRAPHICS / COMPUTE 만 추적합니다. 그 외 (ray tracing 등) 는 -1.
+    static int bind_point_index(VkPipelineBindPoint bind_point) {
+        return (uint32_t)bind_point <= VK_PIPELINE_BIND_POINT_COMPUTE ? (int)bind_point : -1;
+    }
+    void invalidate_descriptor_sets(int bind_point, VkPipelineLayout layout, uint32_t first, uint32_t count);
+
+    VkPipeline m_pipelines[2] = {};  // VK_NULL_HANDLE 이면 모름
+    BoundDescriptorSet m_descriptor_sets[2][kMaxDescriptorSets] = {};
+    uint32_t m_descriptor_set_valid[2] = {};  // bit i = set i
+    BoundVertexBuffer m_vertex_buffers[kMaxVertexBuffers] = {};
+    uint32_t m_vertex_buffer_valid = 0;
+    VkBuffer m_index_buffer = VK_NULL_HANDLE;  // VK_NULL_HANDLE 이면 모름
+    VkDeviceSize m_index_offset = 0;
+    VkIndexType m_index_type = VK_INDEX_TYPE_UINT16;
+    VkViewport m_viewports[kMaxViewports] = {};
+    uint32_t m_viewport_valid = 0;
+    VkRect2D m_scissors[kMaxViewports] = {};
+    uint32_t m_scissor_valid = 0;
+    uint32_t m_dynamic_valid = 0;
+    bool m_filter_descriptor_sets = false;
+    bool m_filter_index_buffer = false;
+};
+
+template <typename T>
+bool StateShadow::filter_dynamic_state(uint32_t valid_bit, T& shadow, const T& value) {
+    // float 도 비트 단위로 비교합니다. (0.0 과 -0.0 은 다른 값으로 보고 그대로 넘깁니다)
+    if ((m_dynamic_valid & valid_bit) && memcmp(&shadow, &value, sizeof(T)) == 0) {
+        ++filtered.dynamic_state;
+        return true;
+    }
+    memcpy(&shadow, &value, sizeof(T));
+    m_dynamic_valid |= valid_bit;
+    return false;
+}
@@ -0,0 +1,111 @@
+#include "telemetry.h"
+
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "clock.h"
+#include "settings.h"
+#include "utils.h"
+
+std::atomic<TelemetryRegion*> g_telemetry{nullptr};
+
+// 파일을 만들고 flock 을 잡습니다. 같은 이름을 다른 프로세스가 잡고 있으면 -1.
+static int open_locked(const std::string& path) {
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) return -1;
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static TelemetryRegion* create_region() {
+    const std::string& package = get_app_package_name();
+    std::string dir = layer_settings().telemetry_dir;
+    if (dir.empty()) dir = platform_get_cache_dir(package);
+    if (dir.empty()) {
+        ALOGW("telemetry: no directory to create the shared memory file in");
+        return nullptr;
+    }
+
+    std::string path = dir + "/telemetry_" + to_file_name_part(package) + ".shm";
+    int fd = open_locked(path);
+    if (fd < 0) {
+        path = dir + "/telemetry_" + to_file_name_part(package) + "_" + std::to_string(getpid()) + ".shm";
+        fd = open_locked(path);
+    }
+    if (fd < 0) {
+        ALOGW("telemetry: can't open %s (errno %d)", path.c_str(), errno);
+        return nullptr;
+    }
+
+    // 리더가 이전 프로세스의 파일을 map 하고 있을 수 있으므로 줄이지 않습니다. (줄이면 리더가 SIGBUS)
+    // 필요한 크기까지 늘리기만 하고, 내용은 map 한 뒤 제자리에서 지웁니다.
+    // flock 은 fd 를 닫지 않는 한 (프로세스가 끝날 때까지) 유지됩니다.
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 ||
+        ((size_t)file_stat.st_size < sizeof(TelemetryRegion) && ftruncate(fd, sizeof(TelemetryRegion)) != 0)) {
+        ALOGW("telemetry: can't resize %s (errno %d)", path.c_str(), errno);
+        close(fd);
+        return nullptr;
+    }
+    void* mapped = mmap(nullptr, sizeof(TelemetryRegion), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        ALOGW("telemetry: can't map %s (errno %d)", path.c_str(), errno);
+        close(fd);
+        return nullptr;
+    }
+
+    // 이전 프로세스가 남긴 내용은 버립니다. magic 을 먼저 0 으로 만들어 리더가 기다리게 한 뒤
+    // 나머지를 지웁니다. 리더는 magic 이 다시 설정되면 pid / start_ns 가 바뀐 것을 보고 다시 붙습니다.
+    static_cast<TelemetryRegion*>(mapped)->header.magic.store(0, std::memory_order_release);
+    memset(mapped, 0, sizeof(TelemetryRegion));
+
+    // 0 으로 지운 영역이므로 atomic 들도 0 으로 시작합니다.
+    TelemetryRegion* region = new (mapped) TelemetryRegion;
+    TelemetryHeader& header = region->header;
+    header.version = kTelemetryVersion;
+    header.header_size = sizeof(TelemetryHeader);
+    header.total_size = sizeof(TelemetryRegion);
+    header.counter_count = (uint32_t)TelemetryCounter::Count;
+    header.ring_count = kTelemetryMaxRings;
+    header.ring_capacity = kTelemetryRingCapacity;
+    header.record_size = sizeof(TelemetryFrameRecord);
+    header.pid = (int32_t)getpid();
+    strncpy(header.package, package.c_str(), kTelemetryPackageBytes - 1);
+    header.start_ns.store(monotonic_now_ns(), std::memory_order_relaxed);
+    header.magic.store(kTelemetryMagic, std::memory_order_release);
+
+    ALOGI("telemetry: publishing to %s (%zu KiB)", path.c_str(), sizeof(TelemetryRegion) / 1024);
+    return region;
+}
+
+void telemetry_init() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        if (!layer_settings().telemetry) return;
+        g_telemetry.store(create_region(), std::memory_order_release);
+    });
+}
+
+TelemetryRing* telemetry_claim_ring(TelemetryRegion* region, uint64_t owner) {
+    for (TelemetryRing& ring : region->rings) {
+        uint64_t expected = 0;
+        if (ring.owner.compare_exchange_strong(expected, owner, std::memory_order_acq_rel)) return &ring;
+    }
+    return nullptr;
+}
+
+void telemetry_release_ring(TelemetryRing* ring) {
+    ring->owner.store(0, std::memory_order_release);
+}
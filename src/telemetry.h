@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "telemetry_format.h"
+
+// 공유 메모리 텔레메트리 (opt-in).
+//
+// 카운터와 프레임 레코드를 mmap 한 파일 (telemetry_format.h 레이아웃) 에 직접 써서, 외부 리더가
+// 앱 프로세스의 문자열 포맷팅이나 logcat / binder 트래픽 없이 실시간으로 읽을 수 있게 합니다.
+// 기록은 atomic store 뿐이라 시스템 콜이 없습니다.
+//
+// 파일은 프로세스마다 하나이며, get_app_package_name() 으로 이름을 정합니다.
+//   <telemetry_dir>/telemetry_<패키지>.shm
+// 같은 패키지의 다른 프로세스가 이미 쓰고 있으면 (flock) 이름 뒤에 _<pid> 를 붙입니다.
+// 프레임 레코드는 프레임 프로파일러가 present 마다 남기므로 debug.my_layer.profile 이 켜져 있어야 합니다.
+//
+// 설정:
+//   debug.my_layer.telemetry      1 이면 켬 (기본 0)
+//   debug.my_layer.telemetry_dir  파일 디렉터리 (기본 platform_get_cache_dir())
+
+// vkCreateDevice 에서 호출합니다. 처음 한 번만 파일을 만들고, 이후 프로세스가 끝날 때까지 유지합니다.
+void telemetry_init();
+
+extern std::atomic<TelemetryRegion*> g_telemetry;
+
+// 꺼져 있거나 만들지 못했으면 nullptr.
+inline TelemetryRegion* telemetry_region() {
+    return g_telemetry.load(std::memory_order_acquire);
+}
+
+inline void telemetry_set_counter(TelemetryRegion* region, TelemetryCounter counter, uint64_t value) {
+    region->header.counters[(size_t)counter].store(value, std::memory_order_relaxed);
+}
+
+// 빈 링을 owner (큐 핸들) 에게 줍니다. 남은 링이 없으면 nullptr.
+TelemetryRing* telemetry_claim_ring(TelemetryRegion* region, uint64_t owner);
+void telemetry_release_ring(TelemetryRing* ring);
+
+// 링의 유일한 writer 만 호출합니다.
+inline void telemetry_publish(TelemetryRing* ring, const TelemetryFrameRecord& record) {
+    uint64_t index = ring->head.load(std::memory_order_relaxed);
+    TelemetrySlot& slot = ring->slots[index & (kTelemetryRingCapacity - 1)];
+    uint64_t words[kTelemetryRecordWords];
+    __builtin_memcpy(words, &record, sizeof(record));
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kTelemetryRecordWords; ++i) slot.words[i].store(words[i], std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+    ring->head.store(index + 1, std::memory_order_release);
+}
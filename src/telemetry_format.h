@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// 레이어와 외부 리더 (tools/telemetry_reader) 가 공유하는 텔레메트리 공유 메모리 레이아웃.
+// 레이어 의존성 없이 이 헤더만으로 읽을 수 있어야 합니다. 레이아웃을 바꾸면 kTelemetryVersion 을 올립니다.
+//
+// [TelemetryHeader][TelemetryRing x kTelemetryMaxRings]
+//
+// - 카운터: 누적값을 relaxed store 로 덮어씁니다. 값 하나씩은 항상 온전하지만 카운터끼리는 같은 시점이
+//   아닐 수 있습니다.
+// - 링: 큐 하나 (present 하는 스레드) 가 유일한 writer 입니다. 슬롯마다 seqlock 시퀀스가 있어서
+//   레코드 i 를 쓰는 중에는 2i+1, 다 쓰면 2i+2 입니다. 리더는 시퀀스를 읽고, 페이로드를 복사하고,
+//   시퀀스를 다시 읽어 둘 다 2i+2 일 때만 레코드 i 로 인정합니다. writer 는 기다리지 않으므로 리더가
+//   느리면 레코드를 잃을 뿐 앱은 영향을 받지 않습니다.
+// - 시각은 모두 CLOCK_MONOTONIC ns 이므로 같은 기기의 다른 프로세스와 비교할 수 있습니다.
+// - 모든 atomic 은 lock-free (address-free) 여야 프로세스 사이에서 쓸 수 있습니다.
+
+constexpr uint32_t kTelemetryMagic = 0x4d544c4d;  // "MLTM"
+constexpr uint32_t kTelemetryVersion = 1;
+constexpr uint32_t kTelemetryMaxRings = 8;
+constexpr uint32_t kTelemetryRingCapacity = 1024;  // 2의 거듭제곱
+constexpr size_t kTelemetryPackageBytes = 128;
+
+#define MY_LAYER_TELEMETRY_COUNTERS(X) \
+    X(frames) \
+    X(submits) \
+    X(draws) \
+    X(dispatches) \
+    X(state_changes) \
+    X(stutters) \
+    X(state_filter_dropped) \
+    X(memory_live_bytes) \
+    X(memory_driver_bytes) \
+    X(memory_driver_allocations) \
+    X(pacing_late) \
+    X(log_dropped)
+
+enum class TelemetryCounter : uint32_t {
+#define MY_LAYER_TELEMETRY_ENUM(name) name,
+    MY_LAYER_TELEMETRY_COUNTERS(MY_LAYER_TELEMETRY_ENUM)
+#undef MY_LAYER_TELEMETRY_ENUM
+    Count
+};
+
+inline const char* telemetry_counter_name(uint32_t index) {
+    static const char* const kNames[] = {
+#define MY_LAYER_TELEMETRY_NAME(name) #name,
+        MY_LAYER_TELEMETRY_COUNTERS(MY_LAYER_TELEMETRY_NAME)
+#undef MY_LAYER_TELEMETRY_NAME
+    };
+    return index < (uint32_t)TelemetryCounter::Count ? kNames[index] : "?";
+}
+
+// TelemetryFrameRecord::flags
+constexpr uint32_t kTelemetryFrameStutter = 1u << 0;
+
+// present 한 번의 기록. 카운트는 직전 present 이후 디바이스 전체 값입니다.
+// (draws / dispatches / state_changes 는 debug.my_layer.cmd_stats 가 꺼져 있으면 0)
+struct TelemetryFrameRecord {
+    uint64_t present_ns;
+    uint64_t frame_ns;
+    uint32_t present_cpu_us;
+    uint32_t submits;
+    uint32_t draws;
+    uint32_t dispatches;
+    uint32_t state_changes;
+    uint32_t flags;
+};
+
+constexpr size_t kTelemetryRecordWords = sizeof(TelemetryFrameRecord) / sizeof(uint64_t);
+static_assert(sizeof(TelemetryFrameRecord) % sizeof(uint64_t) == 0);
+
+// 페이로드도 relaxed atomic 워드로 읽고 써서 리더와의 경쟁이 data race 가 되지 않게 합니다.
+struct TelemetrySlot {
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> words[kTelemetryRecordWords];
+};
+
+struct TelemetryRing {
+    std::atomic<uint64_t> owner;  // 쓰고 있는 큐 핸들. 0 이면 비어 있음
+    std::atomic<uint64_t> head;   // 다음에 쓸 레코드 index (주인이 바뀌어도 이어서 증가)
+    TelemetrySlot slots[kTelemetryRingCapacity];
+};
+
+struct TelemetryHeader {
+    std::atomic<uint32_t> magic;  // 나머지를 다 채운 뒤 마지막에 씁니다.
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t total_size;
+    uint32_t counter_count;
+    uint32_t ring_count;
+    uint32_t ring_capacity;
+    uint32_t record_size;
+    int32_t pid;
+    uint32_t reserved;
+    char package[kTelemetryPackageBytes];
+    std::atomic<uint64_t> start_ns;
+    std::atomic<uint64_t> update_ns;  // 마지막 present 시각. 리더가 앱이 멈췄는지 판단할 때 씁니다.
+    std::atomic<uint64_t> counters[(size_t)TelemetryCounter::Count];
+};
+
+struct TelemetryRegion {
+    TelemetryHeader header;
+    TelemetryRing rings[kTelemetryMaxRings];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free);
+
+// 리더용. 레코드 i 를 읽어서 온전하면 true.
+inline bool telemetry_read_record(const TelemetryRing& ring, uint64_t index, TelemetryFrameRecord* out) {
+    const TelemetrySlot& slot = ring.slots[index & (kTelemetryRingCapacity - 1)];
+    uint64_t expected = 2 * index + 2;
+    if (slot.sequence.load(std::memory_order_acquire) != expected) return false;
+    uint64_t words[kTelemetryRecordWords];
+    for (size_t i = 0; i < kTelemetryRecordWords; ++i) words[i] = slot.words[i].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != expected) return false;
+    __builtin_memcpy(out, words, sizeof(*out));
+    return true;
+}
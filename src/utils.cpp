@@ -2,25 +2,42 @@
 
 #include <fstream>
 #include <string>
-#include <cstdlib>
-#include <sys/system_properties.h>
 
-static std::string cur_pkg = get_app_package_name();
-
-std::string get_app_package_name() {
-    std::ifstream cmdline("/proc/self/cmdline");
-    std::string pkg;
-    if (cmdline) std::getline(cmdline, pkg, '\0');
+const std::string& get_app_package_name() {
+    static const std::string pkg = [] {
+        std::ifstream cmdline("/proc/self/cmdline");
+        std::string name;
+        if (cmdline) std::getline(cmdline, name, '\0');
+        return name;
+    }();
     return pkg;
 }
 
-bool should_enable_layer() {
-    // adb shell setprop debug.my_layer_package com.example.myapp
-    char value[PROP_VALUE_MAX];
-    __system_property_get("debug.my_layer_package", value);
-
-    std::string target_pkg(value);
-    if (target_pkg.empty()) return false;
+std::string to_file_name_part(const std::string& package) {
+    std::string name = package.substr(0, package.find(':'));
+    size_t slash = name.rfind('/');
+    if (slash != std::string::npos) name = name.substr(slash + 1);
+    for (char& c : name) {
+        bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                       c == '.' || c == '_' || c == '-';
+        if (!allowed) c = '_';
+    }
+    return name.empty() ? "unknown" : name;
+}
 
-    return cur_pkg == target_pkg;
-}
\ No newline at end of file
+bool private_data_enabled(const VkDeviceCreateInfo* create_info) {
+    for (const VkBaseInStructure* next = static_cast<const VkBaseInStructure*>(create_info->pNext); next;
+         next = next->pNext) {
+        switch (next->sType) {
+            case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES:
+                if (reinterpret_cast<const VkPhysicalDeviceVulkan13Features*>(next)->privateData) return true;
+                break;
+            case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRIVATE_DATA_FEATURES:
+                if (reinterpret_cast<const VkPhysicalDevicePrivateDataFeatures*>(next)->privateData) return true;
+                break;
+            default:
+                break;
+        }
+    }
+    return false;
+}
@@ -1,11 +1,19 @@
 #pragma once
 
-#include <android/log.h>
-#include <iostream>
+#include <vulkan/vulkan.h>
 
-#define LOG_TAG "MyLayer"
-#define ALOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
-#define ALOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+#include "log.h"
 
-std::string get_app_package_name();
-bool should_enable_layer();
\ No newline at end of file
+#include <cstdint>
+#include <string>
+
+// /proc/self/cmdline 의 프로세스 이름 ("com.example.app", "com.example.app:remote", "/usr/bin/app").
+// 처음 호출할 때 한 번 읽고 그 뒤로는 저장해 둔 값을 돌려줍니다.
+const std::string& get_app_package_name();
+
+// "com.example.app:remote", "/usr/bin/app" 같은 이름을 파일 이름에 쓸 수 있게 바꿉니다.
+std::string to_file_name_part(const std::string& package);
+
+// privateData 기능 (1.3 core 또는 VK_EXT_private_data) 이 켜져 있는지. 켜져 있으면 vkSetPrivateData 가
+// 객체를 핸들로 구분하므로, 서로 다른 객체에 같은 non-dispatchable 핸들을 돌려주면 안 됩니다.
+bool private_data_enabled(const VkDeviceCreateInfo* create_info);
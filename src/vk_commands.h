@@ -0,0 +1,372 @@
+#pragma once
+
+// 레이어가 디스패치 테이블로 관리하는 Vulkan 명령 목록 (X-macro).
+// Core 1.0 ~ 1.3 과 Android 에서 자주 쓰이는 확장 명령을 포함합니다.
+// X(name) 의 name 은 "vk" 접두어를 뺀 이름입니다. (ex. X(QueueSubmit) -> vkQueueSubmit)
+//
+// 명령을 추가할 때는 instance / device 레벨을 구분해서 넣어야 합니다.
+// 첫 번째 인자가 VkDevice, VkQueue, VkCommandBuffer 이면 device 레벨입니다.
+
+#define MY_LAYER_INSTANCE_COMMANDS(X) \
+    /* VK_VERSION_1_0 */ \
+    X(DestroyInstance) \
+    X(EnumeratePhysicalDevices) \
+    X(GetPhysicalDeviceFeatures) \
+    X(GetPhysicalDeviceFormatProperties) \
+    X(GetPhysicalDeviceImageFormatProperties) \
+    X(GetPhysicalDeviceProperties) \
+    X(GetPhysicalDeviceQueueFamilyProperties) \
+    X(GetPhysicalDeviceMemoryProperties) \
+    X(CreateDevice) \
+    X(EnumerateDeviceExtensionProperties) \
+    X(EnumerateDeviceLayerProperties) \
+    X(GetPhysicalDeviceSparseImageFormatProperties) \
+    /* VK_VERSION_1_1 */ \
+    X(EnumeratePhysicalDeviceGroups) \
+    X(GetPhysicalDeviceFeatures2) \
+    X(GetPhysicalDeviceProperties2) \
+    X(GetPhysicalDeviceFormatProperties2) \
+    X(GetPhysicalDeviceImageFormatProperties2) \
+    X(GetPhysicalDeviceQueueFamilyProperties2) \
+    X(GetPhysicalDeviceMemoryProperties2) \
+    X(GetPhysicalDeviceSparseImageFormatProperties2) \
+    X(GetPhysicalDeviceExternalBufferProperties) \
+    X(GetPhysicalDeviceExternalFenceProperties) \
+    X(GetPhysicalDeviceExternalSemaphoreProperties) \
+    /* VK_VERSION_1_3 */ \
+    X(GetPhysicalDeviceToolProperties) \
+    /* VK_KHR_surface */ \
+    X(DestroySurfaceKHR) \
+    X(GetPhysicalDeviceSurfaceSupportKHR) \
+    X(GetPhysicalDeviceSurfaceCapabilitiesKHR) \
+    X(GetPhysicalDeviceSurfaceFormatsKHR) \
+    X(GetPhysicalDeviceSurfacePresentModesKHR) \
+    /* VK_KHR_swapchain */ \
+    X(GetPhysicalDevicePresentRectanglesKHR) \
+    /* VK_KHR_get_surface_capabilities2 */ \
+    X(GetPhysicalDeviceSurfaceCapabilities2KHR) \
+    X(GetPhysicalDeviceSurfaceFormats2KHR) \
+    /* VK_KHR_get_physical_device_properties2 */ \
+    X(GetPhysicalDeviceFeatures2KHR) \
+    X(GetPhysicalDeviceProperties2KHR) \
+    X(GetPhysicalDeviceFormatProperties2KHR) \
+    X(GetPhysicalDeviceImageFormatProperties2KHR) \
+    X(GetPhysicalDeviceQueueFamilyProperties2KHR) \
+    X(GetPhysicalDeviceMemoryProperties2KHR) \
+    X(GetPhysicalDeviceSparseImageFormatProperties2KHR) \
+    /* VK_EXT_debug_utils */ \
+    X(CreateDebugUtilsMessengerEXT) \
+    X(DestroyDebugUtilsMessengerEXT) \
+    X(SubmitDebugUtilsMessageEXT) \
+    /* VK_EXT_debug_report */ \
+    X(CreateDebugReportCallbackEXT) \
+    X(DestroyDebugReportCallbackEXT) \
+    X(DebugReportMessageEXT) \
+    MY_LAYER_INSTANCE_COMMANDS_ANDROID(X)
+
+#if defined(VK_USE_PLATFORM_ANDROID_KHR)
+#define MY_LAYER_INSTANCE_COMMANDS_ANDROID(X) \
+    /* VK_KHR_android_surface */ \
+    X(CreateAndroidSurfaceKHR)
+#else
+#define MY_LAYER_INSTANCE_COMMANDS_ANDROID(X)
+#endif
+
+#define MY_LAYER_DEVICE_COMMANDS(X) \
+    /* VK_VERSION_1_0 */ \
+    X(DestroyDevice) \
+    X(GetDeviceQueue) \
+    X(QueueSubmit) \
+    X(QueueWaitIdle) \
+    X(DeviceWaitIdle) \
+    X(AllocateMemory) \
+    X(FreeMemory) \
+    X(MapMemory) \
+    X(UnmapMemory) \
+    X(FlushMappedMemoryRanges) \
+    X(InvalidateMappedMemoryRanges) \
+    X(GetDeviceMemoryCommitment) \
+    X(BindBufferMemory) \
+    X(BindImageMemory) \
+    X(GetBufferMemoryRequirements) \
+    X(GetImageMemoryRequirements) \
+    X(GetImageSparseMemoryRequirements) \
+    X(QueueBindSparse) \
+    X(CreateFence) \
+    X(DestroyFence) \
+    X(ResetFences) \
+    X(GetFenceStatus) \
+    X(WaitForFences) \
+    X(CreateSemaphore) \
+    X(DestroySemaphore) \
+    X(CreateEvent) \
+    X(DestroyEvent) \
+    X(GetEventStatus) \
+    X(SetEvent) \
+    X(ResetEvent) \
+    X(CreateQueryPool) \
+    X(DestroyQueryPool) \
+    X(GetQueryPoolResults) \
+    X(CreateBuffer) \
+    X(DestroyBuffer) \
+    X(CreateBufferView) \
+    X(DestroyBufferView) \
+    X(CreateImage) \
+    X(DestroyImage) \
+    X(GetImageSubresourceLayout) \
+    X(CreateImageView) \
+    X(DestroyImageView) \
+    X(CreateShaderModule) \
+    X(DestroyShaderModule) \
+    X(CreatePipelineCache) \
+    X(DestroyPipelineCache) \
+    X(GetPipelineCacheData) \
+    X(MergePipelineCaches) \
+    X(CreateGraphicsPipelines) \
+    X(CreateComputePipelines) \
+    X(DestroyPipeline) \
+    X(CreatePipelineLayout) \
+    X(DestroyPipelineLayout) \
+    X(CreateSampler) \
+    X(DestroySampler) \
+    X(CreateDescriptorSetLayout) \
+    X(DestroyDescriptorSetLayout) \
+    X(CreateDescriptorPool) \
+    X(DestroyDescriptorPool) \
+    X(ResetDescriptorPool) \
+    X(AllocateDescriptorSets) \
+    X(FreeDescriptorSets) \
+    X(UpdateDescriptorSets) \
+    X(CreateFramebuffer) \
+    X(DestroyFramebuffer) \
+    X(CreateRenderPass) \
+    X(DestroyRenderPass) \
+    X(GetRenderAreaGranularity) \
+    X(CreateCommandPool) \
+    X(DestroyCommandPool) \
+    X(ResetCommandPool) \
+    X(AllocateCommandBuffers) \
+    X(FreeCommandBuffers) \
+    X(BeginCommandBuffer) \
+    X(EndCommandBuffer) \
+    X(ResetCommandBuffer) \
+    X(CmdBindPipeline) \
+    X(CmdSetViewport) \
+    X(CmdSetScissor) \
+    X(CmdSetLineWidth) \
+    X(CmdSetDepthBias) \
+    X(CmdSetBlendConstants) \
+    X(CmdSetDepthBounds) \
+    X(CmdSetStencilCompareMask) \
+    X(CmdSetStencilWriteMask) \
+    X(CmdSetStencilReference) \
+    X(CmdBindDescriptorSets) \
+    X(CmdBindIndexBuffer) \
+    X(CmdBindVertexBuffers) \
+    X(CmdDraw) \
+    X(CmdDrawIndexed) \
+    X(CmdDrawIndirect) \
+    X(CmdDrawIndexedIndirect) \
+    X(CmdDispatch) \
+    X(CmdDispatchIndirect) \
+    X(CmdCopyBuffer) \
+    X(CmdCopyImage) \
+    X(CmdBlitImage) \
+    X(CmdCopyBufferToImage) \
+    X(CmdCopyImageToBuffer) \
+    X(CmdUpdateBuffer) \
+    X(CmdFillBuffer) \
+    X(CmdClearColorImage) \
+    X(CmdClearDepthStencilImage) \
+    X(CmdClearAttachments) \
+    X(CmdResolveImage) \
+    X(CmdSetEvent) \
+    X(CmdResetEvent) \
+    X(CmdWaitEvents) \
+    X(CmdPipelineBarrier) \
+    X(CmdBeginQuery) \
+    X(CmdEndQuery) \
+    X(CmdResetQueryPool) \
+    X(CmdWriteTimestamp) \
+    X(CmdCopyQueryPoolResults) \
+    X(CmdPushConstants) \
+    X(CmdBeginRenderPass) \
+    X(CmdNextSubpass) \
+    X(CmdEndRenderPass) \
+    X(CmdExecuteCommands) \
+    /* VK_VERSION_1_1 */ \
+    X(BindBufferMemory2) \
+    X(BindImageMemory2) \
+    X(GetDeviceGroupPeerMemoryFeatures) \
+    X(CmdSetDeviceMask) \
+    X(CmdDispatchBase) \
+    X(GetImageMemoryRequirements2) \
+    X(GetBufferMemoryRequirements2) \
+    X(GetImageSparseMemoryRequirements2) \
+    X(TrimCommandPool) \
+    X(GetDeviceQueue2) \
+    X(CreateSamplerYcbcrConversion) \
+    X(DestroySamplerYcbcrConversion) \
+    X(CreateDescriptorUpdateTemplate) \
+    X(DestroyDescriptorUpdateTemplate) \
+    X(UpdateDescriptorSetWithTemplate) \
+    X(GetDescriptorSetLayoutSupport) \
+    /* VK_VERSION_1_2 */ \
+    X(CmdDrawIndirectCount) \
+    X(CmdDrawIndexedIndirectCount) \
+    X(CreateRenderPass2) \
+    X(CmdBeginRenderPass2) \
+    X(CmdNextSubpass2) \
+    X(CmdEndRenderPass2) \
+    X(ResetQueryPool) \
+    X(GetSemaphoreCounterValue) \
+    X(WaitSemaphores) \
+    X(SignalSemaphore) \
+    X(GetBufferDeviceAddress) \
+    X(GetBufferOpaqueCaptureAddress) \
+    X(GetDeviceMemoryOpaqueCaptureAddress) \
+    /* VK_VERSION_1_3 */ \
+    X(CreatePrivateDataSlot) \
+    X(DestroyPrivateDataSlot) \
+    X(SetPrivateData) \
+    X(GetPrivateData) \
+    X(CmdSetEvent2) \
+    X(CmdResetEvent2) \
+    X(CmdWaitEvents2) \
+    X(CmdPipelineBarrier2) \
+    X(CmdWriteTimestamp2) \
+    X(QueueSubmit2) \
+    X(CmdCopyBuffer2) \
+    X(CmdCopyImage2) \
+    X(CmdCopyBufferToImage2) \
+    X(CmdCopyImageToBuffer2) \
+    X(CmdBlitImage2) \
+    X(CmdResolveImage2) \
+    X(CmdBeginRendering) \
+    X(CmdEndRendering) \
+    X(CmdSetCullMode) \
+    X(CmdSetFrontFace) \
+    X(CmdSetPrimitiveTopology) \
+    X(CmdSetViewportWithCount) \
+    X(CmdSetScissorWithCount) \
+    X(CmdBindVertexBuffers2) \
+    X(CmdSetDepthTestEnable) \
+    X(CmdSetDepthWriteEnable) \
+    X(CmdSetDepthCompareOp) \
+    X(CmdSetDepthBoundsTestEnable) \
+    X(CmdSetStencilTestEnable) \
+    X(CmdSetStencilOp) \
+    X(CmdSetRasterizerDiscardEnable) \
+    X(CmdSetDepthBiasEnable) \
+    X(CmdSetPrimitiveRestartEnable) \
+    X(GetDeviceBufferMemoryRequirements) \
+    X(GetDeviceImageMemoryRequirements) \
+    X(GetDeviceImageSparseMemoryRequirements) \
+    /* VK_KHR_swapchain */ \
+    X(CreateSwapchainKHR) \
+    X(DestroySwapchainKHR) \
+    X(GetSwapchainImagesKHR) \
+    X(AcquireNextImageKHR) \
+    X(QueuePresentKHR) \
+    X(GetDeviceGroupPresentCapabilitiesKHR) \
+    X(GetDeviceGroupSurfacePresentModesKHR) \
+    X(AcquireNextImage2KHR) \
+    /* VK_KHR_maintenance1 */ \
+    X(TrimCommandPoolKHR) \
+    /* VK_KHR_bind_memory2 */ \
+    X(BindBufferMemory2KHR) \
+    X(BindImageMemory2KHR) \
+    /* VK_KHR_get_memory_requirements2 */ \
+    X(GetImageMemoryRequirements2KHR) \
+    X(GetBufferMemoryRequirements2KHR) \
+    X(GetImageSparseMemoryRequirements2KHR) \
+    /* VK_KHR_maintenance3 */ \
+    X(GetDescriptorSetLayoutSupportKHR) \
+    /* VK_KHR_maintenance4 */ \
+    X(GetDeviceBufferMemoryRequirementsKHR) \
+    X(GetDeviceImageMemoryRequirementsKHR) \
+    X(GetDeviceImageSparseMemoryRequirementsKHR) \
+    /* VK_KHR_descriptor_update_template */ \
+    X(CreateDescriptorUpdateTemplateKHR) \
+    X(DestroyDescriptorUpdateTemplateKHR) \
+    X(UpdateDescriptorSetWithTemplateKHR) \
+    X(CmdPushDescriptorSetWithTemplateKHR) \
+    /* VK_KHR_push_descriptor */ \
+    X(CmdPushDescriptorSetKHR) \
+    /* VK_KHR_create_renderpass2 */ \
+    X(CreateRenderPass2KHR) \
+    X(CmdBeginRenderPass2KHR) \
+    X(CmdNextSubpass2KHR) \
+    X(CmdEndRenderPass2KHR) \
+    /* VK_KHR_draw_indirect_count */ \
+    X(CmdDrawIndirectCountKHR) \
+    X(CmdDrawIndexedIndirectCountKHR) \
+    /* VK_KHR_timeline_semaphore */ \
+    X(GetSemaphoreCounterValueKHR) \
+    X(WaitSemaphoresKHR) \
+    X(SignalSemaphoreKHR) \
+    /* VK_KHR_buffer_device_address */ \
+    X(GetBufferDeviceAddressKHR) \
+    X(GetBufferOpaqueCaptureAddressKHR) \
+    X(GetDeviceMemoryOpaqueCaptureAddressKHR) \
+    /* VK_KHR_synchronization2 */ \
+    X(CmdSetEvent2KHR) \
+    X(CmdResetEvent2KHR) \
+    X(CmdWaitEvents2KHR) \
+    X(CmdPipelineBarrier2KHR) \
+    X(CmdWriteTimestamp2KHR) \
+    X(QueueSubmit2KHR) \
+    /* VK_KHR_copy_commands2 */ \
+    X(CmdCopyBuffer2KHR) \
+    X(CmdCopyImage2KHR) \
+    X(CmdCopyBufferToImage2KHR) \
+    X(CmdCopyImageToBuffer2KHR) \
+    X(CmdBlitImage2KHR) \
+    X(CmdResolveImage2KHR) \
+    /* VK_KHR_dynamic_rendering */ \
+    X(CmdBeginRenderingKHR) \
+    X(CmdEndRenderingKHR) \
+    /* VK_KHR_map_memory2 */ \
+    X(MapMemory2KHR) \
+    X(UnmapMemory2KHR) \
+    /* VK_EXT_extended_dynamic_state */ \
+    X(CmdSetCullModeEXT) \
+    X(CmdSetFrontFaceEXT) \
+    X(CmdSetPrimitiveTopologyEXT) \
+    X(CmdSetViewportWithCountEXT) \
+    X(CmdSetScissorWithCountEXT) \
+    X(CmdBindVertexBuffers2EXT) \
+    X(CmdSetDepthTestEnableEXT) \
+    X(CmdSetDepthWriteEnableEXT) \
+    X(CmdSetDepthCompareOpEXT) \
+    X(CmdSetDepthBoundsTestEnableEXT) \
+    X(CmdSetStencilTestEnableEXT) \
+    X(CmdSetStencilOpEXT) \
+    /* VK_EXT_extended_dynamic_state2 */ \
+    X(CmdSetPatchControlPointsEXT) \
+    X(CmdSetRasterizerDiscardEnableEXT) \
+    X(CmdSetDepthBiasEnableEXT) \
+    X(CmdSetLogicOpEXT) \
+    X(CmdSetPrimitiveRestartEnableEXT) \
+    /* VK_EXT_debug_utils */ \
+    X(SetDebugUtilsObjectNameEXT) \
+    X(SetDebugUtilsObjectTagEXT) \
+    X(QueueBeginDebugUtilsLabelEXT) \
+    X(QueueEndDebugUtilsLabelEXT) \
+    X(QueueInsertDebugUtilsLabelEXT) \
+    X(CmdBeginDebugUtilsLabelEXT) \
+    X(CmdEndDebugUtilsLabelEXT) \
+    X(CmdInsertDebugUtilsLabelEXT) \
+    /* VK_GOOGLE_display_timing */ \
+    X(GetRefreshCycleDurationGOOGLE) \
+    X(GetPastPresentationTimingGOOGLE) \
+    MY_LAYER_DEVICE_COMMANDS_ANDROID(X)
+
+#if defined(VK_USE_PLATFORM_ANDROID_KHR)
+#define MY_LAYER_DEVICE_COMMANDS_ANDROID(X) \
+    /* VK_ANDROID_external_memory_android_hardware_buffer */ \
+    X(GetAndroidHardwareBufferPropertiesANDROID) \
+    X(GetMemoryAndroidHardwareBufferANDROID)
+#else
+#define MY_LAYER_DEVICE_COMMANDS_ANDROID(X)
+#endif
@@ -0,0 +1,223 @@
+// API 트레이스: mock ICD 에서 캡처한 파일을 디코더의 순회 (api_trace_reader.h) 로 다시 읽어서
+// 인코더가 쓴 인자 (핸들 배열, 출력 핸들, 구조체 sType / 부모, 값 배열) 와 프레임 구간을 확인합니다.
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "api_trace_reader.h"
+#include "test_util.h"
+#include "utils.h"
+
+namespace {
+
+std::string g_trace_dir;
+
+std::string trace_path() {
+    return g_trace_dir + "/trace_" + to_file_name_part(get_app_package_name()) + "_" + std::to_string(getpid()) +
+           ".bin";
+}
+
+// 프레임 구간이 끝나면 flush 스레드가 파일을 마무리합니다. 그때까지 기다립니다. (최대 2 초)
+bool wait_for_complete(const std::string& path) {
+    for (int i = 0; i < 200; ++i) {
+        TraceFile trace;
+        if (open_trace(path.c_str(), &trace)) {
+            bool complete = trace.header->flags.load(std::memory_order_acquire) & kApiTraceComplete;
+            close_trace(&trace);
+            if (complete) return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+struct Arg {
+    ApiTraceArgKind kind;
+    std::vector<uint64_t> words;  // 인자의 word 들 (배열은 개수 포함)
+};
+
+struct Event {
+    std::string command;
+    uint32_t frame;
+    uint8_t result_kind;
+    uint64_t result;
+    std::vector<Arg> args;
+};
+
+std::vector<Event> read_events(TraceFile* trace) {
+    std::vector<Event> events;
+    for_each_event(trace, [&](const EventRef& ref) {
+        Event event;
+        event.command = ref.event->command < trace->commands.size() ? trace->commands[ref.event->command] : "?";
+        event.frame = ref.event->frame;
+        event.result_kind = ref.event->result_kind;
+        event.result = ref.event->result;
+        for_each_arg(ref.event, [&](uint32_t, ApiTraceArgKind kind, const uint64_t* arg) {
+            event.args.push_back({kind, std::vector<uint64_t>(arg, arg + api_trace_arg_words(kind, arg))});
+        });
+        events.push_back(std::move(event));
+    });
+    return events;
+}
+
+const Event* find_event(const std::vector<Event>& events, const char* command) {
+    for (const Event& event : events) {
+        if (event.command == command) return &event;
+    }
+    return nullptr;
+}
+
+size_t count_events(const std::vector<Event>& events, const char* command) {
+    size_t count = 0;
+    for (const Event& event : events) count += event.command == command;
+    return count;
+}
+
+uint64_t bits(const void* handle) {
+    return (uint64_t)(uintptr_t)handle;
+}
+
+// 프레임 0 과 3 의 호출은 구간 [1, 3) 밖이므로 기록되지 않습니다.
+void test_roundtrip() {
+    TestDevice device;
+    if (!device.create()) {
+        TEST_CHECK(false);
+        return;
+    }
+    auto present = [&] {
+        VkPresentInfoKHR present_info = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR};
+        device.get<PFN_vkQueuePresentKHR>("vkQueuePresentKHR")(device.queue, &present_info);
+    };
+
+    // 프레임 0
+    VkCommandPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    VkCommandPool pool = VK_NULL_HANDLE;
+    device.get<PFN_vkCreateCommandPool>("vkCreateCommandPool")(device.device, &pool_info, nullptr, &pool);
+    present();
+
+    // 프레임 1
+    VkCommandBufferAllocateInfo allocate_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+    allocate_info.commandPool = pool;
+    allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocate_info.commandBufferCount = 3;
+    VkCommandBuffer command_buffers[3] = {};
+    TEST_CHECK_EQ(device.get<PFN_vkAllocateCommandBuffers>("vkAllocateCommandBuffers")(
+        device.device, &allocate_info, command_buffers), VK_SUCCESS);
+    VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    device.get<PFN_vkBeginCommandBuffer>("vkBeginCommandBuffer")(command_buffers[0], &begin_info);
+    VkBuffer buffers[2] = {reinterpret_cast<VkBuffer>(0x1000), reinterpret_cast<VkBuffer>(0x2000)};
+    VkDeviceSize offsets[2] = {16, 32};
+    device.get<PFN_vkCmdBindVertexBuffers>("vkCmdBindVertexBuffers")(command_buffers[0], 0, 2, buffers, offsets);
+    device.get<PFN_vkEndCommandBuffer>("vkEndCommandBuffer")(command_buffers[0]);
+    present();
+
+    // 프레임 2
+    device.get<PFN_vkFreeCommandBuffers>("vkFreeCommandBuffers")(device.device, pool, 3, command_buffers);
+    present();
+
+    // 프레임 3
+    device.get<PFN_vkDestroyCommandPool>("vkDestroyCommandPool")(device.device, pool, nullptr);
+
+    std::string path = trace_path();
+    TEST_CHECK(wait_for_complete(path));
+    device.destroy();
+
+    TraceFile trace;
+    if (!open_trace(path.c_str(), &trace)) {
+        TEST_CHECK(false);
+        return;
+    }
+    TEST_CHECK_EQ(trace.header->first_frame, 1u);
+    TEST_CHECK_EQ(trace.header->last_frame, 3u);
+    TEST_CHECK_EQ(trace.header->dropped_events.load(), 0u);
+    std::vector<Event> events = read_events(&trace);
+    TEST_CHECK_EQ(trace.commands.size(), trace.header->command_count);
+
+    for (const Event& event : events) TEST_CHECK(event.frame >= 1 && event.frame < 3);
+    TEST_CHECK_EQ(count_events(events, "vkCreateCommandPool"), 0u);
+    TEST_CHECK_EQ(count_events(events, "vkDestroyCommandPool"), 0u);
+    TEST_CHECK_EQ(count_events(events, "vkQueuePresentKHR"), 2u);
+
+    // (device, 생성 정보 {sType, 부모 pool}, 출력 핸들 3 개)
+    const Event* allocate = find_event(events, "vkAllocateCommandBuffers");
+    TEST_CHECK(allocate != nullptr);
+    if (allocate && allocate->args.size() == 3) {
+        TEST_CHECK_EQ(allocate->frame, 1u);
+        TEST_CHECK_EQ(allocate->result_kind, (uint8_t)ApiTraceResultKind::Int);
+        TEST_CHECK_EQ(allocate->result, (uint64_t)VK_SUCCESS);
+        TEST_CHECK(allocate->args[0].kind == ApiTraceArgKind::Handle);
+        TEST_CHECK_EQ(allocate->args[0].words[0], bits(device.device));
+        TEST_CHECK(allocate->args[1].kind == ApiTraceArgKind::Struct);
+        TEST_CHECK_EQ(allocate->args[1].words[0], (uint64_t)VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO);
+        TEST_CHECK_EQ(allocate->args[1].words[1], (uint64_t)pool);
+        TEST_CHECK(allocate->args[2].kind == ApiTraceArgKind::OutHandleArray);
+        TEST_CHECK(allocate->args[2].words == (std::vector<uint64_t>{3, bits(command_buffers[0]),
+                                                                      bits(command_buffers[1]),
+                                                                      bits(command_buffers[2])}));
+    } else {
+        TEST_CHECK(false);
+    }
+
+    // (command buffer, firstBinding, bindingCount, 핸들 배열, 값 배열)
+    const Event* bind = find_event(events, "vkCmdBindVertexBuffers");
+    TEST_CHECK(bind != nullptr);
+    if (bind && bind->args.size() == 5) {
+        TEST_CHECK_EQ(bind->result_kind, (uint8_t)ApiTraceResultKind::Void);
+        TEST_CHECK_EQ(bind->args[0].words[0], bits(command_buffers[0]));
+        TEST_CHECK(bind->args[2].kind == ApiTraceArgKind::Uint);
+        TEST_CHECK_EQ(bind->args[2].words[0], 2u);
+        TEST_CHECK(bind->args[3].kind == ApiTraceArgKind::HandleArray);
+        TEST_CHECK(bind->args[3].words == (std::vector<uint64_t>{2, 0x1000, 0x2000}));
+        TEST_CHECK(bind->args[4].kind == ApiTraceArgKind::ValueArray);
+        TEST_CHECK(bind->args[4].words == (std::vector<uint64_t>{2, 16, 32}));
+    } else {
+        TEST_CHECK(false);
+    }
+
+    // (device, pool, 개수, 핸들 배열)
+    const Event* free_event = find_event(events, "vkFreeCommandBuffers");
+    TEST_CHECK(free_event != nullptr);
+    if (free_event && free_event->args.size() == 4) {
+        TEST_CHECK_EQ(free_event->frame, 2u);
+        TEST_CHECK_EQ(free_event->args[1].words[0], (uint64_t)pool);
+        TEST_CHECK(free_event->args[3].kind == ApiTraceArgKind::HandleArray);
+        TEST_CHECK(free_event->args[3].words == allocate->args[2].words);
+    } else {
+        TEST_CHECK(false);
+    }
+
+    const Event* first_present = find_event(events, "vkQueuePresentKHR");
+    if (first_present && first_present->args.size() == 2) {
+        TEST_CHECK_EQ(first_present->frame, 1u);
+        TEST_CHECK_EQ(first_present->args[0].words[0], bits(device.queue));
+        TEST_CHECK(first_present->args[1].kind == ApiTraceArgKind::Struct);
+        TEST_CHECK_EQ(first_present->args[1].words[0], (uint64_t)VK_STRUCTURE_TYPE_PRESENT_INFO_KHR);
+        TEST_CHECK_EQ(first_present->args[1].words[1], 0u);
+    } else {
+        TEST_CHECK(false);
+    }
+    close_trace(&trace);
+    unlink(path.c_str());
+}
+
+}  // namespace
+
+int main() {
+    char dir_template[] = "/tmp/mylayer_trace_XXXXXX";
+    if (!mkdtemp(dir_template)) return EXIT_FAILURE;
+    g_trace_dir = dir_template;
+    setenv("DEBUG_MY_LAYER_PIPELINE_CACHE", "0", 1);
+    setenv("DEBUG_MY_LAYER_TRACE", "1", 1);
+    setenv("DEBUG_MY_LAYER_TRACE_DIR", g_trace_dir.c_str(), 1);
+    setenv("DEBUG_MY_LAYER_TRACE_FRAMES", "1-3", 1);
+
+    TEST_RUN(test_roundtrip);
+
+    rmdir(g_trace_dir.c_str());
+    return test_exit_code();
+}
@@ -0,0 +1,60 @@
+// cmd_stats 와 상태 필터가 모두 꺼져 있으면 기록 경로에 레이어가 끼지 않아야 합니다.
+
+#include <cstdlib>
+
+#include "layer_data.h"
+#include "test_util.h"
+
+static TestDevice g_device;
+
+static bool is_next_chain(const char* name) {
+    return g_device.loader.layer_get_device_proc_addr(g_device.device, name) ==
+           mock_icd_get_device_proc_addr(g_device.device, name);
+}
+
+static void test_record_hooks_not_returned() {
+    TEST_CHECK(is_next_chain("vkAllocateCommandBuffers"));
+    TEST_CHECK(is_next_chain("vkBeginCommandBuffer"));
+    TEST_CHECK(is_next_chain("vkEndCommandBuffer"));
+    TEST_CHECK(is_next_chain("vkCmdDraw"));
+    TEST_CHECK(is_next_chain("vkCmdBindPipeline"));
+    TEST_CHECK(is_next_chain("vkCmdSetViewport"));
+    TEST_CHECK(is_next_chain("vkCmdBeginRenderPass"));
+    // 커맨드 버퍼와 관계없는 훅은 그대로입니다.
+    TEST_CHECK(!is_next_chain("vkQueueSubmit"));
+    TEST_CHECK(!is_next_chain("vkQueuePresentKHR"));
+}
+
+// 훅을 거치지 않고 할당한 커맨드 버퍼는 추적하지 않습니다.
+static void test_command_buffers_not_tracked() {
+    VkCommandPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    VkCommandPool pool = VK_NULL_HANDLE;
+    g_device.get<PFN_vkCreateCommandPool>("vkCreateCommandPool")(g_device.device, &pool_info, nullptr, &pool);
+
+    VkCommandBufferAllocateInfo allocate_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+    allocate_info.commandPool = pool;
+    allocate_info.commandBufferCount = 1;
+    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+    g_device.get<PFN_vkAllocateCommandBuffers>("vkAllocateCommandBuffers")(g_device.device, &allocate_info,
+                                                                           &command_buffer);
+    TEST_CHECK(g_command_buffer_data_map.find(command_buffer) == nullptr);
+
+    g_device.get<PFN_vkFreeCommandBuffers>("vkFreeCommandBuffers")(g_device.device, pool, 1, &command_buffer);
+    g_device.get<PFN_vkDestroyCommandPool>("vkDestroyCommandPool")(g_device.device, pool, nullptr);
+}
+
+int main() {
+    setenv("DEBUG_MY_LAYER_PIPELINE_CACHE", "0", 1);
+    setenv("DEBUG_MY_LAYER_CMD_STATS", "0", 1);
+    setenv("DEBUG_MY_LAYER_STATE_FILTER", "0", 1);
+    if (!g_device.create()) {
+        fprintf(stderr, "failed to set up the layer on the mock ICD\n");
+        return EXIT_FAILURE;
+    }
+
+    TEST_RUN(test_record_hooks_not_returned);
+    TEST_RUN(test_command_buffers_not_tracked);
+
+    g_device.destroy();
+    return test_exit_code();
+}
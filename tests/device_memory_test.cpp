@@ -0,0 +1,354 @@
+// 디바이스 메모리 suballocation (debug.my_layer.memory=2): 어떤 디바이스에서 켜지는지, 앱 핸들이 드라이버에
+// 어떻게 번역되어 넘어가는지.
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "device_memory.h"
+#include "layer_data.h"
+#include "test_util.h"
+
+namespace {
+
+constexpr uint32_t kHostVisibleType = 1;  // mock ICD: device local + host visible + coherent
+constexpr VkDeviceSize kMaxSuballocation = 8 << 20;  // 블록 (16 MiB) 의 절반
+
+VkDeviceMemory allocate(const TestDevice& device, VkDeviceSize size, uint32_t type = kHostVisibleType) {
+    VkMemoryAllocateInfo allocate_info = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+    allocate_info.allocationSize = size;
+    allocate_info.memoryTypeIndex = type;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkResult result = device.get<PFN_vkAllocateMemory>("vkAllocateMemory")(device.device, &allocate_info, nullptr,
+                                                                           &memory);
+    TEST_CHECK_EQ(result, VK_SUCCESS);
+    return memory;
+}
+
+void free_memory(const TestDevice& device, VkDeviceMemory memory) {
+    device.get<PFN_vkFreeMemory>("vkFreeMemory")(device.device, memory, nullptr);
+}
+
+bool is_suballocated(const TestDevice& device, VkDeviceMemory memory) {
+    const DeviceMemoryTracker* tracker = get_device_data(device.device)->memory.get();
+    return tracker && tracker->find(memory) != nullptr;
+}
+
+// create_info 로 디바이스를 만들고 작은 할당 하나가 suballocation 되는지 돌려줍니다.
+bool suballocates_with(const VkDeviceCreateInfo& create_info) {
+    TestDevice device;
+    if (!device.create(&create_info)) {
+        TEST_CHECK(false);
+        return false;
+    }
+    VkDeviceMemory memory = allocate(device, 4096);
+    bool suballocated = is_suballocated(device, memory);
+    free_memory(device, memory);
+    device.destroy();
+    return suballocated;
+}
+
+// 켜진 확장이 모두 허용 목록에 있고 번역하지 않는 코어 기능이 꺼져 있을 때만 suballocation 합니다.
+void test_extension_allowlist() {
+    float priority = 1.0f;
+    VkDeviceQueueCreateInfo queue_info = {VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
+    queue_info.queueCount = 1;
+    queue_info.pQueuePriorities = &priority;
+    VkDeviceCreateInfo create_info = {VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
+    create_info.queueCreateInfoCount = 1;
+    create_info.pQueueCreateInfos = &queue_info;
+
+    TEST_CHECK(suballocates_with(create_info));
+
+    const char* known[] = {"VK_KHR_swapchain", "VK_KHR_bind_memory2", "VK_ANDROID_external_memory_android_hardware_buffer"};
+    create_info.enabledExtensionCount = 3;
+    create_info.ppEnabledExtensionNames = known;
+    TEST_CHECK(suballocates_with(create_info));
+
+    // vkBindVideoSessionMemoryKHR / vkBindAccelerationStructureMemoryNV 등은 레이어가 번역하지 않습니다.
+    for (const char* unknown : {"VK_KHR_video_queue", "VK_NV_ray_tracing", "VK_EXT_pageable_device_local_memory",
+                                "VK_EXT_map_memory_placed", "VK_VENDOR_made_up_extension"}) {
+        const char* names[] = {"VK_KHR_swapchain", unknown};
+        create_info.enabledExtensionCount = 2;
+        create_info.ppEnabledExtensionNames = names;
+        TEST_CHECK(!suballocates_with(create_info));
+    }
+    create_info.enabledExtensionCount = 0;
+    create_info.ppEnabledExtensionNames = nullptr;
+
+    VkPhysicalDeviceFeatures features = {};
+    features.sparseBinding = VK_TRUE;
+    create_info.pEnabledFeatures = &features;
+    TEST_CHECK(!suballocates_with(create_info));
+    create_info.pEnabledFeatures = nullptr;
+
+    VkPhysicalDeviceVulkan13Features features13 = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES};
+    features13.privateData = VK_TRUE;
+    create_info.pNext = &features13;
+    TEST_CHECK(!suballocates_with(create_info));
+    features13.privateData = VK_FALSE;
+    TEST_CHECK(suballocates_with(create_info));
+}
+
+// 노드 (4 KiB) 보다 alignment 가 큰 이미지는 맞는 노드로 옮겨서 bind 하고, 이후 그 타입은 큰 노드로 잡습니다.
+// map 한 뒤에는 옮길 수 없으므로 어긋나면 드라이버를 부르지 않고 실패합니다.
+void test_bind_alignment() {
+    constexpr VkDeviceSize kAlignment = 64 << 10;
+    mock_icd_set_image_memory_requirements({4096, kAlignment, 0x3});
+    TestDevice device;
+    if (!device.create()) {
+        TEST_CHECK(false);
+        return;
+    }
+    auto bind_image = device.get<PFN_vkBindImageMemory>("vkBindImageMemory");
+    auto map_memory = device.get<PFN_vkMapMemory>("vkMapMemory");
+    const VkImage image = (VkImage)(uintptr_t)0x100;
+
+    // 블록 맨 앞 (offset 0) 은 어떤 alignment 에도 맞으므로 먼저 채워 둡니다.
+    VkDeviceMemory first = allocate(device, 4096);
+    VkDeviceMemory mapped = allocate(device, 4096);
+    VkDeviceMemory moved = allocate(device, 4096);
+    TEST_CHECK(is_suballocated(device, moved));
+
+    void* data = nullptr;
+    TEST_CHECK_EQ(map_memory(device.device, mapped, 0, VK_WHOLE_SIZE, 0, &data), VK_SUCCESS);
+    MockMemoryCall before = mock_icd_last_memory_call();
+    TEST_CHECK_EQ(bind_image(device.device, image, mapped, 0), VK_ERROR_OUT_OF_DEVICE_MEMORY);
+    TEST_CHECK_EQ(mock_icd_last_memory_call().offset, before.offset);
+
+    TEST_CHECK_EQ(bind_image(device.device, image, moved, 0), VK_SUCCESS);
+    TEST_CHECK_EQ(mock_icd_last_memory_call().offset % kAlignment, 0u);
+    TEST_CHECK_EQ(get_device_data(device.device)->memory->find(moved)->node_size, kAlignment);
+
+    // 이후 할당은 처음부터 alignment 크기 노드라 옮기지 않습니다.
+    VkDeviceMemory later = allocate(device, 4096);
+    TEST_CHECK_EQ(get_device_data(device.device)->memory->find(later)->node_size, kAlignment);
+    TEST_CHECK_EQ(bind_image(device.device, image, later, 0), VK_SUCCESS);
+    TEST_CHECK_EQ(mock_icd_last_memory_call().offset % kAlignment, 0u);
+
+    for (VkDeviceMemory memory : {first, mapped, moved, later}) free_memory(device, memory);
+    device.destroy();
+    mock_icd_set_image_memory_requirements({64 * 1024, 4096, 0x1});
+}
+
+// vkBindImageMemory2 는 모두 맞출 수 있을 때만 노드를 옮깁니다. 하나가 실패하면 앞에서 옮길 수 있었던
+// 것도 그대로 두므로 (bound 로 표시하지 않음) 나중에 다시 bind 할 수 있습니다.
+void test_bind2_all_or_nothing() {
+    constexpr VkDeviceSize kAlignment = 64 << 10;
+    mock_icd_set_image_memory_requirements({4096, kAlignment, 0x3});
+    TestDevice device;
+    if (!device.create()) {
+        TEST_CHECK(false);
+        return;
+    }
+    const DeviceMemoryTracker* tracker = get_device_data(device.device)->memory.get();
+    auto bind_image2 = device.get<PFN_vkBindImageMemory2>("vkBindImageMemory2");
+    const VkImage image = (VkImage)(uintptr_t)0x100;
+
+    VkDeviceMemory first = allocate(device, 4096);
+    VkDeviceMemory mapped = allocate(device, 4096);
+    VkDeviceMemory movable = allocate(device, 4096);
+    void* data = nullptr;
+    TEST_CHECK_EQ(device.get<PFN_vkMapMemory>("vkMapMemory")(device.device, mapped, 0, VK_WHOLE_SIZE, 0, &data),
+                  VK_SUCCESS);
+    const DeviceMemoryTracker::SubAllocation* sub = tracker->find(movable);
+    if (!sub) {
+        TEST_CHECK(false);
+        return;
+    }
+    VkDeviceSize offset_before = sub->offset;
+
+    VkBindImageMemoryInfo infos[2] = {{VK_STRUCTURE_TYPE_BIND_IMAGE_MEMORY_INFO},
+                                      {VK_STRUCTURE_TYPE_BIND_IMAGE_MEMORY_INFO}};
+    infos[0].image = image;
+    infos[0].memory = movable;
+    infos[1].image = image;
+    infos[1].memory = mapped;
+    TEST_CHECK_EQ(icd_calls([&] {
+        TEST_CHECK_EQ(bind_image2(device.device, 2, infos), VK_ERROR_OUT_OF_DEVICE_MEMORY);
+    }), 2u);  // vkGetImageMemoryRequirements 두 번, bind 는 없음
+    TEST_CHECK(!sub->bound);
+    TEST_CHECK_EQ(sub->offset, offset_before);
+
+    TEST_CHECK_EQ(bind_image2(device.device, 1, infos), VK_SUCCESS);
+    TEST_CHECK(sub->bound);
+    TEST_CHECK_EQ(mock_icd_last_memory_call().offset % kAlignment, 0u);
+
+    for (VkDeviceMemory memory : {first, mapped, movable}) free_memory(device, memory);
+    device.destroy();
+    mock_icd_set_image_memory_requirements({64 * 1024, 4096, 0x1});
+}
+
+// vkMapMemory 주소 - offset 은 minMemoryMapAlignment 의 배수여야 하므로 host visible 타입의 노드는 그보다
+// 작지 않습니다. device local 전용 타입은 작은 노드를 그대로 씁니다.
+void test_map_alignment() {
+    constexpr size_t kMapAlignment = 4096;
+    mock_icd_set_min_memory_map_alignment(kMapAlignment);
+    TestDevice device;
+    if (!device.create()) {
+        TEST_CHECK(false);
+        return;
+    }
+    const DeviceMemoryTracker* tracker = get_device_data(device.device)->memory.get();
+    auto map_memory = device.get<PFN_vkMapMemory>("vkMapMemory");
+    VkDeviceMemory small[3];
+    for (VkDeviceMemory& memory : small) memory = allocate(device, 256);
+    for (size_t i = 0; i < 3; ++i) {
+        const DeviceMemoryTracker::SubAllocation* sub = tracker->find(small[i]);
+        TEST_CHECK(sub && sub->node_size >= kMapAlignment);
+        void* data = nullptr;
+        VkDeviceSize offset = i * 64;
+        TEST_CHECK_EQ(map_memory(device.device, small[i], offset, VK_WHOLE_SIZE, 0, &data), VK_SUCCESS);
+        TEST_CHECK_EQ(((uintptr_t)data - offset) % kMapAlignment, 0u);
+    }
+
+    VkDeviceMemory device_local = allocate(device, 256, 0);
+    const DeviceMemoryTracker::SubAllocation* sub = tracker->find(device_local);
+    TEST_CHECK(sub && sub->node_size == 256);
+
+    for (VkDeviceMemory memory : small) free_memory(device, memory);
+    free_memory(device, device_local);
+    device.destroy();
+    mock_icd_set_min_memory_map_alignment(64);
+}
+
+// 무작위 크기로 할당 / 해제를 반복해도 노드가 겹치지 않고 자기 크기로 정렬되며, 모두 해제하면 블록이
+// 하나만 남습니다. (타입마다 빈 블록 하나는 남겨 둡니다)
+void test_allocate_free() {
+    TestDevice device;
+    if (!device.create()) {
+        TEST_CHECK(false);
+        return;
+    }
+    const DeviceMemoryTracker* tracker = get_device_data(device.device)->memory.get();
+    uint64_t baseline = mock_icd_live_memory_count();
+
+    std::mt19937 random(7);
+    std::vector<VkDeviceMemory> live;
+    uint64_t peak = baseline;
+    for (int i = 0; i < 4000; ++i) {
+        if (live.size() < 200 && (live.empty() || random() % 3 != 0)) {
+            live.push_back(allocate(device, 1 + random() % (256 << 10)));
+        } else {
+            size_t index = random() % live.size();
+            free_memory(device, live[index]);
+            live[index] = live.back();
+            live.pop_back();
+        }
+        peak = std::max(peak, mock_icd_live_memory_count());
+    }
+    TEST_CHECK(peak > baseline + 1);  // 블록 여러 개를 썼어야 합니다.
+
+    std::vector<const DeviceMemoryTracker::SubAllocation*> subs;
+    for (VkDeviceMemory memory : live) {
+        const DeviceMemoryTracker::SubAllocation* sub = tracker->find(memory);
+        TEST_CHECK(sub != nullptr);
+        if (!sub) continue;
+        TEST_CHECK(sub->node_size >= sub->size);
+        TEST_CHECK_EQ(sub->offset % sub->node_size, 0u);
+        subs.push_back(sub);
+    }
+    std::sort(subs.begin(), subs.end(), [](const auto* a, const auto* b) {
+        return a->memory != b->memory ? a->memory < b->memory : a->offset < b->offset;
+    });
+    for (size_t i = 1; i < subs.size(); ++i) {
+        if (subs[i]->memory == subs[i - 1]->memory) TEST_CHECK(subs[i - 1]->offset + subs[i - 1]->node_size <= subs[i]->offset);
+    }
+
+    for (VkDeviceMemory memory : live) free_memory(device, memory);
+    TEST_CHECK_EQ(mock_icd_live_memory_count(), baseline + 1);
+
+    // 빈 노드가 모두 다시 합쳐져야 블록 절반 크기 (suballoc_max_kb) 의 할당이 남은 블록에 들어갑니다.
+    VkDeviceMemory half = allocate(device, kMaxSuballocation);
+    TEST_CHECK(is_suballocated(device, half));
+    TEST_CHECK_EQ(mock_icd_live_memory_count(), baseline + 1);
+    free_memory(device, half);
+    device.destroy();
+}
+
+// map 은 블록 map 주소 + 노드 offset + 앱 offset, flush / invalidate / bind 는 (블록, 노드 offset + 앱 offset)
+// 으로 넘어갑니다. VK_WHOLE_SIZE 는 노드 끝까지로 바뀝니다.
+void test_translation() {
+    TestDevice device;
+    if (!device.create()) {
+        TEST_CHECK(false);
+        return;
+    }
+    const DeviceMemoryTracker* tracker = get_device_data(device.device)->memory.get();
+    VkDeviceMemory first = allocate(device, 4096);
+    VkDeviceMemory second = allocate(device, 1000);
+    VkDeviceMemory direct = allocate(device, kMaxSuballocation + 1);
+    const DeviceMemoryTracker::SubAllocation* a = tracker->find(first);
+    const DeviceMemoryTracker::SubAllocation* b = tracker->find(second);
+    TEST_CHECK(a && b && !is_suballocated(device, direct));
+    if (!a || !b) return;
+    TEST_CHECK(a->memory == b->memory);
+    TEST_CHECK(a->offset != b->offset);
+
+    auto map_memory = device.get<PFN_vkMapMemory>("vkMapMemory");
+    void* data_a = nullptr;
+    void* data_b = nullptr;
+    TEST_CHECK_EQ(map_memory(device.device, first, 0, VK_WHOLE_SIZE, 0, &data_a), VK_SUCCESS);
+    TEST_CHECK_EQ(map_memory(device.device, second, 128, 256, 0, &data_b), VK_SUCCESS);
+    TEST_CHECK_EQ((intptr_t)((uint8_t*)data_b - (uint8_t*)data_a), (intptr_t)(b->offset + 128) - (intptr_t)a->offset);
+
+    VkMappedMemoryRange ranges[2] = {{VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE}, {VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE}};
+    ranges[0].memory = direct;
+    ranges[0].size = VK_WHOLE_SIZE;
+    ranges[1].memory = second;
+    ranges[1].offset = 64;
+    ranges[1].size = VK_WHOLE_SIZE;
+    device.get<PFN_vkFlushMappedMemoryRanges>("vkFlushMappedMemoryRanges")(device.device, 2, ranges);
+    MockMemoryCall call = mock_icd_last_memory_call();
+    TEST_CHECK(call.memory == b->memory);
+    TEST_CHECK_EQ(call.offset, b->offset + 64);
+    TEST_CHECK_EQ(call.size, b->node_size - 64);
+    TEST_CHECK(ranges[1].memory == second);  // 앱의 구조체는 그대로입니다.
+
+    ranges[1].size = 128;
+    device.get<PFN_vkInvalidateMappedMemoryRanges>("vkInvalidateMappedMemoryRanges")(device.device, 2, ranges);
+    call = mock_icd_last_memory_call();
+    TEST_CHECK(call.memory == b->memory);
+    TEST_CHECK_EQ(call.offset, b->offset + 64);
+    TEST_CHECK_EQ(call.size, 128u);
+
+    // 버퍼 alignment 는 256 입니다.
+    const VkBuffer buffer = (VkBuffer)(uintptr_t)0x200;
+    device.get<PFN_vkBindBufferMemory>("vkBindBufferMemory")(device.device, buffer, first, 256);
+    call = mock_icd_last_memory_call();
+    TEST_CHECK(call.memory == a->memory);
+    TEST_CHECK_EQ(call.offset, a->offset + 256);
+
+    VkBindBufferMemoryInfo bind_infos[2] = {{VK_STRUCTURE_TYPE_BIND_BUFFER_MEMORY_INFO},
+                                            {VK_STRUCTURE_TYPE_BIND_BUFFER_MEMORY_INFO}};
+    bind_infos[0].buffer = buffer;
+    bind_infos[0].memory = direct;
+    bind_infos[1].buffer = buffer;
+    bind_infos[1].memory = second;
+    bind_infos[1].memoryOffset = 512;
+    TEST_CHECK_EQ(device.get<PFN_vkBindBufferMemory2>("vkBindBufferMemory2")(device.device, 2, bind_infos), VK_SUCCESS);
+    call = mock_icd_last_memory_call();
+    TEST_CHECK(call.memory == b->memory);
+    TEST_CHECK_EQ(call.offset, b->offset + 512);
+    TEST_CHECK(bind_infos[1].memory == second);
+
+    for (VkDeviceMemory memory : {first, second, direct}) free_memory(device, memory);
+    device.destroy();
+}
+
+}  // namespace
+
+int main() {
+    setenv("DEBUG_MY_LAYER_PIPELINE_CACHE", "0", 1);
+    setenv("DEBUG_MY_LAYER_MEMORY", "2", 1);
+    setenv("DEBUG_MY_LAYER_SUBALLOC_MAX_KB", "8192", 1);
+
+    TEST_RUN(test_extension_allowlist);
+    TEST_RUN(test_allocate_free);
+    TEST_RUN(test_translation);
+    TEST_RUN(test_bind_alignment);
+    TEST_RUN(test_bind2_all_or_nothing);
+    TEST_RUN(test_map_alignment);
+    return test_exit_code();
+}
@@ -0,0 +1,121 @@
+// 프레임 페이싱의 deadline / resync / 작업 시간 평균 계산. 시각을 직접 넣으므로 실제로 기다리지 않습니다.
+
+#include "frame_pacer.h"
+#include "test_util.h"
+
+namespace {
+
+constexpr uint64_t kInterval = 10000000;  // 10 ms (100 fps)
+constexpr uint64_t kStart = 1000000000;
+
+FramePacerConfig config_for_mode(bool low_latency) {
+    FramePacerConfig config;
+    config.interval_ns = kInterval;
+    config.low_latency = low_latency;
+    return config;
+}
+
+uint64_t recorded_errors(const QueuePacer& pacer) {
+    Histogram::Snapshot snapshot;
+    pacer.error_ns.snapshot(&snapshot);
+    return snapshot.total;
+}
+
+// 한 간격 안의 지연은 다음 deadline 을 원래 간격대로 두고 (따라잡기), 한 간격을 넘는 지연은 지금부터
+// 다시 셉니다.
+void test_resync_after_stall() {
+    QueuePacer pacer;
+    frame_pacer_on_present(pacer, kInterval, kStart);
+    TEST_CHECK_EQ(pacer.deadline_ns, kStart + kInterval);
+    TEST_CHECK_EQ(recorded_errors(pacer), 0u);  // 첫 프레임은 비교할 deadline 이 없습니다
+
+    frame_pacer_on_present(pacer, kInterval, kStart + kInterval + kInterval / 2);
+    TEST_CHECK_EQ(pacer.deadline_ns, kStart + 2 * kInterval);
+
+    uint64_t stalled_ns = pacer.deadline_ns + kInterval + 1;
+    frame_pacer_on_present(pacer, kInterval, stalled_ns);
+    TEST_CHECK_EQ(pacer.deadline_ns, stalled_ns + kInterval);
+    TEST_CHECK_EQ(recorded_errors(pacer), 2u);
+
+    // 딱 한 간격 늦은 것은 아직 따라잡습니다.
+    uint64_t deadline_ns = pacer.deadline_ns;
+    frame_pacer_on_present(pacer, kInterval, deadline_ns + kInterval);
+    TEST_CHECK_EQ(pacer.deadline_ns, deadline_ns + kInterval);
+}
+
+// 멈춘 동안의 작업 시간은 평균에 넣지 않습니다.
+void test_stall_skips_work_average() {
+    FramePacerConfig config = config_for_mode(true);
+    QueuePacer pacer;
+    frame_pacer_on_present(pacer, kInterval, kStart);
+    pacer.resume_ns = kStart;
+    frame_pacer_before_wake_ns(pacer, config, kInterval, kStart + 4000000);
+    TEST_CHECK_EQ(pacer.work_average_ns, 4000000u);
+
+    frame_pacer_on_present(pacer, kInterval, kStart + 4000000);
+    pacer.resume_ns = kStart + 4000000;
+    frame_pacer_before_wake_ns(pacer, config, kInterval, pacer.deadline_ns + kInterval + 1);
+    TEST_CHECK_EQ(pacer.work_average_ns, 4000000u);
+}
+
+// 모드 0 은 present 전에 deadline 까지, 모드 1 은 present 후에 deadline - 예측 작업 시간까지 기다립니다.
+void test_wake_times_by_mode() {
+    for (bool low_latency : {false, true}) {
+        FramePacerConfig config = config_for_mode(low_latency);
+        QueuePacer pacer;
+        // 첫 present 에는 deadline 이 없어서 기다리지 않습니다.
+        TEST_CHECK_EQ(frame_pacer_before_wake_ns(pacer, config, kInterval, kStart), 0u);
+        frame_pacer_on_present(pacer, kInterval, kStart);
+        pacer.resume_ns = kStart + 1000000;
+
+        // present 에서 돌아간 뒤 4 ms 만에 다음 present
+        uint64_t now_ns = pacer.resume_ns + 4000000;
+        uint64_t before_ns = frame_pacer_before_wake_ns(pacer, config, kInterval, now_ns);
+        TEST_CHECK_EQ(pacer.work_average_ns, 4000000u);
+        if (low_latency) {
+            TEST_CHECK_EQ(before_ns, 0u);
+            frame_pacer_on_present(pacer, kInterval, now_ns);
+            TEST_CHECK_EQ(frame_pacer_after_wake_ns(pacer, config), kStart + 2 * kInterval - 4500000);
+        } else {
+            TEST_CHECK_EQ(before_ns, kStart + kInterval);
+            frame_pacer_on_present(pacer, kInterval, before_ns);
+            TEST_CHECK_EQ(frame_pacer_after_wake_ns(pacer, config), 0u);
+        }
+        TEST_CHECK_EQ(pacer.deadline_ns, kStart + 2 * kInterval);
+    }
+
+    // 예측 작업 시간이 deadline 보다 길면 기다리지 않습니다.
+    FramePacerConfig config = config_for_mode(true);
+    QueuePacer pacer;
+    pacer.deadline_ns = 1000;
+    pacer.work_average_ns = 2000;
+    TEST_CHECK_EQ(frame_pacer_after_wake_ns(pacer, config), 0u);
+}
+
+// deadline 보다 간격의 10% 넘게 늦은 present 만 늦은 프레임으로 셉니다. 이른 present 는 error 만 남깁니다.
+void test_late_count() {
+    QueuePacer pacer;
+    frame_pacer_on_present(pacer, kInterval, kStart);
+
+    frame_pacer_on_present(pacer, kInterval, pacer.deadline_ns);
+    frame_pacer_on_present(pacer, kInterval, pacer.deadline_ns - kInterval / 2);
+    frame_pacer_on_present(pacer, kInterval, pacer.deadline_ns + kInterval / 10);
+    TEST_CHECK_EQ(pacer.late_count.load(), 0u);
+
+    frame_pacer_on_present(pacer, kInterval, pacer.deadline_ns + kInterval / 10 + 1);
+    TEST_CHECK_EQ(pacer.late_count.load(), 1u);
+    frame_pacer_on_present(pacer, kInterval, pacer.deadline_ns + 3 * kInterval);
+    TEST_CHECK_EQ(pacer.late_count.load(), 2u);
+    TEST_CHECK_EQ(recorded_errors(pacer), 5u);
+}
+
+}  // namespace
+
+int main() {
+    TEST_RUN(test_resync_after_stall);
+    TEST_RUN(test_stall_skips_work_average);
+    TEST_RUN(test_wake_times_by_mode);
+    TEST_RUN(test_late_count);
+
+    return test_exit_code();
+}
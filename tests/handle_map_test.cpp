@@ -0,0 +1,86 @@
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "handle_map.h"
+#include "test_util.h"
+
+namespace {
+
+// 정렬된 포인터처럼 보이는 키 (0, 1 은 empty / tombstone 이라 쓰지 않음)
+const void* key_of(uint64_t i) {
+    return reinterpret_cast<const void*>(uintptr_t((i + 1) * 64));
+}
+
+// 살아 있는 키 수가 일정하면 생성 / 파괴를 반복해도 보관 중인 테이블이 늘어나지 않아야 합니다.
+void test_churn_memory_bounded() {
+    constexpr uint64_t kLive = 16;
+    constexpr uint64_t kCycles = 1000000;
+
+    HandleMap<uint64_t> map;
+    for (uint64_t i = 0; i < kLive; ++i) map.insert(key_of(i), std::make_unique<uint64_t>(i));
+    size_t retained_after_warmup = 0;
+    for (uint64_t i = kLive; i < kLive + kCycles; ++i) {
+        map.insert(key_of(i), std::make_unique<uint64_t>(i));
+        TEST_CHECK(map.erase(key_of(i - kLive)) != nullptr);
+        if (i == kLive * 64) retained_after_warmup = map.retained_slot_count();
+    }
+
+    TEST_CHECK(retained_after_warmup != 0);
+    TEST_CHECK_EQ(map.retained_slot_count(), retained_after_warmup);
+    TEST_CHECK(map.retained_slot_count() <= 512);
+    for (uint64_t i = kCycles; i < kCycles + kLive; ++i) {
+        uint64_t* value = map.find(key_of(i));
+        TEST_CHECK(value != nullptr && *value == i);
+    }
+    TEST_CHECK(map.find(key_of(0)) == nullptr);
+}
+
+// 살아 있는 키 수가 늘면 테이블도 커지고, 모든 키를 찾을 수 있어야 합니다.
+void test_grow() {
+    HandleMap<uint64_t> map;
+    for (uint64_t i = 0; i < 10000; ++i) map.insert(key_of(i), std::make_unique<uint64_t>(i));
+    for (uint64_t i = 0; i < 10000; ++i) {
+        uint64_t* value = map.find(key_of(i));
+        TEST_CHECK(value != nullptr && *value == i);
+    }
+    // 현재 테이블은 키 수 * 8 미만이고 이전 테이블의 합은 그보다 작습니다.
+    TEST_CHECK(map.retained_slot_count() <= 10000 * 16);
+}
+
+// writer 가 churn 하는 동안 (tombstone purge / grow 포함) 다른 스레드가 살아 있는 키를 항상 찾아야 합니다.
+void test_concurrent_find() {
+    constexpr uint64_t kStable = 8;
+    HandleMap<uint64_t> map;
+    for (uint64_t i = 0; i < kStable; ++i) map.insert(key_of(i), std::make_unique<uint64_t>(i));
+
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> misses{0};
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+            for (uint64_t i = 0; i < kStable; ++i) {
+                uint64_t* value = map.find(key_of(i));
+                if (!value || *value != i) misses.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    constexpr uint64_t kFirstChurnKey = 1000;
+    for (uint64_t i = 0; i < 200000; ++i) {
+        map.insert(key_of(kFirstChurnKey + i), std::make_unique<uint64_t>(i));
+        if (i >= 24) map.erase(key_of(kFirstChurnKey + i - 24));
+    }
+    done.store(true, std::memory_order_relaxed);
+    reader.join();
+    TEST_CHECK_EQ(misses.load(), 0);
+}
+
+}  // namespace
+
+int main() {
+    TEST_RUN(test_churn_memory_bounded);
+    TEST_RUN(test_grow);
+    TEST_RUN(test_concurrent_find);
+    return test_exit_code();
+}
@@ -0,0 +1,90 @@
+// 레이어를 mock ICD 위에 올렸을 때의 기본 동작: ProcAddr 해석과 명령 전달.
+
+#include <cstdlib>
+
+#include "layer_data.h"
+#include "test_util.h"
+
+static TestDevice g_device;
+
+static void test_proc_addr() {
+    const MockLoader& loader = g_device.loader;
+    // instance 레벨 명령은 vkGetDeviceProcAddr 로 얻을 수 없습니다.
+    TEST_CHECK(loader.layer_get_device_proc_addr(g_device.device, "vkCreateDevice") == nullptr);
+    // 다음 체인이 지원하지 않는 명령은 훅이 있어도 nullptr 입니다.
+    TEST_CHECK(loader.layer_get_device_proc_addr(g_device.device, "vkCmdPushDescriptorSetWithTemplateKHR") == nullptr);
+    TEST_CHECK(loader.layer_get_device_proc_addr(g_device.device, "vkCmdDrawMeshTasksEXT") == nullptr);
+    // 훅하지 않는 명령은 다음 체인의 포인터를 그대로 돌려줍니다.
+    TEST_CHECK(loader.layer_get_device_proc_addr(g_device.device, "vkDestroyPipeline") ==
+               mock_icd_get_device_proc_addr(g_device.device, "vkDestroyPipeline"));
+    TEST_CHECK(loader.layer_get_device_proc_addr(g_device.device, "vkCmdDraw") != nullptr);
+}
+
+// 훅을 거친 명령은 mock ICD 를 정확히 한 번 부릅니다.
+static void test_forwarding() {
+    VkCommandPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    VkCommandPool pool = VK_NULL_HANDLE;
+    TEST_CHECK_EQ(icd_calls([&] {
+        g_device.get<PFN_vkCreateCommandPool>("vkCreateCommandPool")(g_device.device, &pool_info, nullptr, &pool);
+    }), 1u);
+
+    VkCommandBufferAllocateInfo allocate_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+    allocate_info.commandPool = pool;
+    allocate_info.commandBufferCount = 1;
+    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+    g_device.get<PFN_vkAllocateCommandBuffers>("vkAllocateCommandBuffers")(g_device.device, &allocate_info,
+                                                                           &command_buffer);
+
+    VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    TEST_CHECK_EQ(icd_calls([&] {
+        g_device.get<PFN_vkBeginCommandBuffer>("vkBeginCommandBuffer")(command_buffer, &begin_info);
+    }), 1u);
+    VkRenderingInfo rendering_info = {VK_STRUCTURE_TYPE_RENDERING_INFO};
+    TEST_CHECK_EQ(icd_calls([&] {
+        g_device.get<PFN_vkCmdBeginRendering>("vkCmdBeginRendering")(command_buffer, &rendering_info);
+        g_device.get<PFN_vkCmdBindPipeline>("vkCmdBindPipeline")(
+            command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, (VkPipeline)(uintptr_t)0x10);
+        g_device.get<PFN_vkCmdDraw>("vkCmdDraw")(command_buffer, 3, 1, 0, 0);
+        g_device.get<PFN_vkCmdEndRendering>("vkCmdEndRendering")(command_buffer);
+        g_device.get<PFN_vkCmdDispatch>("vkCmdDispatch")(command_buffer, 1, 1, 1);
+    }), 5u);
+    // cmd_stats (기본 켬) 는 커맨드 버퍼마다 셉니다.
+    LayerCommandBufferData* data = g_command_buffer_data_map.find(command_buffer);
+    TEST_CHECK(data != nullptr);
+    if (data) {
+        TEST_CHECK_EQ(data->stats.pipeline_binds, 1u);
+        TEST_CHECK_EQ(data->stats.draws, 1u);
+        TEST_CHECK_EQ(data->stats.dispatches, 1u);
+        TEST_CHECK_EQ(data->stats.render_passes, 1u);
+        TEST_CHECK_EQ(data->stats.render_pass_ends, 1u);
+    }
+    TEST_CHECK_EQ(icd_calls([&] {
+        g_device.get<PFN_vkEndCommandBuffer>("vkEndCommandBuffer")(command_buffer);
+    }), 1u);
+
+    VkSubmitInfo submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &command_buffer;
+    VkPresentInfoKHR present_info = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR};
+    TEST_CHECK_EQ(icd_calls([&] {
+        g_device.get<PFN_vkQueueSubmit>("vkQueueSubmit")(g_device.queue, 1, &submit_info, VK_NULL_HANDLE);
+        g_device.get<PFN_vkQueuePresentKHR>("vkQueuePresentKHR")(g_device.queue, &present_info);
+    }), 2u);
+
+    g_device.get<PFN_vkFreeCommandBuffers>("vkFreeCommandBuffers")(g_device.device, pool, 1, &command_buffer);
+    g_device.get<PFN_vkDestroyCommandPool>("vkDestroyCommandPool")(g_device.device, pool, nullptr);
+}
+
+int main() {
+    setenv("DEBUG_MY_LAYER_PIPELINE_CACHE", "0", 1);
+    if (!g_device.create()) {
+        fprintf(stderr, "failed to set up the layer on the mock ICD\n");
+        return EXIT_FAILURE;
+    }
+
+    TEST_RUN(test_proc_addr);
+    TEST_RUN(test_forwarding);
+
+    g_device.destroy();
+    return test_exit_code();
+}
@@ -0,0 +1,37 @@
+// debug.my_layer_package 가 비어 있으면 어떤 프로세스도 대상이 아니고, 레이어는 생성 / 파괴만 처리합니다.
+
+#include <cstdlib>
+
+#include "settings.h"
+#include "test_util.h"
+
+static TestDevice g_device;
+
+static bool is_next_chain(const char* name) {
+    return g_device.loader.layer_get_device_proc_addr(g_device.device, name) ==
+           mock_icd_get_device_proc_addr(g_device.device, name);
+}
+
+static void test_untargeted() {
+    TEST_CHECK(!layer_settings().targeted);
+    TEST_CHECK(is_next_chain("vkCmdDraw"));
+    TEST_CHECK(is_next_chain("vkQueuePresentKHR"));
+    TEST_CHECK(is_next_chain("vkCreateShaderModule"));
+    TEST_CHECK(is_next_chain("vkCreateGraphicsPipelines"));
+    TEST_CHECK(is_next_chain("vkAllocateMemory"));
+    // 디스패치 테이블을 관리해야 하므로 파괴는 레이어를 거칩니다.
+    TEST_CHECK(!is_next_chain("vkDestroyDevice"));
+}
+
+int main() {
+    setenv("DEBUG_MY_LAYER_PACKAGE", "", 1);
+    if (!g_device.create()) {
+        fprintf(stderr, "failed to set up the layer on the mock ICD\n");
+        return EXIT_FAILURE;
+    }
+
+    TEST_RUN(test_untargeted);
+
+    g_device.destroy();
+    return test_exit_code();
+}
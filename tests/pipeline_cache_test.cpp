@@ -0,0 +1,109 @@
+// 레이어 파이프라인 캐시: 앱 캐시 merge, vkDestroyDevice 의 마지막 저장과 다음 디바이스에서의 로드.
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+
+#include "test_util.h"
+
+namespace {
+
+std::string g_cache_dir;
+
+// module 을 쓰는 compute 파이프라인을 만들고 드라이버 캐시 hit 여부를 돌려줍니다.
+bool create_pipeline(const TestDevice& device, VkPipelineCache cache, uint64_t module) {
+    VkPipelineCreationFeedback feedback = {};
+    VkPipelineCreationFeedbackCreateInfo feedback_info = {VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO};
+    feedback_info.pPipelineCreationFeedback = &feedback;
+    VkComputePipelineCreateInfo create_info = {VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
+    create_info.pNext = &feedback_info;
+    create_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    create_info.stage.module = (VkShaderModule)(uintptr_t)module;
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkResult result = device.get<PFN_vkCreateComputePipelines>("vkCreateComputePipelines")(
+        device.device, cache, 1, &create_info, nullptr, &pipeline);
+    TEST_CHECK_EQ(result, VK_SUCCESS);
+    device.get<PFN_vkDestroyPipeline>("vkDestroyPipeline")(device.device, pipeline, nullptr);
+    return feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT;
+}
+
+VkPipelineCache create_app_cache(const TestDevice& device) {
+    VkPipelineCacheCreateInfo create_info = {VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+    VkPipelineCache cache = VK_NULL_HANDLE;
+    device.get<PFN_vkCreatePipelineCache>("vkCreatePipelineCache")(device.device, &create_info, nullptr, &cache);
+    return cache;
+}
+
+void destroy_app_cache(const TestDevice& device, VkPipelineCache cache) {
+    device.get<PFN_vkDestroyPipelineCache>("vkDestroyPipelineCache")(device.device, cache, nullptr);
+}
+
+int count_cache_files() {
+    int count = 0;
+    if (DIR* dir = opendir(g_cache_dir.c_str())) {
+        while (dirent* entry = readdir(dir)) {
+            if (std::string(entry->d_name).find(".bin") != std::string::npos) ++count;
+        }
+        closedir(dir);
+    }
+    return count;
+}
+
+// 레이어 캐시로 만든 것과 파괴된 앱 캐시의 것이 모두 새 앱 캐시와 다음 디바이스에 들어갑니다.
+void test_merge_and_reload() {
+    constexpr uint64_t kLayerModule = 0x77;
+    constexpr uint64_t kAppModule = 0x88;
+    {
+        TestDevice device;
+        if (!device.create()) {
+            TEST_CHECK(false);
+            return;
+        }
+        TEST_CHECK(!create_pipeline(device, VK_NULL_HANDLE, kLayerModule));
+        TEST_CHECK(create_pipeline(device, VK_NULL_HANDLE, kLayerModule));
+
+        VkPipelineCache app_cache = create_app_cache(device);
+        TEST_CHECK(create_pipeline(device, app_cache, kLayerModule));
+        TEST_CHECK(!create_pipeline(device, app_cache, kAppModule));
+        destroy_app_cache(device, app_cache);
+
+        VkPipelineCache next_app_cache = create_app_cache(device);
+        TEST_CHECK(create_pipeline(device, next_app_cache, kAppModule));
+        destroy_app_cache(device, next_app_cache);
+        device.destroy();
+    }
+    // 쓰기는 writer 스레드가 하지만 vkDestroyDevice 가 끝날 때까지 기다립니다. (mock 은 금방 끝남)
+    TEST_CHECK_EQ(count_cache_files(), 1);
+
+    TestDevice device;
+    if (!device.create()) {
+        TEST_CHECK(false);
+        return;
+    }
+    TEST_CHECK(create_pipeline(device, VK_NULL_HANDLE, kLayerModule));
+    TEST_CHECK(create_pipeline(device, VK_NULL_HANDLE, kAppModule));
+    device.destroy();
+}
+
+}  // namespace
+
+int main() {
+    char dir_template[] = "/tmp/my_layer_pipeline_cache_XXXXXX";
+    if (!mkdtemp(dir_template)) return EXIT_FAILURE;
+    g_cache_dir = dir_template;
+    setenv("DEBUG_MY_LAYER_PIPELINE_CACHE_DIR", g_cache_dir.c_str(), 1);
+    setenv("DEBUG_MY_LAYER_PIPELINE_CACHE_SAVE_INTERVAL_S", "0", 1);
+
+    TEST_RUN(test_merge_and_reload);
+
+    if (DIR* dir = opendir(g_cache_dir.c_str())) {
+        while (dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') unlink((g_cache_dir + "/" + entry->d_name).c_str());
+        }
+        closedir(dir);
+    }
+    rmdir(g_cache_dir.c_str());
+    return test_exit_code();
+}
@@ -0,0 +1,83 @@
+// 설정 변경 감시: 감시 스레드가 설정 파일을 다시 읽고, 새 스냅샷은 프레임 경계 (layer_settings_poll) 에서만
+// 공개됩니다.
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include "settings.h"
+#include "test_util.h"
+
+namespace {
+
+std::string g_config_path;
+
+// 감시 스레드가 쓰다 만 파일을 읽지 않도록 임시 파일에 쓰고 rename 합니다.
+void write_config(const char* contents) {
+    std::string temp_path = g_config_path + ".tmp";
+    FILE* file = fopen(temp_path.c_str(), "w");
+    if (!file) return;
+    fputs(contents, file);
+    fclose(file);
+    rename(temp_path.c_str(), g_config_path.c_str());
+}
+
+// 감시 스레드가 대기 스냅샷을 만들 때까지 기다립니다. (최대 2 초)
+bool wait_for_pending() {
+    for (int i = 0; i < 200; ++i) {
+        if (g_layer_settings_pending.load(std::memory_order_acquire)) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+void test_publish_at_frame_boundary() {
+    const LayerSettings& initial = layer_settings();
+    TEST_CHECK_EQ(initial.pace_fps, 0u);
+    TEST_CHECK_EQ(initial.generation, 0u);
+
+    write_config("settings_watch_ms = 5\npace_fps = 30\nmemory = 2\n");
+    TEST_CHECK(wait_for_pending());
+    // present 전에는 이전 스냅샷 그대로입니다.
+    TEST_CHECK_EQ(layer_settings().pace_fps, 0u);
+
+    layer_settings_poll();
+    TEST_CHECK(g_layer_settings_pending.load() == nullptr);
+    TEST_CHECK_EQ(layer_settings().pace_fps, 30u);
+    TEST_CHECK_EQ(layer_settings().memory, 2u);
+    TEST_CHECK_EQ(layer_settings().generation, 1u);
+    // 이전 스냅샷 참조는 계속 유효합니다.
+    TEST_CHECK_EQ(initial.pace_fps, 0u);
+
+    // 공개 전에 두 번 바뀌면 마지막 것만 공개됩니다.
+    write_config("settings_watch_ms = 5\npace_fps = 45\n");
+    TEST_CHECK(wait_for_pending());
+    write_config("settings_watch_ms = 5\npace_fps = 60\n");
+    for (int i = 0; i < 200 && g_layer_settings_pending.load()->pace_fps != 60; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    layer_settings_poll();
+    TEST_CHECK_EQ(layer_settings().pace_fps, 60u);
+}
+
+}  // namespace
+
+int main() {
+    char path_template[] = "/tmp/my_layer_settings_XXXXXX";
+    int fd = mkstemp(path_template);
+    if (fd < 0) return EXIT_FAILURE;
+    close(fd);
+    g_config_path = path_template;
+    write_config("settings_watch_ms = 5\n");
+    setenv("DEBUG_MY_LAYER_CONFIG_FILE", g_config_path.c_str(), 1);
+    setenv("DEBUG_MY_LAYER_PACKAGE", "*", 1);  // mock loader 없이 설정만 읽습니다.
+
+    TEST_RUN(test_publish_at_frame_boundary);
+
+    unlink(g_config_path.c_str());
+    return test_exit_code();
+}
@@ -0,0 +1,151 @@
+// 셰이더 모듈 중복 제거: 같은 SPIR-V 는 드라이버 모듈 하나를 참조 수로 공유합니다.
+
+#include <cstdlib>
+
+#include "test_util.h"
+
+namespace {
+
+const uint32_t kCode[] = {0x07230203, 0x00010000, 0x00080001, 0x0000000a, 0x00000000};
+const uint32_t kOtherCode[] = {0x07230203, 0x00010000, 0x00080001, 0x0000000b, 0x00000000};
+
+VkShaderModuleCreateInfo module_info(const uint32_t* code, size_t size) {
+    VkShaderModuleCreateInfo create_info = {VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
+    create_info.codeSize = size;
+    create_info.pCode = code;
+    return create_info;
+}
+
+VkShaderModule create_module(const TestDevice& device, const VkShaderModuleCreateInfo& create_info,
+                             const VkAllocationCallbacks* allocator = nullptr) {
+    VkShaderModule module = VK_NULL_HANDLE;
+    VkResult result = device.get<PFN_vkCreateShaderModule>("vkCreateShaderModule")(
+        device.device, &create_info, allocator, &module);
+    TEST_CHECK_EQ(result, VK_SUCCESS);
+    return module;
+}
+
+void destroy_module(const TestDevice& device, VkShaderModule module, const VkAllocationCallbacks* allocator = nullptr) {
+    device.get<PFN_vkDestroyShaderModule>("vkDestroyShaderModule")(device.device, module, allocator);
+}
+
+void* VKAPI_CALL test_allocation(void*, size_t size, size_t, VkSystemAllocationScope) {
+    return malloc(size);
+}
+
+void* VKAPI_CALL test_reallocation(void*, void* original, size_t size, size_t, VkSystemAllocationScope) {
+    return realloc(original, size);
+}
+
+void VKAPI_CALL test_free(void*, void* memory) {
+    free(memory);
+}
+
+// 두 번째 생성은 드라이버를 부르지 않고 같은 핸들을 돌려주고, 마지막 참조의 파괴만 드라이버로 갑니다.
+void test_refcount() {
+    TestDevice device;
+    if (!device.create()) {
+        TEST_CHECK(false);
+        return;
+    }
+    VkShaderModuleCreateInfo create_info = module_info(kCode, sizeof(kCode));
+    VkShaderModule first = VK_NULL_HANDLE;
+    VkShaderModule second = VK_NULL_HANDLE;
+    TEST_CHECK_EQ(icd_calls([&] { first = create_module(device, create_info); }), 1u);
+    TEST_CHECK_EQ(icd_calls([&] { second = create_module(device, create_info); }), 0u);
+    TEST_CHECK(first == second);
+
+    // 내용이 다르면 따로 만듭니다.
+    VkShaderModuleCreateInfo other_info = module_info(kOtherCode, sizeof(kOtherCode));
+    VkShaderModule other = VK_NULL_HANDLE;
+    TEST_CHECK_EQ(icd_calls([&] { other = create_module(device, other_info); }), 1u);
+    TEST_CHECK(other != first);
+
+    TEST_CHECK_EQ(icd_calls([&] { destroy_module(device, first); }), 0u);
+    TEST_CHECK_EQ(icd_calls([&] { destroy_module(device, second); }), 1u);
+    TEST_CHECK_EQ(icd_calls([&] { destroy_module(device, other); }), 1u);
+    TEST_CHECK_EQ(icd_calls([&] { destroy_module(device, VK_NULL_HANDLE); }), 0u);
+
+    // 마지막 참조가 사라진 뒤에는 다시 드라이버로 만듭니다.
+    VkShaderModule again = VK_NULL_HANDLE;
+    TEST_CHECK_EQ(icd_calls([&] { again = create_module(device, create_info); }), 1u);
+    destroy_module(device, again);
+    device.destroy();
+}
+
+// pNext / flags / pAllocator 가 있는 생성은 공유하지 않고 그대로 넘깁니다.
+void test_bypass() {
+    TestDevice device;
+    if (!device.create()) {
+        TEST_CHECK(false);
+        return;
+    }
+    VkShaderModuleCreateInfo create_info = module_info(kCode, sizeof(kCode));
+    VkShaderModule shared = create_module(device, create_info);
+
+    VkAllocationCallbacks allocator = {};
+    allocator.pfnAllocation = test_allocation;
+    allocator.pfnReallocation = test_reallocation;
+    allocator.pfnFree = test_free;
+    VkShaderModule with_allocator = VK_NULL_HANDLE;
+    TEST_CHECK_EQ(icd_calls([&] { with_allocator = create_module(device, create_info, &allocator); }), 1u);
+    TEST_CHECK(with_allocator != shared);
+    TEST_CHECK_EQ(icd_calls([&] { destroy_module(device, with_allocator, &allocator); }), 1u);
+
+    VkShaderModuleValidationCacheCreateInfoEXT validation_info = {
+        VK_STRUCTURE_TYPE_SHADER_MODULE_VALIDATION_CACHE_CREATE_INFO_EXT};
+    VkShaderModuleCreateInfo chained_info = create_info;
+    chained_info.pNext = &validation_info;
+    VkShaderModule chained = VK_NULL_HANDLE;
+    TEST_CHECK_EQ(icd_calls([&] { chained = create_module(device, chained_info); }), 1u);
+    TEST_CHECK(chained != shared);
+    TEST_CHECK_EQ(icd_calls([&] { destroy_module(device, chained); }), 1u);
+
+    TEST_CHECK_EQ(icd_calls([&] { destroy_module(device, shared); }), 1u);
+    device.destroy();
+}
+
+// privateData 가 켜져 있으면 모듈마다 핸들이 달라야 하므로 중복 제거를 하지 않습니다.
+void test_private_data_disables_dedup() {
+    float priority = 1.0f;
+    VkDeviceQueueCreateInfo queue_info = {VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
+    queue_info.queueCount = 1;
+    queue_info.pQueuePriorities = &priority;
+    VkPhysicalDevicePrivateDataFeatures private_data = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRIVATE_DATA_FEATURES};
+    private_data.privateData = VK_TRUE;
+    VkDeviceCreateInfo device_info = {VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
+    device_info.pNext = &private_data;
+    device_info.queueCreateInfoCount = 1;
+    device_info.pQueueCreateInfos = &queue_info;
+
+    TestDevice device;
+    if (!device.create(&device_info)) {
+        TEST_CHECK(false);
+        return;
+    }
+    VkShaderModuleCreateInfo create_info = module_info(kCode, sizeof(kCode));
+    VkShaderModule first = VK_NULL_HANDLE;
+    VkShaderModule second = VK_NULL_HANDLE;
+    TEST_CHECK_EQ(icd_calls([&] {
+        first = create_module(device, create_info);
+        second = create_module(device, create_info);
+    }), 2u);
+    TEST_CHECK(first != second);
+    TEST_CHECK_EQ(icd_calls([&] {
+        destroy_module(device, first);
+        destroy_module(device, second);
+    }), 2u);
+    device.destroy();
+}
+
+}  // namespace
+
+int main() {
+    setenv("DEBUG_MY_LAYER_PIPELINE_CACHE", "0", 1);
+
+    TEST_RUN(test_refcount);
+    TEST_RUN(test_bypass);
+    TEST_RUN(test_private_data_disables_dedup);
+
+    return test_exit_code();
+}
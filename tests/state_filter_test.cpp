@@ -0,0 +1,268 @@
+// 상태 필터 (debug.my_layer.state_filter=1): 어떤 호출을 버리고 어떤 호출을 드라이버에 넘기는지.
+// 넘긴 호출은 mock ICD 의 호출 수로 확인합니다.
+
+#include <cstdlib>
+
+#include "layer_data.h"
+#include "test_util.h"
+
+namespace {
+
+TestDevice g_device;
+
+template <typename T>
+T fake_handle(uint64_t value) {
+    return (T)(uintptr_t)value;
+}
+
+const VkPipeline kPipelineA = fake_handle<VkPipeline>(0x100);
+const VkPipeline kPipelineB = fake_handle<VkPipeline>(0x200);
+const VkPipelineLayout kLayoutA = fake_handle<VkPipelineLayout>(0x300);
+const VkPipelineLayout kLayoutB = fake_handle<VkPipelineLayout>(0x400);
+const VkDescriptorSet kSet0 = fake_handle<VkDescriptorSet>(0x500);
+const VkDescriptorSet kSet1 = fake_handle<VkDescriptorSet>(0x600);
+const VkViewport kViewport = {0.0f, 0.0f, 1920.0f, 1080.0f, 0.0f, 1.0f};
+
+// 레이어를 거치는 기록 명령
+struct Recorder {
+    PFN_vkBeginCommandBuffer begin = g_device.get<PFN_vkBeginCommandBuffer>("vkBeginCommandBuffer");
+    PFN_vkEndCommandBuffer end = g_device.get<PFN_vkEndCommandBuffer>("vkEndCommandBuffer");
+    PFN_vkResetCommandBuffer reset = g_device.get<PFN_vkResetCommandBuffer>("vkResetCommandBuffer");
+    PFN_vkCmdBindPipeline bind_pipeline = g_device.get<PFN_vkCmdBindPipeline>("vkCmdBindPipeline");
+    PFN_vkCmdBindDescriptorSets bind_sets = g_device.get<PFN_vkCmdBindDescriptorSets>("vkCmdBindDescriptorSets");
+    PFN_vkCmdSetViewport set_viewport = g_device.get<PFN_vkCmdSetViewport>("vkCmdSetViewport");
+    PFN_vkCmdSetLineWidth set_line_width = g_device.get<PFN_vkCmdSetLineWidth>("vkCmdSetLineWidth");
+    PFN_vkCmdBeginRenderPass begin_render_pass = g_device.get<PFN_vkCmdBeginRenderPass>("vkCmdBeginRenderPass");
+    PFN_vkCmdNextSubpass next_subpass = g_device.get<PFN_vkCmdNextSubpass>("vkCmdNextSubpass");
+    PFN_vkCmdEndRenderPass end_render_pass = g_device.get<PFN_vkCmdEndRenderPass>("vkCmdEndRenderPass");
+    PFN_vkCmdBeginRendering begin_rendering = g_device.get<PFN_vkCmdBeginRendering>("vkCmdBeginRendering");
+    PFN_vkCmdEndRendering end_rendering = g_device.get<PFN_vkCmdEndRendering>("vkCmdEndRendering");
+    PFN_vkCmdExecuteCommands execute_commands = g_device.get<PFN_vkCmdExecuteCommands>("vkCmdExecuteCommands");
+
+    VkCommandBuffer cb = VK_NULL_HANDLE;
+
+    void begin_recording(VkCommandBuffer command_buffer) {
+        cb = command_buffer;
+        VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+        begin(cb, &begin_info);
+    }
+
+    // 드라이버까지 간 호출 수 (0 = 버림, 1 = 넘김)
+    uint64_t pipeline(VkPipeline pipeline, VkPipelineBindPoint bind_point = VK_PIPELINE_BIND_POINT_GRAPHICS) {
+        return icd_calls([&] { bind_pipeline(cb, bind_point, pipeline); });
+    }
+    uint64_t set(VkPipelineLayout layout, uint32_t index, VkDescriptorSet set, uint32_t offset_count = 0,
+                 const uint32_t* offsets = nullptr) {
+        return icd_calls([&] {
+            bind_sets(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, index, 1, &set, offset_count, offsets);
+        });
+    }
+    uint64_t viewport() {
+        return icd_calls([&] { set_viewport(cb, 0, 1, &kViewport); });
+    }
+    uint64_t line_width(float width) {
+        return icd_calls([&] { set_line_width(cb, width); });
+    }
+};
+
+struct CommandBuffers {
+    VkCommandPool pool = VK_NULL_HANDLE;
+    VkCommandBuffer primary = VK_NULL_HANDLE;
+    VkCommandBuffer secondary = VK_NULL_HANDLE;
+
+    CommandBuffers() {
+        VkCommandPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+        g_device.get<PFN_vkCreateCommandPool>("vkCreateCommandPool")(g_device.device, &pool_info, nullptr, &pool);
+        auto allocate = g_device.get<PFN_vkAllocateCommandBuffers>("vkAllocateCommandBuffers");
+        VkCommandBufferAllocateInfo allocate_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        allocate_info.commandPool = pool;
+        allocate_info.commandBufferCount = 1;
+        allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocate(g_device.device, &allocate_info, &primary);
+        allocate_info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocate(g_device.device, &allocate_info, &secondary);
+    }
+
+    ~CommandBuffers() {
+        g_device.get<PFN_vkDestroyCommandPool>("vkDestroyCommandPool")(g_device.device, pool, nullptr);
+    }
+};
+
+void test_pipeline_changes() {
+    CommandBuffers cbs;
+    Recorder r;
+    r.begin_recording(cbs.primary);
+
+    TEST_CHECK_EQ(r.pipeline(kPipelineA), 1u);
+    TEST_CHECK_EQ(r.pipeline(kPipelineA), 0u);
+    TEST_CHECK_EQ(r.pipeline(kPipelineB), 1u);
+    TEST_CHECK_EQ(r.pipeline(kPipelineA), 1u);
+    // bind point 마다 따로 추적합니다.
+    TEST_CHECK_EQ(r.pipeline(kPipelineA, VK_PIPELINE_BIND_POINT_COMPUTE), 1u);
+    TEST_CHECK_EQ(r.pipeline(kPipelineA, VK_PIPELINE_BIND_POINT_COMPUTE), 0u);
+
+    // 같은 동적 상태는 버리고, 그래픽스 파이프라인이 바뀌면 다시 넘깁니다.
+    TEST_CHECK_EQ(r.viewport(), 1u);
+    TEST_CHECK_EQ(r.viewport(), 0u);
+    TEST_CHECK_EQ(r.line_width(2.0f), 1u);
+    TEST_CHECK_EQ(r.line_width(2.0f), 0u);
+    TEST_CHECK_EQ(r.line_width(1.0f), 1u);
+    TEST_CHECK_EQ(r.pipeline(kPipelineA), 0u);  // 버린 bind 는 동적 상태를 건드리지 않습니다.
+    TEST_CHECK_EQ(r.viewport(), 0u);
+    TEST_CHECK_EQ(r.pipeline(kPipelineB, VK_PIPELINE_BIND_POINT_COMPUTE), 1u);
+    TEST_CHECK_EQ(r.viewport(), 0u);  // compute 파이프라인은 그래픽스 동적 상태와 무관합니다.
+    TEST_CHECK_EQ(r.pipeline(kPipelineB), 1u);
+    TEST_CHECK_EQ(r.viewport(), 1u);
+    TEST_CHECK_EQ(r.line_width(1.0f), 1u);
+
+    r.end(cbs.primary);
+}
+
+void test_render_pass_boundaries() {
+    CommandBuffers cbs;
+    Recorder r;
+    r.begin_recording(cbs.primary);
+    VkRenderPassBeginInfo render_pass_begin = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
+    VkRenderingInfo rendering_info = {VK_STRUCTURE_TYPE_RENDERING_INFO};
+
+    TEST_CHECK_EQ(r.pipeline(kPipelineA), 1u);
+    TEST_CHECK_EQ(r.viewport(), 1u);
+    TEST_CHECK_EQ(r.set(kLayoutA, 0, kSet0), 1u);
+
+    r.begin_render_pass(r.cb, &render_pass_begin, VK_SUBPASS_CONTENTS_INLINE);
+    TEST_CHECK_EQ(r.pipeline(kPipelineA), 1u);
+    TEST_CHECK_EQ(r.viewport(), 1u);
+    TEST_CHECK_EQ(r.set(kLayoutA, 0, kSet0), 1u);
+    TEST_CHECK_EQ(r.pipeline(kPipelineA), 0u);
+
+    r.next_subpass(r.cb, VK_SUBPASS_CONTENTS_INLINE);
+    TEST_CHECK_EQ(r.pipeline(kPipelineA), 1u);
+    TEST_CHECK_EQ(r.viewport(), 1u);
+    TEST_CHECK_EQ(r.viewport(), 0u);
+    r.end_render_pass(r.cb);
+
+    r.begin_rendering(r.cb, &rendering_info);
+    TEST_CHECK_EQ(r.pipeline(kPipelineA), 1u);
+    TEST_CHECK_EQ(r.pipeline(kPipelineA), 0u);
+    r.end_rendering(r.cb);
+
+    r.end(cbs.primary);
+}
+
+void test_secondary_command_buffers() {
+    CommandBuffers cbs;
+    Recorder secondary;
+    secondary.begin_recording(cbs.secondary);
+    // secondary 는 primary 의 상태를 물려받지 않으므로 처음 bind 는 항상 넘깁니다.
+    TEST_CHECK_EQ(secondary.pipeline(kPipelineA), 1u);
+    TEST_CHECK_EQ(secondary.pipeline(kPipelineA), 0u);
+    secondary.end(cbs.secondary);
+
+    Recorder primary;
+    primary.begin_recording(cbs.primary);
+    TEST_CHECK_EQ(primary.pipeline(kPipelineA), 1u);
+    TEST_CHECK_EQ(primary.viewport(), 1u);
+    TEST_CHECK_EQ(icd_calls([&] { primary.execute_commands(cbs.primary, 1, &cbs.secondary); }), 1u);
+    // secondary 실행 후 primary 의 상태는 정의되지 않습니다.
+    TEST_CHECK_EQ(primary.pipeline(kPipelineA), 1u);
+    TEST_CHECK_EQ(primary.viewport(), 1u);
+    primary.end(cbs.primary);
+}
+
+void test_begin_and_reset() {
+    CommandBuffers cbs;
+    Recorder r;
+    r.begin_recording(cbs.primary);
+    TEST_CHECK_EQ(r.pipeline(kPipelineA), 1u);
+    TEST_CHECK_EQ(r.set(kLayoutA, 0, kSet0), 1u);
+    TEST_CHECK_EQ(r.line_width(2.0f), 1u);
+    r.end(cbs.primary);
+
+    // 다시 Begin 하면 (암시적 리셋) 이전 기록의 상태는 남지 않습니다.
+    r.begin_recording(cbs.primary);
+    TEST_CHECK_EQ(r.pipeline(kPipelineA), 1u);
+    TEST_CHECK_EQ(r.set(kLayoutA, 0, kSet0), 1u);
+    TEST_CHECK_EQ(r.line_width(2.0f), 1u);
+    r.end(cbs.primary);
+
+    // 명시적 리셋 후의 Begin 도 같습니다.
+    TEST_CHECK_EQ(icd_calls([&] { r.reset(cbs.primary, 0); }), 1u);
+    r.begin_recording(cbs.primary);
+    TEST_CHECK_EQ(r.pipeline(kPipelineA), 1u);
+    TEST_CHECK_EQ(r.pipeline(kPipelineA), 0u);
+    r.end(cbs.primary);
+}
+
+void test_pipeline_layout_changes() {
+    CommandBuffers cbs;
+    Recorder r;
+    r.begin_recording(cbs.primary);
+
+    TEST_CHECK_EQ(r.set(kLayoutA, 0, kSet0), 1u);
+    TEST_CHECK_EQ(r.set(kLayoutA, 0, kSet0), 0u);
+    // 같은 셋이라도 layout 이 다르면 넘깁니다.
+    TEST_CHECK_EQ(r.set(kLayoutB, 0, kSet0), 1u);
+    TEST_CHECK_EQ(r.set(kLayoutB, 0, kSet0), 0u);
+
+    // 다른 layout 으로 셋 1 을 묶으면 셋 0 은 disturb 된 것으로 봅니다.
+    TEST_CHECK_EQ(r.set(kLayoutB, 1, kSet1), 1u);
+    TEST_CHECK_EQ(r.set(kLayoutB, 0, kSet0), 0u);
+    TEST_CHECK_EQ(r.set(kLayoutA, 1, kSet1), 1u);
+    TEST_CHECK_EQ(r.set(kLayoutB, 0, kSet0), 1u);
+
+    // dynamic offset 도 비교합니다.
+    const uint32_t offsets_a[2] = {0, 256};
+    const uint32_t offsets_b[2] = {0, 512};
+    TEST_CHECK_EQ(r.set(kLayoutA, 2, kSet1, 2, offsets_a), 1u);
+    TEST_CHECK_EQ(r.set(kLayoutA, 2, kSet1, 2, offsets_a), 0u);
+    TEST_CHECK_EQ(r.set(kLayoutA, 2, kSet1, 2, offsets_b), 1u);
+    // 추적할 수 있는 수보다 많으면 항상 넘깁니다.
+    uint32_t many_offsets[StateShadow::kMaxDynamicOffsets + 1] = {};
+    TEST_CHECK_EQ(r.set(kLayoutA, 2, kSet1, StateShadow::kMaxDynamicOffsets + 1, many_offsets), 1u);
+    TEST_CHECK_EQ(r.set(kLayoutA, 2, kSet1, StateShadow::kMaxDynamicOffsets + 1, many_offsets), 1u);
+
+    r.end(cbs.primary);
+}
+
+// 버린 호출 수는 End 에서 디바이스 누적값으로 합산되고, cmd_stats 가 꺼져 있으면 통계는 세지 않습니다.
+void test_totals() {
+    LayerDeviceData* device_data = get_device_data(g_device.device);
+    uint64_t before = device_data->state_filter_totals.load().total();
+
+    CommandBuffers cbs;
+    Recorder r;
+    r.begin_recording(cbs.primary);
+    r.pipeline(kPipelineA);
+    r.pipeline(kPipelineA);
+    r.viewport();
+    r.viewport();
+    r.end(cbs.primary);
+
+    StateFilterStats totals = device_data->state_filter_totals.load();
+    TEST_CHECK_EQ(totals.total() - before, 2u);
+    LayerCommandBufferData* data = g_command_buffer_data_map.find(cbs.primary);
+    TEST_CHECK(data != nullptr);
+    if (data) TEST_CHECK_EQ(data->stats.pipeline_binds, 0u);
+}
+
+}  // namespace
+
+int main() {
+    setenv("DEBUG_MY_LAYER_PIPELINE_CACHE", "0", 1);
+    setenv("DEBUG_MY_LAYER_STATE_FILTER", "1", 1);
+    setenv("DEBUG_MY_LAYER_CMD_STATS", "0", 1);
+    if (!g_device.create()) {
+        fprintf(stderr, "failed to set up the layer on the mock ICD\n");
+        return EXIT_FAILURE;
+    }
+
+    TEST_RUN(test_pipeline_changes);
+    TEST_RUN(test_render_pass_boundaries);
+    TEST_RUN(test_secondary_command_buffers);
+    TEST_RUN(test_begin_and_reset);
+    TEST_RUN(test_pipeline_layout_changes);
+    TEST_RUN(test_totals);
+
+    g_device.destroy();
+    return test_exit_code();
+}
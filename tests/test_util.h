@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+
+#include "mock_icd.h"
+
+// mock ICD 위에 레이어를 올려서 동작을 확인하는 테스트용 도구.
+// 테스트 실행 파일 하나가 프로세스 하나이므로 레이어 설정 (환경 변수) 은 main 에서 레이어를 처음
+// 부르기 전에 정합니다. (settings.h: 설정은 처음 쓸 때 한 번 읽습니다)
+
+inline int g_test_failures = 0;
+
+#define TEST_CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            ++g_test_failures; \
+        } \
+    } while (0)
+
+#define TEST_CHECK_EQ(actual, expected) \
+    do { \
+        auto test_actual_ = (actual); \
+        auto test_expected_ = (expected); \
+        using test_common_t_ = std::common_type_t<decltype(test_actual_), decltype(test_expected_)>; \
+        if (!((test_common_t_)test_actual_ == (test_common_t_)test_expected_)) { \
+            fprintf(stderr, "%s:%d: CHECK failed: %s == %s (%lld vs %lld)\n", __FILE__, __LINE__, #actual, \
+                    #expected, (long long)test_actual_, (long long)test_expected_); \
+            ++g_test_failures; \
+        } \
+    } while (0)
+
+#define TEST_RUN(fn) \
+    do { \
+        int test_failures_before_ = g_test_failures; \
+        fn(); \
+        printf("%s %s\n", g_test_failures == test_failures_before_ ? "[ OK ]" : "[FAIL]", #fn); \
+    } while (0)
+
+inline int test_exit_code() {
+    return g_test_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// 인스턴스 / 디바이스 / 큐 하나를 만들어 두는 테스트 환경.
+struct TestDevice {
+    MockLoader loader;
+    VkInstance instance = VK_NULL_HANDLE;
+    VkPhysicalDevice physical_device = VK_NULL_HANDLE;
+    VkDevice device = VK_NULL_HANDLE;
+    VkQueue queue = VK_NULL_HANDLE;
+
+    bool create(const VkDeviceCreateInfo* create_info = nullptr) {
+        if (!loader.init()) return false;
+        if (loader.create_instance(&instance) != VK_SUCCESS) return false;
+        physical_device = loader.get_physical_device(instance);
+        if (loader.create_device(physical_device, &device, create_info) != VK_SUCCESS) return false;
+        get<PFN_vkGetDeviceQueue>("vkGetDeviceQueue")(device, 0, 0, &queue);
+        return true;
+    }
+
+    void destroy() {
+        loader.destroy_device(device);
+        loader.destroy_instance(instance);
+    }
+
+    // 레이어의 vkGetDeviceProcAddr 로 얻은 (훅 또는 다음 체인의) 함수
+    template <typename PFN>
+    PFN get(const char* name) const {
+        return (PFN)loader.layer_get_device_proc_addr(device, name);
+    }
+};
+
+// fn 을 부르는 동안 mock ICD 가 불린 횟수
+template <typename Fn>
+inline uint64_t icd_calls(Fn&& fn) {
+    uint64_t before = mock_icd_call_count();
+    fn();
+    return mock_icd_call_count() - before;
+}
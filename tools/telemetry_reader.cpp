@@ -0,0 +1,216 @@
+// 레이어가 공유 메모리에 쓰는 텔레메트리 (src/telemetry_format.h) 를 읽는 도구.
+//
+//   telemetry_reader [-a] [-i <seconds>] <telemetry_<패키지>.shm>
+//
+// 기본은 프레임 레코드를 한 줄씩 출력하고 (stream), -a 면 주기마다 링별 fps / 프레임 시간
+// 백분위수와 카운터 증가량만 출력합니다 (aggregate). 파일이 아직 없거나 앱이 다시 시작되면
+// 기다렸다가 다시 붙습니다. 읽기 전용으로 map 하므로 앱에는 영향을 주지 않습니다.
+//
+// Android 에서는 앱의 캐시 디렉터리에 있으므로 앱 권한으로 실행합니다.
+//   adb push telemetry_reader /data/local/tmp/
+//   adb shell run-as <패키지> /data/local/tmp/telemetry_reader -a cache/telemetry_<패키지>.shm
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "telemetry_format.h"
+
+namespace {
+
+uint64_t monotonic_now_ns() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+struct RingState {
+    uint64_t next = 0;       // 다음에 읽을 레코드 index
+    uint64_t lost = 0;       // 리더가 느려서 덮어써졌거나 읽는 도중 바뀐 레코드
+    std::vector<uint64_t> frame_ns;  // aggregate 구간 동안
+    uint64_t stutters = 0;
+};
+
+struct Reader {
+    const TelemetryRegion* region = nullptr;
+    int32_t pid = 0;
+    uint64_t start_ns = 0;
+    RingState rings[kTelemetryMaxRings];
+    uint64_t last_counters[(size_t)TelemetryCounter::Count] = {};
+};
+
+// 파일을 map 하고 헤더를 검사합니다. 아직 준비되지 않았으면 nullptr.
+const TelemetryRegion* attach(const char* path) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return nullptr;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TelemetryRegion)) {
+        close(fd);
+        return nullptr;
+    }
+    void* mapped = mmap(nullptr, sizeof(TelemetryRegion), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return nullptr;
+
+    const TelemetryRegion* region = static_cast<const TelemetryRegion*>(mapped);
+    const TelemetryHeader& header = region->header;
+    if (header.magic.load(std::memory_order_acquire) != kTelemetryMagic ||
+        header.version != kTelemetryVersion || header.total_size != sizeof(TelemetryRegion) ||
+        header.ring_capacity != kTelemetryRingCapacity || header.record_size != sizeof(TelemetryFrameRecord)) {
+        munmap(mapped, sizeof(TelemetryRegion));
+        return nullptr;
+    }
+    return region;
+}
+
+void detach(Reader* reader) {
+    if (reader->region) munmap(const_cast<TelemetryRegion*>(reader->region), sizeof(TelemetryRegion));
+    *reader = Reader();
+}
+
+// 새 레코드를 읽어서 stream 이면 출력하고, aggregate 면 모아 둡니다.
+void poll_rings(Reader* reader, bool aggregate) {
+    for (uint32_t r = 0; r < kTelemetryMaxRings; ++r) {
+        const TelemetryRing& ring = reader->region->rings[r];
+        RingState& state = reader->rings[r];
+        uint64_t head = ring.head.load(std::memory_order_acquire);
+        if (head - state.next > kTelemetryRingCapacity) {
+            state.lost += head - kTelemetryRingCapacity - state.next;
+            state.next = head - kTelemetryRingCapacity;
+        }
+        for (; state.next < head; ++state.next) {
+            TelemetryFrameRecord record;
+            if (!telemetry_read_record(ring, state.next, &record)) {
+                state.lost++;
+                continue;
+            }
+            bool stutter = (record.flags & kTelemetryFrameStutter) != 0;
+            if (aggregate) {
+                state.frame_ns.push_back(record.frame_ns);
+                state.stutters += stutter;
+                continue;
+            }
+            printf("ring %u %.3f s frame %6.2f ms present %5u us submits %3u draws %5u dispatches %4u "
+                   "state changes %5u%s\n",
+                   r, (double)(record.present_ns - reader->start_ns) / 1e9, (double)record.frame_ns / 1e6,
+                   record.present_cpu_us, record.submits, record.draws, record.dispatches, record.state_changes,
+                   stutter ? " STUTTER" : "");
+        }
+    }
+}
+
+uint64_t percentile(const std::vector<uint64_t>& sorted, double q) {
+    if (sorted.empty()) return 0;
+    size_t index = std::min(sorted.size() - 1, (size_t)(q * (double)sorted.size()));
+    return sorted[index];
+}
+
+void print_aggregate(Reader* reader, double elapsed_s) {
+    const TelemetryHeader& header = reader->region->header;
+    uint64_t update_ns = header.update_ns.load(std::memory_order_relaxed);
+    uint64_t now_ns = monotonic_now_ns();
+    printf("--- %s (pid %d)%s\n", header.package, header.pid,
+           update_ns != 0 && now_ns - update_ns > 5000000000ull ? " stalled" : "");
+
+    for (uint32_t r = 0; r < kTelemetryMaxRings; ++r) {
+        RingState& state = reader->rings[r];
+        if (state.frame_ns.empty()) continue;
+        std::sort(state.frame_ns.begin(), state.frame_ns.end());
+        printf("ring %u: %5.1f fps, frame p50 %.2f ms p95 %.2f ms p99 %.2f ms max %.2f ms, %" PRIu64
+               " stutters, %" PRIu64 " lost\n",
+               r, (double)state.frame_ns.size() / elapsed_s,
+               (double)percentile(state.frame_ns, 0.50) / 1e6, (double)percentile(state.frame_ns, 0.95) / 1e6,
+               (double)percentile(state.frame_ns, 0.99) / 1e6, (double)state.frame_ns.back() / 1e6,
+               state.stutters, state.lost);
+        state.frame_ns.clear();
+        state.stutters = 0;
+        state.lost = 0;
+    }
+
+    for (uint32_t i = 0; i < (uint32_t)TelemetryCounter::Count; ++i) {
+        uint64_t value = header.counters[i].load(std::memory_order_relaxed);
+        printf("  %-26s %16" PRIu64 "  (+%" PRIu64 ")\n", telemetry_counter_name(i), value,
+               value - reader->last_counters[i]);
+        reader->last_counters[i] = value;
+    }
+    fflush(stdout);
+}
+
+void usage(const char* argv0) {
+    fprintf(stderr, "usage: %s [-a] [-i <seconds>] <telemetry file>\n", argv0);
+    exit(EXIT_FAILURE);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bool aggregate = false;
+    double interval_s = 1.0;
+    int opt;
+    while ((opt = getopt(argc, argv, "ai:")) != -1) {
+        switch (opt) {
+            case 'a': aggregate = true; break;
+            case 'i': interval_s = atof(optarg); break;
+            default: usage(argv[0]);
+        }
+    }
+    if (optind + 1 != argc || interval_s <= 0) usage(argv[0]);
+    const char* path = argv[optind];
+
+    Reader reader;
+    uint64_t next_report_ns = 0;
+    bool waiting_reported = false;
+    for (;;) {
+        if (!reader.region) {
+            reader.region = attach(path);
+            if (!reader.region) {
+                if (!waiting_reported) fprintf(stderr, "waiting for %s\n", path);
+                waiting_reported = true;
+                std::this_thread::sleep_for(std::chrono::milliseconds(500));
+                continue;
+            }
+            const TelemetryHeader& header = reader.region->header;
+            reader.pid = header.pid;
+            reader.start_ns = header.start_ns.load(std::memory_order_relaxed);
+            // 붙기 전 레코드는 건너뛰고 지금부터 읽습니다.
+            for (uint32_t r = 0; r < kTelemetryMaxRings; ++r) {
+                reader.rings[r].next = reader.region->rings[r].head.load(std::memory_order_acquire);
+            }
+            for (uint32_t i = 0; i < (uint32_t)TelemetryCounter::Count; ++i) {
+                reader.last_counters[i] = header.counters[i].load(std::memory_order_relaxed);
+            }
+            fprintf(stderr, "attached to %s (pid %d)\n", header.package, header.pid);
+            waiting_reported = false;
+            next_report_ns = monotonic_now_ns() + (uint64_t)(interval_s * 1e9);
+        }
+
+        // 앱이 다시 시작되면 같은 파일을 새로 초기화하므로 다시 붙습니다.
+        const TelemetryHeader& header = reader.region->header;
+        if (header.magic.load(std::memory_order_acquire) != kTelemetryMagic || header.pid != reader.pid ||
+            header.start_ns.load(std::memory_order_relaxed) != reader.start_ns) {
+            fprintf(stderr, "process restarted, re-attaching\n");
+            detach(&reader);
+            continue;
+        }
+
+        poll_rings(&reader, aggregate);
+        uint64_t now_ns = monotonic_now_ns();
+        if (aggregate && now_ns >= next_report_ns) {
+            print_aggregate(&reader, interval_s);
+            next_report_ns += (uint64_t)(interval_s * 1e9);
+        }
+        if (!aggregate) fflush(stdout);
+        std::this_thread::sleep_for(std::chrono::milliseconds(aggregate ? 50 : 10));
+    }
+}
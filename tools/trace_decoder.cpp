@@ -0,0 +1,477 @@
+// 레이어의 바이너리 API 트레이스 (src/api_trace_format.h) 를 읽는 오프라인 도구.
+//
+//   trace_decoder [-s | -f | -d | -l | -g] <trace_<패키지>_<pid>.bin>
+//
+//   -s  (기본) 요약: 명령별 호출 수 / 시간, 프레임당 호출 수 / API 시간
+//   -f  프레임별 호출 수, API 시간, 프레임 간격, submit / draw 수
+//   -d  모든 이벤트를 시간 순서로 한 줄씩 (인자 포함)
+//   -l  객체 lifetime: 타입별 생성 / 파괴 / 남은 수, 수명 (프레임), 파괴되지 않은 객체
+//   -g  객체 lifetime 그래프를 Graphviz DOT 로 (부모 -> 자식)
+//       (-l / -g 는 32-bit 캡처를 거부합니다. non-dispatchable 핸들이 값으로 기록되어 있습니다)
+//
+// 캡처 중인 파일도 header.data_end 까지 읽을 수 있습니다. 앱이 도중에 죽어서 마무리되지 않은 파일도
+// 마찬가지입니다.
+//   adb shell run-as <패키지> cat cache/trace_<패키지>_<pid>.bin > trace.bin
+
+#include <algorithm>
+#include <cctype>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "api_trace_reader.h"
+
+namespace {
+
+const char* command_name(const TraceFile& trace, uint32_t command) {
+    return command < trace.commands.size() ? trace.commands[command].c_str() : "?";
+}
+
+std::vector<EventRef> sorted_events(TraceFile* trace) {
+    std::vector<EventRef> events;
+    for_each_event(trace, [&](const EventRef& ref) { events.push_back(ref); });
+    std::stable_sort(events.begin(), events.end(), [](const EventRef& a, const EventRef& b) {
+        return a.event->begin_ns < b.event->begin_ns;
+    });
+    return events;
+}
+
+bool event_failed(const ApiTraceEvent* event) {
+    return event->result_kind == (uint8_t)ApiTraceResultKind::Int && (int64_t)event->result < 0;
+}
+
+void print_header(const TraceFile& trace) {
+    const ApiTraceFileHeader& header = *trace.header;
+    uint32_t flags = header.flags.load(std::memory_order_acquire);
+    printf("package %s (pid %d), %" PRIu64 " KiB, %s, %" PRIu64 " events dropped\n", header.package, header.pid,
+           trace.data_end >> 10, (flags & kApiTraceComplete) ? "complete" : "incomplete",
+           header.dropped_events.load(std::memory_order_relaxed));
+    if (header.last_frame != 0) printf("frames %u-%u\n", header.first_frame, header.last_frame);
+    else if (header.first_frame != 0) printf("frames %u-\n", header.first_frame);
+    if (flags & kApiTraceUntypedHandles) printf("32-bit capture: non-dispatchable handles are shown as values\n");
+}
+
+// 32-bit 캡처에서는 non-dispatchable 핸들을 값과 구분할 수 없어서 lifetime 이 비어 버립니다.
+bool has_typed_handles(const TraceFile& trace) {
+    if (!(trace.header->flags.load(std::memory_order_acquire) & kApiTraceUntypedHandles)) return true;
+    fprintf(stderr, "object lifetimes need a 64-bit capture: this trace was recorded by a 32-bit build, "
+                    "where non-dispatchable handles are recorded as plain values\n");
+    return false;
+}
+
+// --- -s / -f ---
+
+struct CommandStats {
+    uint64_t calls = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t failures = 0;
+};
+
+struct FrameStats {
+    uint64_t calls = 0;
+    uint64_t api_ns = 0;
+    uint64_t submits = 0;
+    uint64_t draws = 0;
+    uint64_t present_ns = 0;  // 이 프레임을 끝낸 present 의 시작 시각
+};
+
+bool starts_with(const std::string& s, const char* prefix) {
+    return s.compare(0, strlen(prefix), prefix) == 0;
+}
+
+void collect_stats(TraceFile* trace, std::vector<CommandStats>* commands, std::map<uint32_t, FrameStats>* frames,
+                   uint64_t* first_ns, uint64_t* last_ns, size_t* threads) {
+    std::unordered_map<uint32_t, uint64_t> thread_events;
+    *first_ns = UINT64_MAX;
+    *last_ns = 0;
+    for_each_event(trace, [&](const EventRef& ref) {
+        const ApiTraceEvent* event = ref.event;
+        if (commands->size() < trace->commands.size()) commands->resize(trace->commands.size());
+        if (event->command >= commands->size()) return;
+
+        CommandStats& stats = (*commands)[event->command];
+        stats.calls++;
+        stats.total_ns += event->duration_ns;
+        stats.max_ns = std::max<uint64_t>(stats.max_ns, event->duration_ns);
+        if (event_failed(event)) stats.failures++;
+
+        FrameStats& frame = (*frames)[event->frame];
+        frame.calls++;
+        frame.api_ns += event->duration_ns;
+        const std::string& name = trace->commands[event->command];
+        if (starts_with(name, "vkQueueSubmit")) frame.submits++;
+        else if (starts_with(name, "vkCmdDraw")) frame.draws++;
+        else if (name == "vkQueuePresentKHR") frame.present_ns = std::max(frame.present_ns, event->begin_ns);
+
+        *first_ns = std::min(*first_ns, event->begin_ns);
+        *last_ns = std::max(*last_ns, event->begin_ns + event->duration_ns);
+        thread_events[ref.thread_id]++;
+    });
+    *threads = thread_events.size();
+}
+
+int print_summary(TraceFile* trace) {
+    std::vector<CommandStats> commands;
+    std::map<uint32_t, FrameStats> frames;
+    uint64_t first_ns, last_ns;
+    size_t threads;
+    collect_stats(trace, &commands, &frames, &first_ns, &last_ns, &threads);
+
+    print_header(*trace);
+    uint64_t total_calls = 0;
+    uint64_t total_ns = 0;
+    for (const CommandStats& stats : commands) {
+        total_calls += stats.calls;
+        total_ns += stats.total_ns;
+    }
+    if (total_calls == 0) {
+        printf("no events\n");
+        return 0;
+    }
+    printf("%" PRIu64 " calls from %zu threads over %.3f s, %.3f s in the API\n", total_calls, threads,
+           (double)(last_ns - first_ns) / 1e9, (double)total_ns / 1e9);
+
+    uint64_t max_calls = 0;
+    uint64_t max_api_ns = 0;
+    for (const auto& [index, frame] : frames) {
+        max_calls = std::max(max_calls, frame.calls);
+        max_api_ns = std::max(max_api_ns, frame.api_ns);
+    }
+    printf("%zu frames, calls/frame mean %.1f max %" PRIu64 ", API time/frame mean %.3f ms max %.3f ms\n",
+           frames.size(), (double)total_calls / (double)frames.size(), max_calls,
+           (double)total_ns / (double)frames.size() / 1e6, (double)max_api_ns / 1e6);
+
+    std::vector<uint32_t> order;
+    for (uint32_t i = 0; i < commands.size(); ++i) {
+        if (commands[i].calls > 0) order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return commands[a].total_ns > commands[b].total_ns;
+    });
+
+    printf("\n%-44s %10s %12s %10s %10s %8s\n", "command", "calls", "total ms", "mean us", "max us", "failed");
+    for (uint32_t index : order) {
+        const CommandStats& stats = commands[index];
+        printf("%-44s %10" PRIu64 " %12.3f %10.2f %10.2f %8" PRIu64 "\n", command_name(*trace, index), stats.calls,
+               (double)stats.total_ns / 1e6, (double)stats.total_ns / (double)stats.calls / 1e3,
+               (double)stats.max_ns / 1e3, stats.failures);
+    }
+    return 0;
+}
+
+int print_frames(TraceFile* trace) {
+    std::vector<CommandStats> commands;
+    std::map<uint32_t, FrameStats> frames;
+    uint64_t first_ns, last_ns;
+    size_t threads;
+    collect_stats(trace, &commands, &frames, &first_ns, &last_ns, &threads);
+
+    print_header(*trace);
+    printf("%8s %10s %10s %12s %8s %8s\n", "frame", "calls", "api ms", "interval ms", "submits", "draws");
+    uint64_t last_present_ns = 0;
+    for (const auto& [index, frame] : frames) {
+        double interval_ms = last_present_ns && frame.present_ns ? (double)(frame.present_ns - last_present_ns) / 1e6
+                                                                 : 0.0;
+        printf("%8u %10" PRIu64 " %10.3f %12.3f %8" PRIu64 " %8" PRIu64 "\n", index, frame.calls,
+               (double)frame.api_ns / 1e6, interval_ms, frame.submits, frame.draws);
+        if (frame.present_ns) last_present_ns = frame.present_ns;
+    }
+    return 0;
+}
+
+// --- -d ---
+
+void print_args(const ApiTraceEvent* event) {
+    for_each_arg(event, [&](uint32_t index, ApiTraceArgKind kind, const uint64_t* arg) {
+        printf(index == 0 ? "" : ", ");
+        switch (kind) {
+            case ApiTraceArgKind::Int: printf("%" PRId64, (int64_t)arg[0]); break;
+            case ApiTraceArgKind::Uint: printf("%" PRIu64, arg[0]); break;
+            case ApiTraceArgKind::Float: {
+                double value;
+                memcpy(&value, arg, sizeof(value));
+                printf("%g", value);
+                break;
+            }
+            case ApiTraceArgKind::Handle: printf("0x%" PRIx64, arg[0]); break;
+            case ApiTraceArgKind::Pointer: printf("ptr 0x%" PRIx64, arg[0]); break;
+            case ApiTraceArgKind::Struct:
+                if (arg[1]) printf("{sType %" PRIu64 ", parent 0x%" PRIx64 "}", arg[0], arg[1]);
+                else printf("{sType %" PRIu64 "}", arg[0]);
+                break;
+            case ApiTraceArgKind::HandleArray:
+            case ApiTraceArgKind::ValueArray:
+            case ApiTraceArgKind::OutHandleArray: {
+                bool hex = kind != ApiTraceArgKind::ValueArray;
+                printf("%s[", kind == ApiTraceArgKind::OutHandleArray ? "out " : "");
+                for (uint64_t i = 0; i < array_elements(arg); ++i) {
+                    printf(hex ? "%s0x%" PRIx64 : "%s%" PRIu64, i ? ", " : "", arg[1 + i]);
+                }
+                if (arg[0] > kApiTraceMaxArrayElements) printf(", ... %" PRIu64 " total", arg[0]);
+                printf("]");
+                break;
+            }
+            case ApiTraceArgKind::OutValue: printf("out %" PRIu64, arg[0]); break;
+            case ApiTraceArgKind::None: printf("?"); break;
+        }
+    });
+}
+
+int print_dump(TraceFile* trace) {
+    std::vector<EventRef> events = sorted_events(trace);
+    print_header(*trace);
+    uint64_t start_ns = trace->header->start_ns;
+    for (const EventRef& ref : events) {
+        const ApiTraceEvent* event = ref.event;
+        printf("%6u %6u %12.6f %8.2fus %s(", event->frame, ref.thread_id, (double)(event->begin_ns - start_ns) / 1e9,
+               (double)event->duration_ns / 1e3, command_name(*trace, event->command));
+        print_args(event);
+        if (event->result_kind == (uint8_t)ApiTraceResultKind::Int) printf(") = %" PRId64 "\n", (int64_t)event->result);
+        else if (event->result_kind == (uint8_t)ApiTraceResultKind::Uint) printf(") = %" PRIu64 "\n", event->result);
+        else printf(")\n");
+    }
+    return 0;
+}
+
+// --- -l / -g ---
+
+struct Object {
+    uint64_t handle;
+    std::string type;
+    uint32_t create_command;
+    uint32_t create_frame;
+    uint32_t destroy_frame = 0;
+    bool destroyed = false;
+    int64_t parent = -1;  // objects 인덱스, 트레이스에서 만들지 않은 부모는 -1
+    uint64_t parent_handle = 0;
+    std::vector<size_t> children;
+};
+
+// "vkAllocateCommandBuffers" -> "CommandBuffer", "vkGetSwapchainImagesKHR" -> "SwapchainImageKHR"
+std::string object_type(const std::string& command) {
+    std::string name = command.substr(2);
+    for (const char* prefix : {"Create", "Allocate", "Get"}) {
+        if (starts_with(name, prefix)) {
+            name = name.substr(strlen(prefix));
+            break;
+        }
+    }
+    size_t suffix = name.size();
+    while (suffix > 0 && isupper((unsigned char)name[suffix - 1])) --suffix;
+    if (suffix == name.size() || suffix == 0) suffix = name.size();
+    std::string vendor = name.substr(suffix);
+    name = name.substr(0, suffix);
+    if (!name.empty() && name.back() == 's') name.pop_back();
+    return name + vendor;
+}
+
+// 부모가 파괴되면 같이 파괴되는 타입
+bool owns_children(const std::string& type) {
+    return type == "CommandPool" || type == "DescriptorPool" || type == "SwapchainKHR";
+}
+
+struct Lifetimes {
+    std::vector<Object> objects;
+    uint32_t last_frame = 0;
+};
+
+void destroy_object(Lifetimes* lifetimes, std::unordered_map<uint64_t, size_t>* live, size_t index, uint32_t frame) {
+    Object& object = lifetimes->objects[index];
+    if (object.destroyed) return;
+    object.destroyed = true;
+    object.destroy_frame = frame;
+    auto it = live->find(object.handle);
+    if (it != live->end() && it->second == index) live->erase(it);
+    if (owns_children(object.type)) {
+        std::vector<size_t> children = object.children;
+        for (size_t child : children) destroy_object(lifetimes, live, child, frame);
+    }
+}
+
+Lifetimes build_lifetimes(TraceFile* trace) {
+    Lifetimes lifetimes;
+    std::unordered_map<uint64_t, size_t> live;  // 핸들 -> objects 인덱스
+    std::vector<EventRef> events = sorted_events(trace);
+
+    for (const EventRef& ref : events) {
+        const ApiTraceEvent* event = ref.event;
+        lifetimes.last_frame = std::max(lifetimes.last_frame, event->frame);
+        if (event_failed(event)) continue;
+        const std::string& name = trace->commands.size() > event->command ? trace->commands[event->command] : "";
+        bool destroys = starts_with(name, "vkDestroy") || starts_with(name, "vkFree");
+        bool resets_pool = name == "vkResetDescriptorPool";
+
+        // 부모: 구조체의 부모 핸들, 없으면 마지막 (null 이 아닌) 핸들 인자
+        uint64_t parent = 0;
+        uint64_t last_handle = 0;
+        const uint64_t* destroyed_arg = nullptr;
+        ApiTraceArgKind destroyed_kind = ApiTraceArgKind::None;
+        for_each_arg(event, [&](uint32_t, ApiTraceArgKind kind, const uint64_t* arg) {
+            if (kind == ApiTraceArgKind::Struct && arg[1] && !parent) parent = arg[1];
+            if (kind == ApiTraceArgKind::Handle || kind == ApiTraceArgKind::HandleArray) {
+                destroyed_arg = arg;
+                destroyed_kind = kind;
+                if (kind == ApiTraceArgKind::Handle && arg[0]) last_handle = arg[0];
+            }
+            if (kind != ApiTraceArgKind::OutHandleArray) return;
+
+            uint64_t parent_handle = parent ? parent : last_handle;
+            for (uint64_t i = 0; i < array_elements(arg); ++i) {
+                uint64_t handle = arg[1 + i];
+                if (handle == 0 || live.count(handle)) continue;
+                Object object;
+                object.handle = handle;
+                object.type = object_type(name);
+                object.create_command = event->command;
+                object.create_frame = event->frame;
+                object.parent_handle = parent_handle;
+                auto parent_it = live.find(parent_handle);
+                if (parent_it != live.end()) {
+                    object.parent = (int64_t)parent_it->second;
+                    lifetimes.objects[parent_it->second].children.push_back(lifetimes.objects.size());
+                }
+                live[handle] = lifetimes.objects.size();
+                lifetimes.objects.push_back(std::move(object));
+            }
+        });
+
+        if (destroys && destroyed_arg) {
+            uint64_t count = destroyed_kind == ApiTraceArgKind::HandleArray ? array_elements(destroyed_arg) : 1;
+            const uint64_t* handles = destroyed_kind == ApiTraceArgKind::HandleArray ? destroyed_arg + 1 : destroyed_arg;
+            for (uint64_t i = 0; i < count; ++i) {
+                auto it = live.find(handles[i]);
+                if (it != live.end()) destroy_object(&lifetimes, &live, it->second, event->frame);
+            }
+        } else if (resets_pool) {
+            // 풀에서 할당한 descriptor set 은 모두 해제됩니다. (command buffer 는 reset 만 되므로 그대로)
+            auto it = live.find(last_handle);
+            if (it != live.end()) {
+                std::vector<size_t> children = lifetimes.objects[it->second].children;
+                for (size_t child : children) destroy_object(&lifetimes, &live, child, event->frame);
+                lifetimes.objects[it->second].children.clear();
+            }
+        }
+    }
+    return lifetimes;
+}
+
+int print_lifetimes(TraceFile* trace) {
+    if (!has_typed_handles(*trace)) return 1;
+    Lifetimes lifetimes = build_lifetimes(trace);
+    print_header(*trace);
+
+    struct TypeStats {
+        uint64_t created = 0;
+        uint64_t destroyed = 0;
+        uint64_t same_frame = 0;  // 만든 프레임에 파괴 (churn)
+        uint64_t lifetime_frames = 0;
+        int64_t live = 0;
+        int64_t peak = 0;
+    };
+    std::map<std::string, TypeStats> types;
+
+    // 프레임 순서로 생성 / 파괴를 다시 훑어서 타입별 최대 동시 개수를 구합니다.
+    std::map<std::string, std::vector<std::pair<uint64_t, int>>> type_changes;
+    for (const Object& object : lifetimes.objects) {
+        TypeStats& stats = types[object.type];
+        stats.created++;
+        type_changes[object.type].push_back({(uint64_t)object.create_frame * 2 + 1, +1});
+        if (object.destroyed) {
+            stats.destroyed++;
+            stats.lifetime_frames += object.destroy_frame - object.create_frame;
+            if (object.destroy_frame == object.create_frame) stats.same_frame++;
+            type_changes[object.type].push_back({(uint64_t)object.destroy_frame * 2, -1});
+        }
+    }
+    for (auto& [type, list] : type_changes) {
+        std::sort(list.begin(), list.end());
+        TypeStats& stats = types[type];
+        for (const auto& change : list) {
+            stats.live += change.second;
+            stats.peak = std::max(stats.peak, stats.live);
+        }
+    }
+
+    printf("%-28s %10s %10s %8s %8s %12s %12s\n", "type", "created", "destroyed", "live", "peak",
+           "mean frames", "same frame");
+    for (const auto& [type, stats] : types) {
+        printf("%-28s %10" PRIu64 " %10" PRIu64 " %8" PRId64 " %8" PRId64 " %12.1f %12" PRIu64 "\n", type.c_str(),
+               stats.created, stats.destroyed, stats.live, stats.peak,
+               stats.destroyed ? (double)stats.lifetime_frames / (double)stats.destroyed : 0.0, stats.same_frame);
+    }
+
+    // vkGet* 로 얻은 객체 (큐, 스왑체인 이미지) 는 앱이 파괴하지 않으므로 빼고 보여 줍니다.
+    printf("\nnot destroyed by the end of the trace:\n");
+    size_t shown = 0;
+    size_t remaining = 0;
+    for (const Object& object : lifetimes.objects) {
+        if (object.destroyed || starts_with(trace->commands[object.create_command], "vkGet")) continue;
+        if (shown++ >= 20) {
+            remaining++;
+            continue;
+        }
+        printf("  %-24s 0x%" PRIx64 " frame %u by %s, parent 0x%" PRIx64 "\n", object.type.c_str(), object.handle,
+               object.create_frame, command_name(*trace, object.create_command), object.parent_handle);
+    }
+    if (remaining) printf("  ... %zu more\n", remaining);
+    return 0;
+}
+
+int print_graph(TraceFile* trace) {
+    if (!has_typed_handles(*trace)) return 1;
+    Lifetimes lifetimes = build_lifetimes(trace);
+    printf("digraph lifetimes {\n  node [shape=box, fontsize=10];\n");
+    for (size_t i = 0; i < lifetimes.objects.size(); ++i) {
+        const Object& object = lifetimes.objects[i];
+        if (object.destroyed) {
+            printf("  o%zu [label=\"%s\\n0x%" PRIx64 "\\nframes %u-%u\"];\n", i, object.type.c_str(), object.handle,
+                   object.create_frame, object.destroy_frame);
+        } else {
+            printf("  o%zu [label=\"%s\\n0x%" PRIx64 "\\nframe %u-\", style=bold];\n", i, object.type.c_str(),
+                   object.handle, object.create_frame);
+        }
+        if (object.parent >= 0) printf("  o%" PRId64 " -> o%zu;\n", object.parent, i);
+    }
+    printf("}\n");
+    return 0;
+}
+
+void usage() {
+    fprintf(stderr, "usage: trace_decoder [-s | -f | -d | -l | -g] <trace file>\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    char mode = 's';
+    const char* path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i][0] == '-' && argv[i][1] && !argv[i][2] && strchr("sfdlg", argv[i][1])) {
+            mode = argv[i][1];
+        } else if (!path && argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    if (!path) {
+        usage();
+        return 1;
+    }
+
+    TraceFile trace;
+    if (!open_trace(path, &trace)) return 1;
+    switch (mode) {
+        case 'f': return print_frames(&trace);
+        case 'd': return print_dump(&trace);
+        case 'l': return print_lifetimes(&trace);
+        case 'g': return print_graph(&trace);
+        default: return print_summary(&trace);
+    }
+}